@@ -10,6 +10,7 @@
 #include <fstream>
 #include <chrono>
 #include <iomanip>
+#include "ScalePack.hpp"   // src/core: binary .pqsp writer shared with the plugin
 
 struct Scale {
     std::string name;
@@ -284,6 +285,18 @@ class ScaleConverter {
         return oss.str();
     }
     
+    // Batch mode: converted masks for one target EDO, appended as scale-pack sources.
+    void appendPackSources(int targetEDO, std::vector<hi::music::scalepack::Source>& out) {
+        int sourceEDO = detectInputEDO();
+        for (const auto& scale : inputScales) {
+            hi::music::scalepack::Source src;
+            src.name = scale.name;
+            src.mask = convertMask(scale.mask, sourceEDO, targetEDO);
+            out.push_back(src);
+        }
+        if (logger) logger->log("Packed " + std::to_string(inputScales.size()) + " scales for " + std::to_string(targetEDO) + "-EDO");
+    }
+    
     void printInputScales() {
         int detectedEDO = detectInputEDO();
         std::cout << "Loaded " << inputScales.size() << " scales from " << detectedEDO << "-EDO:\n";
@@ -297,7 +310,82 @@ class ScaleConverter {
     }
 };
 
+// Parse "13,17,19-22" into EDOs (1-120); false on a malformed or out-of-range token.
+static bool parseEDOList(const std::string& spec, std::vector<int>& edos) {
+    std::istringstream iss(spec);
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+        size_t dash = token.find('-');
+        try {
+            int lo = std::stoi(token.substr(0, dash));
+            int hi = (dash == std::string::npos) ? lo : std::stoi(token.substr(dash + 1));
+            if (lo < 1 || hi > 120 || lo > hi) return false;
+            for (int e = lo; e <= hi; e++) edos.push_back(e);
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return !edos.empty();
+}
+
+// Non-interactive: scale_converter --pack <out.pqsp> <input_file> <edos>
+static int runPackMode(int argc, char* argv[]) {
+    if (argc != 5) {
+        std::cout << "Usage: " << argv[0] << " --pack <out.pqsp> <input_file> <edos, e.g. 12,19,22-31>\n";
+        return 1;
+    }
+    Logger logger(false);
+    logger.log("Pack mode: " + std::string(argv[2]));
+    
+    std::ifstream file(argv[3]);
+    if (!file.is_open()) {
+        std::cout << "Error: Could not open file " << argv[3] << "\n";
+        return 1;
+    }
+    std::string input, line;
+    while (std::getline(file, line)) {
+        input += line + "\n";
+    }
+    
+    std::vector<int> edos;
+    if (!parseEDOList(argv[4], edos)) {
+        std::cout << "Invalid EDO list. Use values 1-120, e.g. 12,19,22-31.\n";
+        return 1;
+    }
+    
+    ScaleConverter converter(&logger);
+    converter.loadScales(input);
+    if (converter.getInputScaleCount() == 0) {
+        std::cout << "No valid scales in " << argv[3] << "\n";
+        return 1;
+    }
+    
+    std::vector<hi::music::scalepack::Source> sources;
+    for (int edo : edos) {
+        converter.appendPackSources(edo, sources);
+    }
+    
+    std::vector<uint8_t> bytes;
+    std::string err;
+    if (!hi::music::scalepack::write(sources, bytes, &err)) {
+        std::cout << "Error: " << err << "\n";
+        return 1;
+    }
+    std::ofstream out(argv[2], std::ios::binary);
+    if (!out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size())) {
+        std::cout << "Error: Could not write " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << sources.size() << " scales (" << edos.size() << " EDOs, "
+              << bytes.size() << " bytes) to " << argv[2] << "\n";
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--pack") {
+        return runPackMode(argc, argv);
+    }
+    
     std::cout << "=== 12-EDO to N-EDO Scale Converter ===\n\n";
     
     // Create logger
@@ -88,25 +88,31 @@
  *
  * **UI/Menu thread**
  * - Context menus for batch operations, snap modes, dual-mode globals, quantization, range/safety,
- *   randomization scope, strum, and status readouts. Panel snapshot export utility.
+ *   randomization scope, strum, and status readouts. Panel snapshot export utility (one module or a batch).
  *
  * # State & Persistence (JSON)
  * - **Poly & output**: `forcedChannels`, `sumToMonoOut`, `avgWhenSumming`, `softClipOut`, `polyFadeSec`.
+ * - **Control rate**: `controlRateDiv` (1/4/16/32 samples), `controlRateSmooth`, `blockLatency` (0/16/64).
+ * - **Chaining**: `chainFromLeft` (take the input from a PolyQuanta on the left via expander messages).
+ * - **Scala**: `scalaScl`, `scalaKbm` (file text; tuningMode 2 re-derives its degree grid from them).
  * - **Range & safety**: `clipVppIndex` (20/15/10/5/2/1 V), `rangeMode` (0=Clip, 1=Scale).
  * - **Globals**: always-on flags for attenuverter/slew/offset; dual-mode banks for Slew/Offset +
  *   current mode selectors.
  * - **Randomization**: `rndAutoEnabled`, `rndSyncMode`, `rndTimeRawFree`, `rndTimeRawSync`,
- *   `randMaxPct`, scope flags for Slews/Offsets/Shapes.
+ *   `randMaxPct`, `rndMorphSec`, scope flags for Slews/Offsets/Shapes, `rngState` (8 hex words, per-instance RNG).
  * - **Per-channel**: `preScale[16]`, `preOffset[16]`, `qzEnabled[16]`, `postOctShift[16]`,
  *   `slewDisabledMask` (bitfield), per-channel `snapOffsetMode`.
  * - **Quantizer**: `quantizerPos` (Pre/Post), `quantStrength` (0..1).
  * - **Tuning** via CoreState: `edo`, `tuningMode`, `tetSteps`, `tetPeriodOct`, `rootNote`,
  *   `scaleIndex`, masks for 12/24/generic.
+ * - **Compact schema** (opt-in menu toggle): `schema` = 2 packs per-channel flags into `*Bits`
+ *   integers, writes masks as base64 `customMaskBits` and leaves default values out; legacy keys still load,
+ *   but builds without schema 2 fall back to defaults for the packed fields.
  * - **Migrations**: legacy QZ* preserved; classic “Quantize→Slew” patches map to **Pre**.
  *
  * # UI & Menus (highlights)
  * - **Output**: channel count (Auto or 1–16), poly fade time presets, sum-to-mono (+avg),
- *   soft-clip toggle, Vpp selection, range mode (Clip/Scale), panel export.
+ *   soft-clip toggle, Vpp selection, range mode (Clip/Scale), control rate, panel export.
  * - **Quantization**: PRE vs POST, strength %, rounding & stickiness, EDO/TET selection,
  *   custom masks (12/24/generic), per-channel octave shifts, status line.
  * - **Randomize Scope**: Slews / Offsets / Shapes.
@@ -124,21 +130,13 @@
  * - New scales/tunings: extend CoreState + mask editors; preserve bit widths (12/24) and generic vector.
  * - Larger features: consider extracting helper structs adjacent to CoreState; keep audio path alloc-free.
  *
- * # Implementation Index (jump points; current file)
- * - ParamIds enum .............................................. line ~332
- * - InputId / OutputId / LightId enums .......................... lines ~371 / ~378 / ~385
- * - Module class (`struct PolyQuanta`) .......................... line ~330
- * - Constructor ................................................. line ~886
- * - process(const ProcessArgs&) .................................. line ~1925
- * - onReset() ................................................... line ~1752
- * - dataToJson() / dataFromJson() ............................... lines ~1332 / ~1509
- * - CoreState glue (fill/apply) ................................. lines ~2926 / ~2972
- * - Widget (`struct PolyQuantaWidget`) .......................... line ~3292
- * - Widget::appendContextMenu() (main module menu) .............. line ~3851
- * - UI construction (addParam/addInput/…) ....................... line ~3662 onward
- * - Quantization menu section ................................... ~3966–4051
- * - Output range & safety options ............................... ~3854–3965
- * - Strum menu .................................................. ~4816–4861
+ * # Implementation Index (search anchors; line numbers drift)
+ * - Module class (`struct PolyQuanta`), ParamId / InputId / OutputId / LightId enums
+ * - Constructor (`PolyQuanta()`), `onReset()`, `process(const ProcessArgs&)` (Rack I/O wrapper)
+ * - Signal chain: `PolyQuantaEngine::render()` in core/PolyQuantaEngine.cpp
+ * - `dataToJson()` / `dataFromJson()`; CoreState glue `fillCoreStateFromModule` / `applyCoreStateToModule`
+ * - Widget (`struct PolyQuantaWidget`) and its constructor (addParam/addInput/…)
+ * - `PolyQuantaWidget::appendContextMenu()`: "Range (Vpp)", "Quantization" section, "Strum" submenu
  */
 
 // -----------------------------------------------------------------------------
@@ -150,7 +148,9 @@
 #include <cstdio>        // For C-style I/O functions like snprintf
 #include <cctype>        // For character classification functions like isdigit, tolower
 #include <limits>        // For numeric limits (std::numeric_limits)
-#include <fstream>       // For file stream operations (not used in current code)
+#include <fstream>       // For file stream operations (diagnostics dump, Scala files)
+#include <sstream>       // For reading whole Scala files
+#include <osdialog.h>    // For the Scala file dialogs
 #include <unordered_set> // For hash-based set containers
 #include <set>           // For ordered set containers
 #include <map>           // For associative containers (key-value pairs)
@@ -159,6 +159,7 @@
 #include <string>        // For string manipulation
 #include <algorithm>     // For algorithms like min_element, sort, unique
 #include <cstdint>       // For fixed-width integer types like uint32_t
+#include <cstdlib>       // For strtoull (RNG state restore)
 
 // -----------------------------------------------------------------------------
 // Inline helpers
@@ -196,25 +197,6 @@ namespace hi { namespace music { namespace scale {
     bool masksEqual(const std::vector<uint8_t>& mask1, const std::vector<uint8_t>& mask2);
 } } }
 
-// LED control utilities for bipolar (green/red) channel activity indicators
-namespace hi { namespace ui { namespace led {
-// Set brightness of bipolar LED pair based on positive/negative voltage
-// Positive voltages light the green LED, negative voltages light the red LED
-// g: reference to green LED light object
-// r: reference to red LED light object  
-// val: input voltage value (positive = green, negative = red)
-// dt: delta time for smooth brightness transitions
-static inline void setBipolar(rack::engine::Light& g, rack::engine::Light& r, float val, float dt) {
-    // Scale positive voltage to green LED brightness (0.0 to 1.0)
-    float gs = rack::clamp( val / hi::consts::LED_SCALE_V, 0.f, 1.f);
-    // Scale negative voltage to red LED brightness (0.0 to 1.0)
-    float rs = rack::clamp(-val / hi::consts::LED_SCALE_V, 0.f, 1.f);
-    // Apply smooth brightness changes to avoid LED flickering
-    g.setBrightnessSmooth(gs, dt); 
-    r.setBrightnessSmooth(rs, dt);
-}
-}}} // namespace hi::ui::led
-
 // Dual-mode control utilities for knobs that can switch between two different functions
 namespace hi { namespace ui { namespace dual {
 // Template structure for storing two values and a mode flag
@@ -251,11 +233,12 @@ struct AttenuverterMap {
 
 // Random number utilities for parameter randomization
 namespace hi { namespace util { namespace rnd {
-// Generate a random delta value within a symmetric range
+// Map a uniform draw to a symmetric delta
+// u: uniform value in [0, 1) (batch-drawn from the module's hi::dsp::rng::Xoroshiro)
 // width: maximum absolute deviation from zero
-// Returns: random value in range [-width, +width]
-static inline float delta(float width) { 
-    return (2.f * rack::random::uniform() - 1.f) * width; 
+// Returns: value in range [-width, +width)
+static inline float delta(float u, float width) { 
+    return (2.f * u - 1.f) * width; 
 }
 
 // Apply random change to a value within specified bounds
@@ -263,10 +246,11 @@ static inline float delta(float width) {
 // lo: minimum allowed value after randomization
 // hi: maximum allowed value after randomization  
 // maxPct: maximum change as percentage of total range (0.0 to 1.0)
-static inline void randSpanClamp(float& v, float lo, float hi, float maxPct) { 
+// u: uniform draw in [0, 1) that picks the change
+static inline void randSpanClamp(float& v, float lo, float hi, float maxPct, float u) { 
     float span = hi - lo;  // Calculate total parameter range
     if (span <= 0.f) return;  // Skip if invalid range
-    float dv = delta(maxPct * span);  // Generate random change
+    float dv = delta(u, maxPct * span);  // Map draw to a bounded change
     v = rack::clamp(v + dv, lo, hi);  // Apply change and clamp to bounds
 }
 }}} // namespace hi::util::rnd
@@ -295,26 +279,6 @@ static inline bool readBool(::json_t* root, const char* key, bool def) {
 }
 }}} // namespace hi::util::jsonh
 
-// Polyphony transition utilities for smooth channel count changes
-namespace hi { namespace dsp { namespace polytrans {
-// Enumeration for polyphony transition phases
-enum Phase { 
-    TRANS_STABLE = 0,   // Normal operation, no transition in progress
-    TRANS_FADE_OUT,     // Fading out before changing channel count
-    TRANS_FADE_IN       // Fading in after changing channel count
-};
-
-// State structure for managing polyphony transitions
-struct State { 
-    int curProcN = 0;           // Current number of processing channels
-    int curOutN = 0;            // Current number of output channels
-    int pendingProcN = 0;       // Target number of processing channels
-    int pendingOutN = 0;        // Target number of output channels
-    float polyRamp = 1.f;       // Fade multiplier (0.0 = silent, 1.0 = full volume)
-    Phase transPhase = TRANS_STABLE;  // Current transition phase
-    bool initToTargetsOnSwitch = false;  // Flag to reinitialize on channel switch
-};
-}}} // namespace hi::dsp::polytrans
 // Import VCV Rack namespaces for convenience
 using namespace rack;                    // Core VCV Rack types and functions
 using namespace rack::componentlibrary;  // Standard UI components (knobs, ports, etc.)
@@ -425,7 +389,6 @@ for all DSP processing, user interface, and persistence operations.
 └──────────────────────────────────────────────────────────────────────────────┘
 
 ┌─ UTILITY METHODS & HELPERS ──────────────────────────────────────────────────┐
-│ • quantizeToScale(): Musical voltage quantizer with full configuration       │
 │ • currentClipLimit(): Voltage range mapper for consistent limiting           │
 │ • MOS detection cache: performance optimization for UI menu generation       │
 │ • Hash fingerprinting: efficient scale configuration change detection        │
@@ -445,7 +408,7 @@ maintaining real-time performance for up to 16 simultaneous channels.
 */
 
 // Main module class - 16-channel polyphonic slew/glide processor with quantization
-struct PolyQuanta : Module {
+struct PolyQuanta : Module, hi::dsp::PolyQuantaEngine {
     // Parameter enumeration - defines all knobs, buttons, and controls
     enum ParamId {
         // Per-channel slew (SL) and offset (OFF) parameters for 16 channels
@@ -508,46 +471,40 @@ struct PolyQuanta : Module {
     // ═══════════════════════════════════════════════════════════════════════════
     // DSP STATE VARIABLES - Runtime processing state for audio computation
     // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Per-channel slew limiting units for smooth voltage transitions
-    dsp::SlewLimiter slews[16];
-    
-    // Per-channel step tracking for shape-aware slew processing
-    float stepNorm[16] = {10.f};  // Current step magnitude in volts (defaults to 10V)
-    int   stepSign[16] = {0};     // Direction of current voltage change (+1=rising, -1=falling, 0=stable)
+    // Signal-chain settings, tuning and per-voice state live in hi::dsp::PolyQuantaEngine
+    // (base class); members below are the Rack-side controls, randomizer and UI caches.
     
     // Trigger detection for randomization controls
     dsp::BooleanTrigger rndBtnTrig;  // Detects front-panel randomize button presses
     dsp::SchmittTrigger rndGateTrig; // Detects external randomization trigger/clock signals
 
-    // Performance optimization: cache slew rates to avoid redundant calculations
-    float prevRiseRate[16] = {0};  // Previously calculated rise slew rates
-    float prevFallRate[16] = {0};  // Previously calculated fall slew rates
-    float lastOut[16]      = {0};  // Last output voltage per channel for continuity
-
     // ═══════════════════════════════════════════════════════════════════════════
     // MODULE CONFIGURATION OPTIONS - User-configurable behavior settings
     // ═══════════════════════════════════════════════════════════════════════════
     
-    // Polyphony control settings
-    int forcedChannels = 0;        // Channel count: 0=Auto (match input), 1-16=force specific count
-    bool sumToMonoOut = false;     // Output mode: false=polyphonic, true=sum all channels to mono
-    bool avgWhenSumming = false;   // Summing behavior: false=add voltages, true=average voltages
-    
-    // DSP processing options
-    bool pitchSafeGlide = false;   // Slew scaling: false=voltage-based, true=semitone-based (1V/oct)
-    bool softClipOut = false;      // Clipping type: false=hard clamp, true=soft saturation curve
     // Output voltage range selection (affects both range mode and safety clipping)
     // Index maps to: 0=±10V, 1=±7.5V, 2=±5V, 3=±2.5V, 4=±1V, 5=±0.5V
     int clipVppIndex = 0;
     
-    // Range enforcement mode for pre-quantization signal conditioning
-    int rangeMode = 0;             // 0=Clip (hard limit), 1=Scale (compress to fit)
-    
-    // Per-channel offset parameter quantization modes
-    int snapOffsetModeCh[16] = {0}; // Per-channel: 0=Voltage, 1=Semitones, 2=Cents
+    // Offset parameter quantization (per-channel modes: PolyQuantaEngine::snapOffsetModeCh)
     int snapOffsetMode = 0;         // Global batch setting applied to all channels
 
+    // Block latency (see hi::dsp::blockio): render through processBlock() in 16/64-frame blocks
+    int blockLatency = 0;           // Requested FIFO size in samples (0 = render every sample)
+    hi::dsp::blockio::Fifo fifo;    // Audio-thread FIFO (resized in process() when blockLatency changes)
+
+    // UI telemetry (see hi::dsp::telemetry): cents readouts and channel lights at ~60 Hz
+    hi::dsp::telemetry::Channel telemetry;
+    int telemetryCountdown = 0;     // Samples until the next publish
+
+    // Expander chaining (see hi::dsp::chain): a left PolyQuanta writes into leftExpander's buffers
+    bool chainFromLeft = false;     // Input comes from the left neighbour's output instead of the IN jack
+    hi::dsp::chain::Frame chainBuf[2];  // leftExpander producer/consumer messages
+    int32_t chainSentStep[16] = {0};    // Steps last sent to the right neighbour (stepChanged flags)
+
+    // Patch schema (see hi::util::patch): packed per-channel keys, base64 masks, defaults left out
+    bool compactPatch = false;
+
     // ═══════════════════════════════════════════════════════════════════════════
     // DUAL-MODE GLOBAL CONTROLS - Advanced knob behavior with mode switching
     // ═══════════════════════════════════════════════════════════════════════════
@@ -562,90 +519,12 @@ struct PolyQuanta : Module {
     bool globalOffsetAlwaysOn = true;     // Apply global offset even in range offset mode
     bool rangeOffsetAlwaysOn = true;      // Apply range centering even in global offset mode
 
-    // ═══════════════════════════════════════════════════════════════════════════
-    // STRUM TIMING SYSTEM - Sequential channel triggering for musical effects
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    bool strumEnabled = false;     // Master enable for strum timing (default: disabled)
-    int strumMode = 0;             // Pattern: 0=Up (1→16), 1=Down (16→1), 2=Random order
-    //   0 = Time-stretch (adds per-channel delay to effective glide time)
-    //   1 = Start-delay (holds start by per-channel delay, glide duration unchanged)
-    int strumType = 1;             // Timing behavior: 0=Time-stretch, 1=Start-delay (default)
-    float strumMs = 0.f;           // Inter-channel delay in milliseconds (0=simultaneous)
-    
-    // ═══════════════════════════════════════════════════════════════════════════
-    // STRUM DELAY STATE - Runtime tracking for per-channel timing offsets
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Per-channel strum delay state (runtime only, not saved to patches)
-    float strumDelayAssigned[16] = {0};  // Initial delay assigned to each channel (ms)
-    float strumDelayLeft[16] = {0};      // Remaining delay countdown for each channel (ms)
-    float strumPrevTarget[16] = {0.f};   // Last processed target per channel for strum change detection
-    bool  strumPrevInit[16] = {false};   // Tracks whether strumPrevTarget has been primed
-    static constexpr float STRUM_TARGET_TOL = 1e-4f; // Strum target change hysteresis (volts)
-
     // ═══════════════════════════════════════════════════════════════════════════
     // MODE TRACKING AND MIGRATION FLAGS - State change detection and compatibility
     // ═══════════════════════════════════════════════════════════════════════════
     
-    bool prevPitchSafeGlide = false;     // Track pitch-safe glide mode changes for step recalc
     bool migratedQZ = false;             // One-time migration flag from old button params
 
-    // ═══════════════════════════════════════════════════════════════════════════
-    // QUANTIZER CONFIGURATION - Musical quantization behavior and signal chain order
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Quantizer position in the signal chain determines processing order
-    enum QuantizerPos { Pre = 0, Post = 1 };
-    int quantizerPos = QuantizerPos::Post;   // Default: Slew→Quantize (pitch-accurate)
-    // Signal-chain options:
-    // - Pre (legacy): Quantize→Slew - allows pitch bending but may detune during long glides
-    // - Post (default): Slew→Quantize - maintains pitch accuracy throughout glide transitions
-
-    // Quantization strength: blend between raw input and quantized output
-    float quantStrength = 1.f;              // Range: 0.0 (bypass) to 1.0 (full quantization)
-    
-    // Quantization rounding behavior when input falls between scale degrees
-    int quantRoundMode = 0;                  // Default: Directional Snap for musical expression
-    // Rounding modes:
-    // 0 = Directional Snap: ceil when rising, floor when falling (follows musical gesture)
-    // 1 = Nearest: standard closest-note rounding (traditional quantizer behavior)
-    // 2 = Up: always ceil to next higher note (chromatic runs upward)
-    // 3 = Down: always floor to next lower note (chromatic runs downward)
-    
-    // Hysteresis (stickiness) prevents rapid switching between adjacent notes during slow slides
-    float stickinessCents = 5.f;            // User range: 0-20 cents (auto-clamped to 40% of step size)
-
-    // ═══════════════════════════════════════════════════════════════════════════
-    // TUNING SYSTEM CONFIGURATION - EDO/TET settings and scale definitions
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Tuning system type selector
-    int tuningMode = 0;                      // 0 = EDO (octave-based), 1 = TET (non-octave)
-    
-    // EDO (Equal Division of Octave) - traditional Western and microtonal systems
-    int edo = 12;                            // Default: 12-EDO (standard Western tuning)
-                                            // Menu offers curated presets from 5-EDO to 120-EDO
-    
-    // TET (Equal Temperament) - non-octave repeating systems like Carlos temperaments
-    int   tetSteps = 9;                      // Default: Carlos Alpha (9 divisions of perfect fifth)
-    float tetPeriodOct = std::log2(3.f/2.f); // Period size in octaves (log2 of frequency ratio)
-                                            // Perfect fifth ≈ 0.5849625 octaves
-    
-    // ═══════════════════════════════════════════════════════════════════════════
-    // SCALE SYSTEM - Custom and predefined musical scales
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Scale source selection (always use custom scales with unified selection)
-    bool useCustomScale = true;              // Always true - unified scale selection system
-    
-    // Scale mask preservation is now always enabled by default
-    
-
-
-    // Custom scale storage - unified vector-based system for all EDOs
-    std::vector<uint8_t> customMaskGeneric; // Dynamic array: 0/1 flag per scale degree
-
     // ═══════════════════════════════════════════════════════════════════════════
     // MOS DETECTION CACHE - Moment of Symmetry analysis for UI display optimization
     // ═══════════════════════════════════════════════════════════════════════════
@@ -662,31 +541,101 @@ struct PolyQuanta : Module {
         int      tetSteps    = 0;            // TET steps when cached
         int      rootNote    = 0;            // Root note when cached
         bool     useCustom   = false;        // Custom scale usage when cached
-        uint64_t maskHash    = 0;            // Hash fingerprint of scale mask configuration
+        uint64_t maskHash    = 0;            // Zobrist hash of `mask` when cached
+        hi::music::mos::MaskState mask;      // Packed mirror of customMaskGeneric (O(1) per toggled degree)
+        bool     maskSynced  = false;        // `mask` matches customMaskGeneric (cleared by bulk edits)
     } mosCache;
 
-    // Invalidate MOS cache when scale configuration changes
-    void invalidateMOSCache() { mosCache.valid = false; }
-    
-    // Generate stable hash fingerprint for current scale mask configuration
-    // Used to detect when cache needs refreshing due to scale changes
-    uint64_t hashMask(int N) const {
-        uint64_t h = 1469598103934665603ull;  // FNV-1a hash basis constant
-        auto fnv1a = [&h](uint64_t v){ h ^= v; h *= 1099511628211ull; };  // FNV-1a hash function
-        fnv1a((uint64_t)N);                   // Include division count
-        fnv1a((uint64_t)useCustomScale);      // Include custom scale flag
-        fnv1a((uint64_t)rootNote);            // Include current root note
-        // Hash the appropriate mask based on EDO size
-        if (!useCustomScale) {
-            fnv1a(0xFFFFFFFFull);           // Standard marker for non-custom scales
-            return h;
+    // Invalidate MOS cache when scale configuration changes (bulk mask edits also drop the mirror)
+    void invalidateMOSCache() { mosCache.valid = false; mosCache.maskSynced = false; }
+
+    // Root/degree menu labels, rebuilt only when the tuning or root changes (UI thread only)
+    hi::ui::labels::Cache menuLabels;
+
+    // Background analysis (see hi::music::analysis): MOS, matching preset and best generator
+    // for the current tuning, computed off the UI thread and read back lock-free.
+    std::shared_ptr<hi::music::analysis::Client> analysis = hi::music::analysis::shared().connect();
+    hi::music::analysis::Query analysisQuery() const {
+        hi::music::analysis::Query q;
+        q.N = (tuningMode == 0 ? edo : tetSteps);
+        q.useCustom = useCustomScale;
+        q.mask = customMaskGeneric;
+        return q;
+    }
+    // Queue the current tuning; coalesced with any still pending request of this instance.
+    void requestAnalysis() { hi::music::analysis::shared().submit(analysis, analysisQuery()); }
+    // Latest result, if it answers the current tuning (false while the worker catches up).
+    bool analysisResult(hi::music::analysis::Result& r) const {
+        return analysis->result.read(r) && r.key == hi::music::analysis::key(analysisQuery());
+    }
+    // Preset the custom mask matches: the worker's answer when current, else a direct lookup.
+    const hi::music::Scale* matchingScale() const {
+        const int N = (tuningMode == 0 ? edo : tetSteps);
+        hi::music::analysis::Result r;
+        if (analysisResult(r)) return r.scaleIndex >= 0 ? &hi::music::scalesEDO(N)[r.scaleIndex] : nullptr;
+        return hi::music::scale::detectMatchingScale(customMaskGeneric, N);
+    }
+
+    // Scala tuning (see hi::music::scala): file text as loaded, so patches carry the scale
+    std::string scalaScl, scalaKbm;
+    std::string scalaName;          // .scl description line (menu label)
+    std::string scalaError;         // Last load failure, shown in the Tuning system menu
+
+    // Parse scl (+ optional kbm) into scalaDegrees/scalaTonic. Leaves everything untouched and
+    // sets scalaError on failure. select: also switch to tuningMode 2 with the scale's N and
+    // period in the TET fields (so N/period readers elsewhere need no Scala case), a mask of
+    // the keymap's mapped degrees and the root kept only if it still exists.
+    bool loadScala(const std::string& scl, const std::string& kbm, bool select) {
+        namespace sc = hi::music::scala;
+        sc::Scale s; sc::Keymap k; sc::Tuning t;
+        std::string err;
+        if (!sc::parseScl(scl, s, &err) || (!kbm.empty() && !sc::parseKbm(kbm, k, &err))) {
+            scalaError = err; return false;
         }
-        // Hash custom mask for all EDO sizes using unified vector system
-        size_t len = customMaskGeneric.size();
-        for(size_t i=0;i<std::min<size_t>(len,(size_t)N);++i) 
-            fnv1a((uint64_t)(customMaskGeneric[i]&1));  // Hash each bit
-        fnv1a((uint64_t)len);               // Include mask length
-        return h;
+        if (!sc::toTuning(s, kbm.empty() ? nullptr : &k, t)) {
+            scalaError = "scale has no usable period, too many degrees or duplicate degrees under a keymap"; return false;
+        }
+        scalaScl = scl; scalaKbm = kbm; scalaName = s.description; scalaError.clear();
+        scalaDegrees = t.degrees; scalaTonic = t.tonic;
+        if (select) {
+            const int N = (int)t.degrees.size();
+            tuningMode = 2; tetSteps = N; tetPeriodOct = t.period;
+            customMaskGeneric = t.mapped; useCustomScale = true;
+            if (rootNote >= N) rootNote = 0;
+            invalidateMOSCache();
+        }
+        return true;
+    }
+
+    // File dialog → text ("" when cancelled or unreadable)
+    static std::string pickScalaFile(const char* filters) {
+        osdialog_filters* f = osdialog_filters_parse(filters);
+        char* path = osdialog_file(OSDIALOG_OPEN, nullptr, nullptr, f);
+        osdialog_filters_free(f);
+        if (!path) return "";
+        std::ifstream in(path, std::ios::binary);
+        std::free(path);
+        std::ostringstream ss; ss << in.rdbuf();
+        return ss.str();
+    }
+
+    // Toggle one root-relative degree of the custom mask (per-degree menu items). The MOS mirror
+    // follows in O(1), so the next detection only re-checks the two steps around the degree.
+    void toggleMaskDegree(int N, int deg) {
+        if ((int)customMaskGeneric.size() != N) { customMaskGeneric.assign((size_t)N, 0); invalidateMOSCache(); }
+        if (deg < 0 || deg >= N) return;
+        customMaskGeneric[(size_t)deg] = 1 - customMaskGeneric[(size_t)deg];
+        useCustomScale = true;
+        if (mosCache.maskSynced && mosCache.mask.N == N) mosCache.mask.toggle(deg);
+        else invalidateMOSCache();
+    }
+
+    // Packed mask mirror for N, rebuilt only after a bulk edit or a division change
+    const hi::music::mos::MaskState& syncedMask(int N) {
+        if (!mosCache.maskSynced || mosCache.mask.N != N) {
+            mosCache.maskSynced = mosCache.mask.assign(customMaskGeneric.data(), (int)customMaskGeneric.size(), N);
+        }
+        return mosCache.mask;
     }
 
     // ═══════════════════════════════════════════════════════════════════════════
@@ -700,6 +649,10 @@ struct PolyQuanta : Module {
     
     // Randomization magnitude control
     float randMaxPct = 1.f;                  // Maximum delta as fraction of full range (0.1-1.0)
+    // Randomization morph (see hi::dsp::morph): glide to the drawn values instead of jumping
+    float rndMorphSec = 0.f;                 // Morph time in seconds (0 = jump, legacy)
+    float rndSampleRate = 48000.f;           // Engine rate for morph lengths (updated in process())
+    hi::dsp::morph::Bank rndMorph;           // Slots: 0-15 slews, 16-31 offsets, 32 rise, 33 fall
     
     // Auto-randomization timing system
     bool rndAutoEnabled = false;             // Master enable for automatic randomization
@@ -755,143 +708,153 @@ struct PolyQuanta : Module {
 	static const int OFF_PARAM[16];          // Offset voltage parameter indices
     static const int QZ_PARAM[16];           // Legacy quantize button parameter indices
 
-    // ═══════════════════════════════════════════════════════════════════════════
-    // QUANTIZATION STATE - Per-channel quantizer behavior and history
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Per-channel quantization enable flags (replaces legacy front-panel buttons)
-    bool qzEnabled[16] = {false};            // Enable quantization for each channel
-    
-    // Quantizer state tracking for smooth operation
-    float prevYRel[16] = {0.f};              // Previous relative voltage for directional snap
-    
-    // Latched quantizer state for hysteresis and directional snap
-    double lastFs[16] = {0.0};               // Last fractional step position (high precision)
-    int    lastDir[16] = {0};                // Last movement direction: -1=down, 0=hold, +1=up
-    int  latchedStep[16];                    // Current latched step index (0..N-1)
-    bool latchedInit[16];                    // Initialization flag for each channel
-
-    // ═══════════════════════════════════════════════════════════════════════════
-    // PER-CHANNEL PRE-RANGE TRANSFORMS - Individual channel scaling and offset
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Applied BEFORE global Range Clip/Scale processing
-    // Formula: output = (input * preScale[ch]) + preOffset[ch]
-    // Allows per-voice window adjustment without requiring additional panel controls
-    float preScale[16]  = {0};               // Scaling factor: -10.0 to +10.0 (default: 1.0)
-    float preOffset[16] = {0};               // Offset voltage: -10.0V to +10.0V (default: 0.0V)
-
-    // ═══════════════════════════════════════════════════════════════════════════
-    // QUANTIZER CONFIGURATION CHANGE TRACKING - Invalidation detection
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Previous quantizer configuration state for change detection
-    // When any of these values change, all channel latches are reset
-    int prevRootNote = -999;                 // Previous root note setting
-    int prevScaleIndex = -999;               // Previous scale selection index
-    int prevEdo = -999;                      // Previous EDO division count
-    int prevTetSteps = -999;                 // Previous TET step count
-    float prevTetPeriodOct = -999.f;         // Previous TET period size
-    int prevTuningMode = -999;               // Previous tuning system mode
-    bool prevUseCustomScale = false;         // Previous custom scale usage flag
-
-    // ═══════════════════════════════════════════════════════════════════════════
-    // PER-CHANNEL PROCESSING CONTROLS - Individual channel behavior modifiers
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Post-quantization octave shifting (applied after scale quantization)
-    int postOctShift[16] = {0};              // Octave shift per channel: -5 to +5 octaves (0 default)
-
-    // Per-channel slew processing enable/disable flags (all channels enabled by default)
-    bool slewEnabled[16] = {true, true, true, true, true, true, true, true,
-                            true, true, true, true, true, true, true, true};
-
-    // ═══════════════════════════════════════════════════════════════════════════
-    // GLOBAL QUANTIZATION SETTINGS - Root note and scale selection
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Musical root note for quantization (scale degree 0)
-    int rootNote = 0;                        // Index: 0..(edo-1). For 12-EDO: 0=C, 1=C#, ..., 11=B
-    
-    // Preset scale selection index for current EDO
-    int scaleIndex = 0;                      // Index into scales table (ignored when useCustomScale=true)
-
-    // Note: Preset scale data tables are defined in hi::music::scales12()/scales24()
-
-    // ═══════════════════════════════════════════════════════════════════════════
-    // POLYPHONY TRANSITION SYSTEM - Pop-free channel count changes
-    // ═══════════════════════════════════════════════════════════════════════════
-    
-    // Channel switching fade behavior:
-    // 1. When desired channel count changes: fade OUT current channels
-    // 2. Switch to new channel count while silent
-    // 3. Fade IN new channels to prevent audio pops
-    // Fade time is user-configurable via context menu (default: 100ms)
-    
-    // Centralized polyphony transition state manager
-    hi::dsp::polytrans::State polyTrans;    // Handles fade phases and channel count management
-    
-    // Configurable fade duration for smooth channel transitions
-    float polyFadeSec = 0.1f;               // Fade time in seconds (0.1s = 100ms default)
-
     // ═══════════════════════════════════════════════════════════════════════════
     // UTILITY METHODS - Musical quantization and voltage range mapping
     // ═══════════════════════════════════════════════════════════════════════════
 
     /*
     -------------------------------------------------------------------
-        quantizeToScale(): Musical voltage quantizer utility
-        - Snaps input voltage (1V/oct standard) to active EDO/TET scale
-        - Supports both preset scales and custom scale masks
-        - Optional voltage bounds limiting for range control
-        
         currentClipLimit(): Range voltage mapper
         - Maps clipVppIndex selection to ±limit voltage values
         - Used by range processing for consistent voltage limiting
     -------------------------------------------------------------------
     */
     
-    // Musical quantizer: snap voltage to current scale configuration
-    // Parameters:
-    //   v: Input voltage in 1V/oct format
-    //   shiftSteps: Additional step offset (for octave shifts, etc.)
-    //   boundLimit: Maximum voltage limit (±volts)
-    //   boundToLimit: Whether to enforce voltage bounds on output
-    float quantizeToScale(float v, int shiftSteps = 0, float boundLimit = 10.f, bool boundToLimit = false) const {
-        // Configure quantizer with current module settings
-        hi::dsp::QuantConfig qc;
-        
-        // Set up tuning system parameters
-        if (tuningMode == 0) {
-            // EDO (Equal Division of Octave) mode
-            qc.edo = (edo <= 0) ? 12 : edo;      // Use 12-EDO as fallback for invalid values
-            qc.periodOct = 1.f;                  // Octave period (1.0 = 2:1 frequency ratio)
-        } else {
-            // TET (Equal Temperament) mode - non-octave repeating systems
-            qc.edo = tetSteps > 0 ? tetSteps : 9;                                    // Use 9 steps as fallback
-            qc.periodOct = (tetPeriodOct > 0.f) ? tetPeriodOct : std::log2(3.f/2.f); // Use perfect fifth as fallback
+    // Block-rate control evaluation: every parameter-derived value that only changes when a
+    // knob/menu moves (randomizer params, dual-bank globals, slew times, offsets, shapes,
+    // range limit, quantizer tables). Called every controlRateDiv samples from process().
+    void evalControls() {
+        hi::dsp::ControlSnapshot cs;                                    // Knob-derived values for this block
+        readControls(cs);
+        applyControls(cs);                                              // Ramped block values, quantizer tables, nudge bound
+    }
+
+    // Param side of evalControls(): randomizer params and dual-bank resolution are applied to the
+    // module, engine-bound values land in cs (block-latency mode hands cs to processBlock()).
+    void readControls(hi::dsp::ControlSnapshot& cs) {
+        // Update randomization parameters from front-panel controls
+        if (RND_AMT_PARAM < PARAMS_LEN)
+            randMaxPct = rack::clamp(params[RND_AMT_PARAM].getValue(), 0.f, 1.f); // Clamp randomization strength
+        // Cache toggle states for randomization system
+        if (RND_AUTO_PARAM < PARAMS_LEN) rndAutoEnabled = params[RND_AUTO_PARAM].getValue() > 0.5f;
+        if (RND_SYNC_PARAM < PARAMS_LEN) rndSyncMode = params[RND_SYNC_PARAM].getValue() > 0.5f;
+        // Handle mode switch: recall per-mode stored raw value & reset schedulers appropriately
+        if (rndSyncMode != prevRndSyncMode) {
+            if (RND_TIME_PARAM < PARAMS_LEN) params[RND_TIME_PARAM].setValue(rndSyncMode ? rndTimeRawSync : rndTimeRawFree);
+            if (rndSyncMode) { rndNextFireTime = -1.0; } else { rndTimerSec = 0.0; } // Reset appropriate scheduler with double timestamps
+            prevRndSyncMode = rndSyncMode;                              // Update previous state
         }
-        
-        // Configure scale and root settings
-        qc.root = rootNote;                      // Current root note (scale degree 0)
-        qc.useCustom = useCustomScale;           // Use custom mask vs. preset scales
-        qc.customFollowsRoot = true;             // Custom scales always follow root transposition
-        qc.scaleIndex = scaleIndex;              // Preset scale selection index
-        // Handle custom masks for all EDO sizes using unified vector system
-        if (qc.useCustom) {
-            // Validate mask size matches current EDO
-            if ((int)customMaskGeneric.size() == qc.edo) {
-                qc.customMaskGeneric = customMaskGeneric.data();    // Provide mask data pointer
-                qc.customMaskLen = (int)customMaskGeneric.size();   // Set mask length
-            } else {
-                // Invalid or missing mask - disable custom scale
-                qc.customMaskGeneric = nullptr;                     // No mask data
-                qc.customMaskLen = 0;                               // Zero length
-            }
+        ctl.rndTimeRaw = (RND_TIME_PARAM < PARAMS_LEN) ? params[RND_TIME_PARAM].getValue() : 0.5f;
+        {
+            // Convert raw parameter [0..1] to seconds (logarithmic scale, 1ms to 10000s range)
+            const float mn = 0.001f, mx = 10000.f;
+            float lmn = std::log10(mn), lmx = std::log10(mx);          // Log scale bounds
+            float lx = lmn + rack::clamp(ctl.rndTimeRaw, 0.f, 1.f) * (lmx - lmn); // Map to log range
+            float intervalSec = std::pow(10.f, lx);                     // Convert back to linear time
+            ctl.rndIntervalSec = (intervalSec < 0.001f) ? 0.001f : intervalSec; // Enforce minimum interval (1ms)
         }
-        
-        // Perform quantization using configured parameters
-        return hi::dsp::snapEDO(v, qc, boundLimit, boundToLimit, shiftSteps);
+
+        // Global slew curve shapes (the engine rebuilds its curve tables on change only)
+        cs.riseShape = params[RISE_SHAPE_PARAM].getValue();
+        cs.fallShape = params[FALL_SHAPE_PARAM].getValue();
+        // Calculate voltage range limit for pre-quantization clipping/scaling
+        cs.clipLimit = currentClipLimit();
+
+        // Dual-Mode Global Control Management: Handle Bank Switching and Value Persistence
+        bool modeSlewNow = params[GLOBAL_SLEW_MODE_PARAM].getValue() > 0.5f;  // Current slew mode toggle
+        bool modeOffNow = params[GLOBAL_OFFSET_MODE_PARAM].getValue() > 0.5f; // Current offset mode toggle
+        // Persist active bank values from current raw knob positions
+        if (gSlew.mode) gSlew.b = params[GLOBAL_SLEW_PARAM].getValue(); else gSlew.a = params[GLOBAL_SLEW_PARAM].getValue();
+        if (gOffset.mode) gOffset.b = params[GLOBAL_OFFSET_PARAM].getValue(); else gOffset.a = params[GLOBAL_OFFSET_PARAM].getValue();
+        // Handle mode changes: snap knob to saved value of the new bank
+        if (modeSlewNow != gSlew.mode) {
+            params[GLOBAL_SLEW_PARAM].setValue(modeSlewNow ? gSlew.b : gSlew.a); // Restore bank value
+            gSlew.mode = modeSlewNow;                                   // Update mode state
+        }
+        if (modeOffNow != gOffset.mode) {
+            params[GLOBAL_OFFSET_PARAM].setValue(modeOffNow ? gOffset.b : gOffset.a); // Restore bank value
+            gOffset.mode = modeOffNow;                                  // Update mode state
+        }
+
+        // Derive Active Control Values from Dual-Mode Banks and "Always On" Overrides
+        bool useSlewAdd = (!gSlew.mode) || slewAddAlwaysOn;             // Use slew-add mode
+        cs.useAttv = (gSlew.mode) || attenuverterAlwaysOn;              // Use attenuverter mode
+        if (useSlewAdd) {
+            // Use the banked value for slew-add when knob is currently set to attenuverter
+            float rawSlew = gSlew.mode ? gSlew.a : params[GLOBAL_SLEW_PARAM].getValue();
+            cs.gsecAdd = hi::ui::ExpTimeQuantity::knobToSec(rawSlew);   // Convert to seconds
+        }
+        if (cs.useAttv) {
+            float rawAttv = gSlew.mode ? params[GLOBAL_SLEW_PARAM].getValue() : gSlew.b;
+            rawAttv = rack::math::clamp(rawAttv, 0.f, 1.f);             // Safety clamp
+            cs.gain = -10.f + 20.f * rawAttv;                           // Map to [-10,+10] gain range
+        }
+
+        // Offset Control Processing: Global and Range Offsets from Dual-Mode Banks
+        bool useRangeOff = gOffset.mode || rangeOffsetAlwaysOn;         // Use range offset mode
+        bool useGlobOff = (!gOffset.mode) || globalOffsetAlwaysOn;      // Use global offset mode
+        if (useRangeOff) {
+            float v = gOffset.mode ? params[GLOBAL_OFFSET_PARAM].getValue() : gOffset.b;
+            cs.rangeOffset = clamp(v, -5.f, 5.f);                       // Range offset: ±5V limit
+        }
+        if (useGlobOff) {
+            float v = gOffset.mode ? gOffset.a : params[GLOBAL_OFFSET_PARAM].getValue();
+            cs.globalOffset = clamp(v, -10.f, 10.f);                    // Global offset: ±10V limit
+        }
+
+        // Per-channel knobs: offsets and slew times (knobToSec's log/pow only once per block)
+        for (int c = 0; c < 16; ++c) {
+            cs.off[c] = params[OFF_PARAM[c]].getValue();
+            cs.slSec[c] = hi::ui::ExpTimeQuantity::knobToSec(params[SL_PARAM[c]].getValue());
+        }
+    }
+
+    // Block-latency mode: render the queued FIFO frames (split where the input width changed).
+    void renderQueuedBlock(float dt) {
+        hi::dsp::ControlSnapshot cs;
+        readControls(cs);                                               // One param read per block
+        for (int f = 0; f < fifo.latency;) {
+            int end = f + 1;
+            while (end < fifo.latency && fifo.inCh[end] == fifo.inCh[f]) ++end;
+            processBlock(fifo.in + f * 16, fifo.out + f * 16, end - f, fifo.inCh[f], dt, cs, fifo.outCh + f);
+            f = end;
+        }
+    }
+
+    // Decimated UI update: publish a telemetry frame and copy the LED state to the lights.
+    // The engine keeps smoothing ledBright every sample; Rack only reads lights per UI frame.
+    void publishTelemetry(float sampleRate) {
+        if (--telemetryCountdown > 0) return;
+        telemetryCountdown = std::max(1, (int)(sampleRate / hi::dsp::telemetry::kPublishHz));
+        hi::dsp::telemetry::Frame f;
+        f.activeN = polyTrans.curProcN;
+        for (int c = 0; c < 16; ++c) { f.volts[c] = voices.lastOut[c]; f.step[c] = voices.latchedStep[c]; }
+        for (int i = 0; i < 32; ++i) {
+            f.led[i] = voices.ledBright[i];
+            lights[CH_LIGHT + i].setBrightness(f.led[i]);
+        }
+        telemetry.publish(f);
+    }
+
+    // Left neighbour's frame when chaining is on and a PolyQuanta sits there (else nullptr)
+    const hi::dsp::chain::Frame* chainSource() const {
+        if (!chainFromLeft || !leftExpander.module || leftExpander.module->model != modelPolyQuanta) return nullptr;
+        const auto* f = static_cast<const hi::dsp::chain::Frame*>(leftExpander.consumerMessage);
+        return hi::dsp::chain::valid(f) ? f : nullptr;
+    }
+
+    // Hand this sample's output to a PolyQuanta on the right. Steps go along only when they
+    // describe the output (no mono sum, not playing back a FIFO block rendered earlier).
+    void feedChain() {
+        Module* r = rightExpander.module;
+        if (!r || r->model != modelPolyQuanta) return;
+        auto* f = static_cast<hi::dsp::chain::Frame*>(r->leftExpander.producerMessage);
+        float v[16];
+        const int n = outputs[OUT_OUTPUT].getChannels();
+        for (int c = 0; c < n; ++c) v[c] = outputs[OUT_OUTPUT].getVoltage(c);
+        const bool stepsValid = fifo.latency == 0 && !sumToMonoOut;
+        hi::dsp::chain::fill(*f, v, n, voices.latchedStep, chainSentStep, stepsValid ? plan : nullptr);
+        r->leftExpander.requestMessageFlip();
     }
 
     // Range voltage mapper: convert clipVppIndex to actual voltage limit
@@ -986,6 +949,7 @@ struct PolyQuanta : Module {
     PolyQuanta() {
         // Configure VCV Rack module with total counts of each component type
 		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+        rng.seed(rack::random::u64());                                  // Fresh per-instance stream (JSON restores saved state)
 
         // Configure per-channel parameter controls (16 channels total)
         for (int i = 0; i < 16; ++i) {
@@ -1002,24 +966,11 @@ struct PolyQuanta : Module {
             // Note: Per-channel quantization enable is now controlled via context menu (qzEnabled[])
             // rather than front-panel buttons for cleaner UI
         }
-        // Initialize quantizer state for all channels
-        for (int i = 0; i < 16; ++i) { 
-            latchedInit[i] = false;  // No quantizer step latched yet
-            latchedStep[i] = 0;      // Default to step 0 when latching begins
-        }
-        
         // Configure global slew curve shape parameters
         // Range: -1.0 (logarithmic) to +1.0 (exponential), default: 0.0 (linear)
         configParam<hi::ui::ShapeQuantity>(RISE_SHAPE_PARAM, -1.f, 1.f, 0.f, "Rise shape");
         configParam<hi::ui::ShapeQuantity>(FALL_SHAPE_PARAM, -1.f, 1.f, 0.f, "Fall shape");
 
-        // Initialize per-channel pre-processing transform defaults
-        // These transforms are applied before global range processing
-        for (int i = 0; i < 16; ++i) {
-            preScale[i] = 1.f;   // No scaling by default (1.0x multiplier)
-            preOffset[i] = 0.f;  // No pre-offset by default (0V addition)
-        }
-
         // ═══════════════════════════════════════════════════════════════════════════
         // DUAL-MODE GLOBAL CONTROL CONFIGURATION - Advanced parameter quantities
         // ═══════════════════════════════════════════════════════════════════════════
@@ -1412,16 +1363,10 @@ struct PolyQuanta : Module {
         configParam<PercentQuantity>(RND_AMT_PARAM, 0.f, 1.f, 1.f, "Amount");        // Randomization strength (0-100%)
         configParam(RND_AUTO_PARAM, 0.f, 1.f, 0.f, "Auto (On/Off)");                 // Enable/disable auto-randomization
         configParam(RND_SYNC_PARAM, 0.f, 1.f, 0.f, "Sync (Sync/Trig)");      // Sync mode toggle (clock sync vs trigger)
-        
-        // ═══════════════════════════════════════════════════════════════════════════════════════════════════
-        // Per-Channel Step Tracking Initialization
-        // ═══════════════════════════════════════════════════════════════════════════════════════════════════
-        for (int i = 0; i < 16; ++i) {
-            stepNorm[i] = 10.f;                                         // Initialize step normalization to safe default
-            stepSign[i] = 0;                                            // Initialize step direction to neutral
-            prevRiseRate[i] = -1.f;                                     // Mark rise rate as uninitialized
-            prevFallRate[i] = -1.f;                                     // Mark fall rate as uninitialized
-        }
+        leftExpander.producerMessage = &chainBuf[0];                                 // Written by a PolyQuanta on the left
+        leftExpander.consumerMessage = &chainBuf[1];                                 // Read here after Rack's flip
+        publishTuning();                                                             // Audio thread reads tuning via snapshots only
+        requestAnalysis();                                                           // Status line / MOS menus ready on first open
     }
 
     // ═══════════════════════════════════════════════════════════════════════════════════════════════════
@@ -1431,6 +1376,8 @@ struct PolyQuanta : Module {
     // and octave shifts, and randomize locks/allows. Keys are stable for forward/backward compatibility.
     json_t* dataToJson() override {
         json_t* rootJ = json_object();
+        const bool compact = compactPatch;                                              // Compact schema (opt-in)
+        if (compact) json_object_set_new(rootJ, "schema", json_integer(hi::util::patch::kCompactSchema));
         
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Core Module Configuration
@@ -1442,14 +1389,24 @@ struct PolyQuanta : Module {
         hi::util::jsonh::writeBool(rootJ, "softClipOut", softClipOut);                 // Soft clipping on output
         json_object_set_new(rootJ, "clipVppIndex", json_integer(clipVppIndex));        // Voltage clipping range index
         json_object_set_new(rootJ, "rangeMode", json_integer(rangeMode));              // Range handling mode (clip/scale)
+        json_object_set_new(rootJ, "controlRateDiv", json_integer(controlRateDiv));    // Control evaluation block size
+        hi::util::jsonh::writeBool(rootJ, "controlRateSmooth", controlRateSmooth);     // Ramp offsets/gain per block
+        json_object_set_new(rootJ, "blockLatency", json_integer(blockLatency));        // Block FIFO size (samples)
+        hi::util::jsonh::writeBool(rootJ, "chainFromLeft", chainFromLeft);             // Input from left PolyQuanta
+        if (!scalaScl.empty()) {
+            json_object_set_new(rootJ, "scalaScl", json_string(scalaScl.c_str()));     // Scala scale file text
+            json_object_set_new(rootJ, "scalaKbm", json_string(scalaKbm.c_str()));     // Scala keymap file text ("" = none)
+        }
         
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Offset Snap Mode Configuration (Global and Per-Channel)
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         json_object_set_new(rootJ, "snapOffsetMode", json_integer(snapOffsetMode));    // Global snap offset mode enum
         
-        // Save per-channel snap offset modes as JSON array
-        {
+        // Save per-channel snap offset modes as JSON array (compact: only when they differ from the global mode)
+        bool snapUniform = true;
+        for (int i = 0; i < 16; ++i) snapUniform &= snapOffsetModeCh[i] == snapOffsetMode;
+        if (!compact || !snapUniform) {
             json_t* arr = json_array();
             for (int i = 0; i < 16; ++i) {
                 json_array_append_new(arr, json_integer(snapOffsetModeCh[i]));         // Per-channel snap mode
@@ -1458,7 +1415,7 @@ struct PolyQuanta : Module {
         }
         
         // Legacy compatibility: write boolean for old versions (true only if semitone mode)
-        hi::util::jsonh::writeBool(rootJ, "snapOffsets", snapOffsetMode == 1);
+        if (!compact) hi::util::jsonh::writeBool(rootJ, "snapOffsets", snapOffsetMode == 1);
         
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Dual-Mode Global Controls (Slew and Offset)
@@ -1496,6 +1453,15 @@ struct PolyQuanta : Module {
         hi::util::jsonh::writeBool(rootJ, "randOffset", randOffset);                  // Include offsets in randomization
         hi::util::jsonh::writeBool(rootJ, "randShapes", randShapes);                  // Include curve shapes in randomization
         json_object_set_new(rootJ, "randMaxPct", json_real(randMaxPct));              // Maximum randomization percentage
+        json_object_set_new(rootJ, "rndMorphSec", json_real(rndMorphSec));            // Randomization glide time (0 = jump)
+        {
+            // Randomizer/strum RNG state as hex words (JSON integers are signed 64-bit)
+            uint64_t st[hi::dsp::rng::kStateWords];
+            rng.getState(st);
+            json_t* a = json_array();
+            for (uint64_t w : st) json_array_append_new(a, json_string(string::f("%016llx", (unsigned long long)w).c_str()));
+            json_object_set_new(rootJ, "rngState", a);
+        }
         
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Auto-Randomization Configuration
@@ -1506,12 +1472,13 @@ struct PolyQuanta : Module {
         // Persist per-mode raw time knob values for dual-mode time parameter
         json_object_set_new(rootJ, "rndTimeRawFree", json_real(rndTimeRawFree));      // Free-running time mode value
         json_object_set_new(rootJ, "rndTimeRawSync", json_real(rndTimeRawSync));      // Clock sync mode value
-        json_object_set_new(rootJ, "rndTimeRaw", json_real(params[RND_TIME_PARAM].getValue())); // Legacy compatibility
+        if (!compact) json_object_set_new(rootJ, "rndTimeRaw", json_real(params[RND_TIME_PARAM].getValue())); // Legacy compatibility
         
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Per-Channel Quantization and Octave Shift Settings
         // ───────────────────────────────────────────────────────────────────────────────────────────────
-        for (int i = 0; i < 16; ++i) {
+        // Compact schema: packed by coreToJson below instead
+        for (int i = 0; i < 16 && !compact; ++i) {
             char key[32];
             // Save quantization enable state for each channel
             std::snprintf(key, sizeof(key), "qzEnabled%d", i + 1);
@@ -1529,14 +1496,24 @@ struct PolyQuanta : Module {
         {
             hi::dsp::CoreState cs;                                      // Create core state structure
             fillCoreStateFromModule(*this, cs);                        // Copy module state to core structure
-            hi::dsp::coreToJson(rootJ, cs);                            // Serialize core state to JSON
+            hi::dsp::coreToJson(rootJ, cs, compact);                   // Serialize core state to JSON
         }
         
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Randomization Lock and Allow States
         // ───────────────────────────────────────────────────────────────────────────────────────────────
-        // Per-channel randomization control settings
-        for (int i = 0; i < 16; ++i) {
+        // Per-channel randomization control settings (compact: one bitfield per kind, omitted when clear)
+        if (compact) {
+            const struct { const char* key; const bool* flags; } packed[] = {
+                {"lockSlewBits", lockSlew}, {"lockOffsetBits", lockOffset},
+                {"allowSlewBits", allowSlew}, {"allowOffsetBits", allowOffset},
+            };
+            for (const auto& p : packed) {
+                const uint32_t bits = hi::util::patch::packFlags(p.flags, 16);
+                if (bits) json_object_set_new(rootJ, p.key, json_integer(bits));
+            }
+        }
+        for (int i = 0; i < 16 && !compact; ++i) {
             char key[32];
             // Lock states: prevent randomization of specific parameters
             std::snprintf(key, sizeof(key), "lockSlew%d", i + 1);
@@ -1566,7 +1543,7 @@ struct PolyQuanta : Module {
             for (int i = 0; i < 16; ++i) {
                 if (!slewEnabled[i]) slewDisabledMask |= (1 << i);         // Set bit if slew is disabled
             }
-            json_object_set_new(rootJ, "slewDisabledMask", json_integer(slewDisabledMask));
+            if (!compact || slewDisabledMask) json_object_set_new(rootJ, "slewDisabledMask", json_integer(slewDisabledMask));
         }
         
         // Note: rootNote/scaleIndex are now serialized via CoreState delegation above
@@ -1574,8 +1551,13 @@ struct PolyQuanta : Module {
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Per-Channel Pre-Range Transform Settings
         // ───────────────────────────────────────────────────────────────────────────────────────────────
-        // Save per-channel voltage scaling factors as JSON array
-        {
+        // Save per-channel voltage scaling factors as JSON array (compact: omitted at unity/zero)
+        bool preDefault[2] = {true, true};
+        for (int i = 0; i < 16; ++i) {
+            preDefault[0] &= preScale[i] == 1.f;
+            preDefault[1] &= preOffset[i] == 0.f;
+        }
+        if (!compact || !preDefault[0]) {
             json_t* a = json_array();
             for (int i = 0; i < 16; ++i) {
                 json_array_append_new(a, json_real(preScale[i]));          // Voltage scaling factor for each channel
@@ -1584,7 +1566,7 @@ struct PolyQuanta : Module {
         }
         
         // Save per-channel voltage offset values as JSON array
-        {
+        if (!compact || !preDefault[1]) {
             json_t* a = json_array();
             for (int i = 0; i < 16; ++i) {
                 json_array_append_new(a, json_real(preOffset[i]));         // Voltage offset for each channel
@@ -1610,6 +1592,11 @@ struct PolyQuanta : Module {
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Core Module Configuration Restoration
         // ───────────────────────────────────────────────────────────────────────────────────────────────
+        // Compact schema omits keys at their default, so their absence means "reset", not "keep"
+        bool compact = false;
+        if (auto* j = json_object_get(rootJ, "schema")) compact = json_integer_value(j) >= hi::util::patch::kCompactSchema;
+        compactPatch = compact;                                        // Re-save in the schema it was loaded from
+        
         // Handle legacy forcePolyOut => forcedChannels migration
         if (auto* j = json_object_get(rootJ, "forcedChannels")) {
             forcedChannels = (int)json_integer_value(j);                   // Read new format
@@ -1627,6 +1614,23 @@ struct PolyQuanta : Module {
         // Restore integer settings with JSON validation
         if (auto* j = json_object_get(rootJ, "clipVppIndex")) clipVppIndex = (int)json_integer_value(j);
         if (auto* j = json_object_get(rootJ, "rangeMode")) rangeMode = (int)json_integer_value(j);
+        if (auto* j = json_object_get(rootJ, "controlRateDiv")) {
+            int d = (int)json_integer_value(j);
+            controlRateDiv = hi::dsp::ctlrate::isValidDiv(d) ? d : 1;   // Unknown sizes fall back to every sample
+        }
+        controlRateSmooth = hi::util::jsonh::readBool(rootJ, "controlRateSmooth", controlRateSmooth);
+        if (auto* j = json_object_get(rootJ, "blockLatency")) {
+            int l = (int)json_integer_value(j);
+            blockLatency = hi::dsp::blockio::isValidLatency(l) ? l : 0; // Unknown sizes fall back to no FIFO
+        }
+        chainFromLeft = hi::util::jsonh::readBool(rootJ, "chainFromLeft", chainFromLeft);
+        if (auto* j = json_object_get(rootJ, "scalaScl")) {          // tuningMode/mask/root come from CoreState
+            auto* jk = json_object_get(rootJ, "scalaKbm");
+            loadScala(json_string_value(j) ? json_string_value(j) : "",
+                      (jk && json_string_value(jk)) ? json_string_value(jk) : "", false);
+        }
+        ctl.phase = 0;                                                  // Re-evaluate controls on the next sample
+        wakeAllVoices();                                                // Restored state invalidates settled voices
         
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Offset Snap Mode Configuration Restoration
@@ -1706,6 +1710,22 @@ struct PolyQuanta : Module {
         randOffset = hi::util::jsonh::readBool(rootJ, "randOffset", randOffset);        // Include offsets in randomization
         randShapes = hi::util::jsonh::readBool(rootJ, "randShapes", randShapes);        // Include curve shapes in randomization
         if (auto* j = json_object_get(rootJ, "randMaxPct")) randMaxPct = (float)json_number_value(j);
+        if (auto* j = json_object_get(rootJ, "rndMorphSec")) {
+            float t = (float)json_number_value(j);
+            rndMorphSec = hi::dsp::morph::isValidTime(t) ? t : 0.f;    // Unknown times fall back to jumping
+        }
+        if (auto* a = json_object_get(rootJ, "rngState")) {
+            // Keep the fresh seed unless all eight words parse (older patches have no state)
+            uint64_t st[hi::dsp::rng::kStateWords];
+            bool ok = json_array_size(a) == (size_t)hi::dsp::rng::kStateWords;
+            for (int i = 0; ok && i < hi::dsp::rng::kStateWords; ++i) {
+                const char* hex = json_string_value(json_array_get(a, i));
+                char* end = nullptr;
+                st[i] = hex ? (uint64_t)std::strtoull(hex, &end, 16) : 0;
+                ok = hex && end && *end == '\0' && end != hex;
+            }
+            if (ok) rng.setState(st);
+        }
         
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Auto-Randomization Configuration Restoration
@@ -1774,6 +1794,18 @@ struct PolyQuanta : Module {
             allowOffset[i] = hi::util::jsonh::readBool(rootJ, key, allowOffset[i]); // Allow offset randomization
         }
         
+        // Compact schema: packed bitfields (absent = all clear) replace the per-channel keys
+        if (compact) {
+            const struct { const char* key; bool* flags; } packed[] = {
+                {"lockSlewBits", lockSlew}, {"lockOffsetBits", lockOffset},
+                {"allowSlewBits", allowSlew}, {"allowOffsetBits", allowOffset},
+            };
+            for (const auto& p : packed) {
+                auto* j = json_object_get(rootJ, p.key);
+                hi::util::patch::unpackFlags(j ? (uint32_t)json_integer_value(j) : 0u, p.flags, 16);
+            }
+        }
+        
         // Global curve shape randomization control
         lockRiseShape = hi::util::jsonh::readBool(rootJ, "lockRiseShape", lockRiseShape);     // Lock rise curve shape from randomization
         lockFallShape = hi::util::jsonh::readBool(rootJ, "lockFallShape", lockFallShape);     // Lock fall curve shape from randomization
@@ -1798,7 +1830,11 @@ struct PolyQuanta : Module {
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Per-Channel Pre-Range Transform Settings Restoration
         // ───────────────────────────────────────────────────────────────────────────────────────────────
-        // Restore per-channel voltage scaling factors from JSON array (defaults already set in constructor)
+        // Restore per-channel voltage scaling factors from JSON array (defaults already set in constructor;
+        // a compact patch that omits the arrays resets them to unity/zero)
+        if (compact) {
+            for (int i = 0; i < 16; ++i) { preScale[i] = 1.f; preOffset[i] = 0.f; }
+        }
         if (auto* arr = json_object_get(rootJ, "preScale")) {
             if (json_is_array(arr)) {
                 size_t n = json_array_size(arr);
@@ -1842,6 +1878,8 @@ struct PolyQuanta : Module {
             }
             migratedQZ = true;                                              // Mark migration as completed
         }
+        publishTuning();                                                    // Restored tuning/mask: new snapshot (headless too)
+        requestAnalysis();
     }
 
     // ═══════════════════════════════════════════════════════════════════════════════════════════════════
@@ -1853,23 +1891,10 @@ struct PolyQuanta : Module {
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Per-Channel State Reset
         // ───────────────────────────────────────────────────────────────────────────────────────────────
+        reset();                                                        // Engine: per-voice state, latches, LEDs, strum timers
         for (int i = 0; i < 16; ++i) {
-            stepNorm[i] = 10.f;                                         // Reset step normalization to safe default
-            stepSign[i] = 0;                                            // Reset step direction to neutral
-            prevRiseRate[i] = -1.f;                                     // Mark rise rate as uninitialized
-            prevFallRate[i] = -1.f;                                     // Mark fall rate as uninitialized
-            lastOut[i] = 0.f;                                           // Clear last output value
             lights[CH_LIGHT + 2*i + 0].setBrightness(0.f);             // Turn off positive LED
             lights[CH_LIGHT + 2*i + 1].setBrightness(0.f);             // Turn off negative LED
-            strumDelayAssigned[i] = 0.f;                                // Clear assigned strum delay
-            strumDelayLeft[i] = 0.f;                                    // Clear remaining strum delay
-            strumPrevTarget[i] = 0.f;                                   // Reset last processed target snapshot
-            strumPrevInit[i] = false;                                   // Mark strum target history as uninitialized
-            latchedInit[i] = false;                                     // Reset initialization latch
-            preScale[i] = 1.f;                                          // Reset pre-range scaling to unity
-            preOffset[i] = 0.f;                                         // Reset pre-range offset to zero
-            latchedStep[i] = 0;                                         // Reset step latch counter
-            prevYRel[i] = 0.f;                                          // Reset previous relative position
         }
         
         // ───────────────────────────────────────────────────────────────────────────────────────────────
@@ -1890,6 +1915,7 @@ struct PolyQuanta : Module {
         rndMulBaseTime = -1.0;                                          // Reset multiplication base time using double anchor
         rndMulNextTime = -1.0;                                          // Reset next multiplication time with double precision
         rndPrevRatioIdx = -1;                                           // Reset previous ratio index
+        rndMorph.clear();                                               // Drop glides in progress (knobs stay put)
     }
 
     // ═══════════════════════════════════════════════════════════════════════════════════════════════════
@@ -1897,9 +1923,28 @@ struct PolyQuanta : Module {
     // ═══════════════════════════════════════════════════════════════════════════════════════════════════
     // Applies scoped random changes to slews, offsets, and shape knobs. Honors per-control locks 
     // (when scope ON) or allows (when scope OFF). Magnitude is bounded by the Max percentage option.
+    // Morph slot → parameter id (slot layout of hi::dsp::morph::Bank in this module)
+    int morphParamId(int k) const {
+        return (k < 16) ? SL_PARAM[k] : (k < 32) ? OFF_PARAM[k - 16] : (k == 32) ? RISE_SHAPE_PARAM : FALL_SHAPE_PARAM;
+    }
+
     void doRandomize() {
         using hi::util::rnd::randSpanClamp;
         float maxPct = clamp(randMaxPct, 0.f, 1.f);                     // Clamp randomization strength to valid range
+        // One batch per fire: a fixed 34 draws whatever the scope/locks, so a saved RNG state
+        // replays the same sequence of knob moves
+        float uSlew[16], uOff[16], uShape[2];
+        rng.fillUniform(uSlew, 16);
+        rng.fillUniform(uOff, 16);
+        rng.fillUniform(uShape, 2);
+        // Morph > 0: glide toward the drawn value with staggered param writes (slews every 4
+        // samples at phase c % 4, offsets every sample, shapes every 32 samples 16 apart)
+        const uint32_t morphLen = (uint32_t)std::lround(rndMorphSec * rndSampleRate);
+        auto apply = [&](int k, float v, uint16_t every, uint16_t phase) {
+            rack::engine::Param& p = params[morphParamId(k)];
+            if (morphLen > 0) rndMorph.start(k, p.getValue(), v, morphLen, every, phase);
+            else { rndMorph.cancel(k); p.setValue(v); }
+        };
         
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Per-Channel Slew and Offset Randomization
@@ -1909,16 +1954,16 @@ struct PolyQuanta : Module {
             bool doSlew = randSlew ? (!lockSlew[i]) : allowSlew[i];     // Scope ON: respect locks, Scope OFF: respect allows
             if (doSlew) {
                 float v = params[SL_PARAM[i]].getValue();               // Get current slew rate [0,1]
-                randSpanClamp(v, 0.f, 1.f, maxPct);                    // Apply bounded randomization
-                params[SL_PARAM[i]].setValue(v);                       // Update parameter value
+                randSpanClamp(v, 0.f, 1.f, maxPct, uSlew[i]);          // Apply bounded randomization
+                apply(i, v, 4, (uint16_t)(i & 3));                      // Update (or glide) parameter value
             }
             
             // Determine if offset should be randomized based on scope and lock/allow state
             bool doOff = randOffset ? (!lockOffset[i]) : allowOffset[i]; // Scope ON: respect locks, Scope OFF: respect allows
             if (doOff) {
                 float v = params[OFF_PARAM[i]].getValue();              // Get current offset [-10,10]
-                randSpanClamp(v, -10.f, 10.f, maxPct);                 // Apply bounded randomization
-                params[OFF_PARAM[i]].setValue(v);                      // Update parameter value
+                randSpanClamp(v, -10.f, 10.f, maxPct, uOff[i]);        // Apply bounded randomization
+                apply(16 + i, v, 1, 0);                                 // Update (or glide) parameter value
             }
         }
         
@@ -1930,16 +1975,16 @@ struct PolyQuanta : Module {
             bool doRise = randShapes ? (!lockRiseShape) : allowRiseShape; // Scope ON: respect locks, Scope OFF: respect allows
             if (doRise) {
                 float v = params[RISE_SHAPE_PARAM].getValue();          // Get current rise shape [-1,1]
-                randSpanClamp(v, -1.f, 1.f, maxPct);                   // Apply bounded randomization
-                params[RISE_SHAPE_PARAM].setValue(v);                  // Update parameter value
+                randSpanClamp(v, -1.f, 1.f, maxPct, uShape[0]);        // Apply bounded randomization
+                apply(32, v, 32, 0);                                    // Update (or glide) parameter value
             }
             
             // Determine if fall shape should be randomized based on scope and lock/allow state
             bool doFall = randShapes ? (!lockFallShape) : allowFallShape; // Scope ON: respect locks, Scope OFF: respect allows
             if (doFall) {
                 float v = params[FALL_SHAPE_PARAM].getValue();          // Get current fall shape [-1,1]
-                randSpanClamp(v, -1.f, 1.f, maxPct);                   // Apply bounded randomization
-                params[FALL_SHAPE_PARAM].setValue(v);                  // Update parameter value
+                randSpanClamp(v, -1.f, 1.f, maxPct, uShape[1]);        // Apply bounded randomization
+                apply(33, v, 32, 16);                                   // Update (or glide) parameter value
             }
         }
     }
@@ -2025,72 +2070,34 @@ struct PolyQuanta : Module {
     // while maintaining real-time performance for up to 16 simultaneous channels.
 
         void process(const ProcessArgs& args) override {
+        hi::dsp::diag::Scope diagScope(diag);                               // process() cost (-DHI_DIAGNOSTICS builds only)
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Polyphony Management: Determine Input/Output Channel Counts with Fading
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Detect input connection and determine channel count for processing
-        const bool inConn = inputs[IN_INPUT].isConnected();                 // Check if input is connected
-        const int inCh = inConn ? inputs[IN_INPUT].getChannels() : 0;       // Get input channel count
-            // Calculate desired processing and output channel counts
-            int desiredProcN = 0;
-            if (forcedChannels > 0)
-            desiredProcN = rack::math::clamp(forcedChannels, 1, 16);    // User-forced channel count
-            else
-            desiredProcN = hi::dsp::poly::processWidth(false, inConn, inCh, 16); // Auto-detect from input
-        int desiredOutN = sumToMonoOut ? 1 : desiredProcN;             // Mono sum or match processing width
-
-    // Note: We intentionally use polyTrans.* directly below (no local aliases)
-    // to make it obvious these are fields of the shared transition state.
-
-        // Initialize current counts on first process() call
-        if (polyTrans.curProcN <= 0 && polyTrans.curOutN <= 0) {
-            polyTrans.curProcN = desiredProcN;                          // Set initial processing channel count
-            polyTrans.curOutN = desiredOutN;                            // Set initial output channel count
-            outputs[OUT_OUTPUT].setChannels(polyTrans.curOutN);         // Configure output port channels
-            polyTrans.transPhase = TRANS_STABLE;                        // Mark as stable (no transition)
-            polyTrans.polyRamp = 1.f;                                   // Full volume (no fade)
+        const hi::dsp::chain::Frame* chainIn = chainSource();              // Left PolyQuanta replaces the IN jack
+        const bool inConn = chainIn || inputs[IN_INPUT].isConnected();      // Check if input is connected
+        const int inCh = chainIn ? chainIn->channels : (inConn ? inputs[IN_INPUT].getChannels() : 0);
+        auto inVolt = [&](int c) { return chainIn ? chainIn->volts[c] : inputs[IN_INPUT].getVoltage(c); };
+        // Randomization morph: advance gliding knobs before controls read them
+        rndSampleRate = args.sampleRate;
+        rndMorph.tick([this](int k) { return params[morphParamId(k)].getValue(); },
+                      [this](int k, float v) { params[morphParamId(k)].setValue(v); });
+        if (blockLatency != fifo.latency)                                  // Menu/JSON change: resize on the audio thread
+            fifo.configure(blockLatency, std::max(1, polyTrans.curOutN));
+        float ctlW = 1.f;
+        if (fifo.latency == 0) {
+            // Start (or apply) a width transition; use current, not desired, counts during transitions
+            outputs[OUT_OUTPUT].setChannels(updateWidth(inConn, inCh));
+            // Control-rate decimation: knob-derived values (incl. randomizer params) refresh once per block
+            if (controlDue()) evalControls();
+            // Ramp weight for smoothed controls: reaches 1 (exact current value) on the block's last sample
+            ctlW = advanceControl();
         }
 
-        // Detect a change in desired channel counts and initiate transition
-        bool widthChange = (desiredProcN != polyTrans.curProcN) || (desiredOutN != polyTrans.curOutN);
-        if (widthChange && polyTrans.transPhase == TRANS_STABLE) {
-            polyTrans.pendingProcN = desiredProcN;                      // Store pending processing count
-            polyTrans.pendingOutN = desiredOutN;                        // Store pending output count
-            
-            // Start fade out if time > 0, otherwise immediate switch
-            if (polyFadeSec > 0.f) {
-                polyTrans.transPhase = TRANS_FADE_OUT;                  // Begin fade-out transition
-            } else {
-                // Immediate switch (no fade time configured)
-                polyTrans.curProcN = polyTrans.pendingProcN;           // Apply new processing count immediately
-                polyTrans.curOutN = polyTrans.pendingOutN;             // Apply new output count immediately
-                outputs[OUT_OUTPUT].setChannels(polyTrans.curOutN);    // Update output port channels
-                polyTrans.initToTargetsOnSwitch = true;                // Flag for target initialization
-                polyTrans.transPhase = TRANS_STABLE;                   // Return to stable state
-                polyTrans.polyRamp = 1.f;                              // Full volume (no fade needed)
-            }
-        }
-
-        // Set the output channel count for this block (use current, not desired during transitions)
-        outputs[OUT_OUTPUT].setChannels(polyTrans.curOutN);
-
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         // Randomization System: Handle Manual Triggers and Auto-Randomization Timing
         // ───────────────────────────────────────────────────────────────────────────────────────────────
-            // Update randomization parameters from front-panel controls
-            if (RND_AMT_PARAM < PARAMS_LEN)
-            randMaxPct = rack::clamp(params[RND_AMT_PARAM].getValue(), 0.f, 1.f); // Clamp randomization strength
-        
-        // Cache toggle states for randomization system
-            if (RND_AUTO_PARAM < PARAMS_LEN) rndAutoEnabled = params[RND_AUTO_PARAM].getValue() > 0.5f;
-        if (RND_SYNC_PARAM < PARAMS_LEN) rndSyncMode = params[RND_SYNC_PARAM].getValue() > 0.5f;
-        
-        // Handle mode switch: recall per-mode stored raw value & reset schedulers appropriately
-        if (rndSyncMode != prevRndSyncMode) {
-            if (RND_TIME_PARAM < PARAMS_LEN) params[RND_TIME_PARAM].setValue(rndSyncMode ? rndTimeRawSync : rndTimeRawFree);
-            if (rndSyncMode) { rndNextFireTime = -1.0; } else { rndTimerSec = 0.0; } // Reset appropriate scheduler with double timestamps
-            prevRndSyncMode = rndSyncMode;                              // Update previous state
-        }
         
         // Manual randomization button always fires immediately
         bool manualFire = rndBtnTrig.process(params[RND_PARAM].getValue() > 0.5f);
@@ -2133,15 +2140,7 @@ struct PolyQuanta : Module {
         // Auto-Randomization Scheduling: Free-Running or Clock-Synchronized
         // ───────────────────────────────────────────────────────────────────────────────────────────────
         if (rndAutoEnabled) {
-            float raw = (RND_TIME_PARAM < PARAMS_LEN) ? params[RND_TIME_PARAM].getValue() : 0.5f;
-            
-            // Lambda for converting raw parameter [0..1] to seconds (logarithmic scale)
-            auto rawToSec = [](float r) { 
-                const float mn = 0.001f, mx = 10000.f;                 // 1ms to 10000s range
-                float lmn = std::log10(mn), lmx = std::log10(mx);      // Log scale bounds
-                float lx = lmn + rack::clamp(r, 0.f, 1.f) * (lmx - lmn); // Map to log range
-                return std::pow(10.f, lx);                             // Convert back to linear time
-            };
+            float raw = ctl.rndTimeRaw;                                 // Block-rate knob read (see evalControls)
             
             // Clock sync ratio mapping: indices 0..125 divides (÷64..÷2), 126 center (1×), 127..251 multiplies (×2..×64)
             const int DIV_MAX = 64;
@@ -2233,8 +2232,7 @@ struct PolyQuanta : Module {
                 // Free-Running Mode: Logarithmic Time-Based Auto-Randomization
                 // ───────────────────────────────────────────────────────────────────────────
                 rndTimeRawFree = raw;                                       // Store raw value for free mode
-                float intervalSec = rawToSec(raw);                          // Convert to seconds using log scale
-                if (intervalSec < 0.001f) intervalSec = 0.001f;            // Enforce minimum interval (1ms)
+                float intervalSec = ctl.rndIntervalSec;                     // Log-scale seconds (≥ 1ms), block rate
                 rndTimerSec += dt;                                          // Accumulate elapsed time in double precision
                 if (rndTimerSec >= intervalSec) {                           // Time to randomize?
                     doRandomize();                                          // Execute randomization
@@ -2246,782 +2244,47 @@ struct PolyQuanta : Module {
             if (rndTimerSec > 60.0) rndTimerSec = std::fmod(rndTimerSec, 60.0); // Wrap timer safely using double constants
         }
 
-            // ═══════════════════════════════════════════════════════════════════════════
-            // GLOBAL PARAMETER PREPARATION - Extract and precompute shared values
-            // ═══════════════════════════════════════════════════════════════════════════
-            
-            // Extract global slew curve shape parameters and precompute coefficients
-            const float riseShape = params[RISE_SHAPE_PARAM].getValue(); // [-1,1]: log to exp curve
-            const float fallShape = params[FALL_SHAPE_PARAM].getValue(); // [-1,1]: log to exp curve
-            auto riseParams = hi::dsp::glide::makeShape(riseShape);      // Precomputed curve coefficients
-            auto fallParams = hi::dsp::glide::makeShape(fallShape);      // Precomputed curve coefficients
-
-            // Calculate voltage range limit for pre-quantization clipping/scaling
-            float clipLimit = currentClipLimit();                       // Get current range limit setting
-            
-        // ───────────────────────────────────────────────────────────────────────────────────────────────
-        // Dual-Mode Global Control Management: Handle Bank Switching and Value Persistence
-        // ───────────────────────────────────────────────────────────────────────────────────────────────
-        bool modeSlewNow = params[GLOBAL_SLEW_MODE_PARAM].getValue() > 0.5f;  // Current slew mode toggle
-        bool modeOffNow = params[GLOBAL_OFFSET_MODE_PARAM].getValue() > 0.5f; // Current offset mode toggle
-        
-        // Persist active bank values from current raw knob positions
-        if (gSlew.mode) gSlew.b = params[GLOBAL_SLEW_PARAM].getValue(); else gSlew.a = params[GLOBAL_SLEW_PARAM].getValue();
-        if (gOffset.mode) gOffset.b = params[GLOBAL_OFFSET_PARAM].getValue(); else gOffset.a = params[GLOBAL_OFFSET_PARAM].getValue();
-        
-        // Handle mode changes: snap knob to saved value of the new bank
-        if (modeSlewNow != gSlew.mode) {
-            params[GLOBAL_SLEW_PARAM].setValue(modeSlewNow ? gSlew.b : gSlew.a); // Restore bank value
-            gSlew.mode = modeSlewNow;                               // Update mode state
-        }
-        if (modeOffNow != gOffset.mode) {
-            params[GLOBAL_OFFSET_PARAM].setValue(modeOffNow ? gOffset.b : gOffset.a); // Restore bank value
-            gOffset.mode = modeOffNow;                          // Update mode state
-        }
-        
         // ───────────────────────────────────────────────────────────────────────────────────────────────
-        // Derive Active Control Values from Dual-Mode Banks and "Always On" Overrides
+        // Block Latency: Queue This Frame, Play Back the One Rendered `latency` Samples Ago
         // ───────────────────────────────────────────────────────────────────────────────────────────────
-        float gsecAdd = 0.f;                                    // Additional slew time in seconds
-        float gGain = 1.f;                                      // Attenuverter gain multiplier
-        
-        // Determine which modes are active (considering "always on" overrides)
-        bool useSlewAdd = (!gSlew.mode) || slewAddAlwaysOn;     // Use slew-add mode
-        bool useAttv = (gSlew.mode) || attenuverterAlwaysOn;    // Use attenuverter mode
-        
-        if (useSlewAdd) {
-            // Use the banked value for slew-add when knob is currently set to attenuverter
-            float rawSlew = gSlew.mode ? gSlew.a : params[GLOBAL_SLEW_PARAM].getValue();
-            gsecAdd = hi::ui::ExpTimeQuantity::knobToSec(rawSlew); // Convert to seconds
-        }
-        if (useAttv) {
-            float rawAttv = gSlew.mode ? params[GLOBAL_SLEW_PARAM].getValue() : gSlew.b;
-            rawAttv = rack::math::clamp(rawAttv, 0.f, 1.f);     // Safety clamp
-            gGain = -10.f + 20.f * rawAttv;                     // Map to [-10,+10] gain range
+        // Randomizer triggers and clock measurement above stay sample-accurate (edge detectors on
+        // per-sample jacks); the param read, width resolution and control application run once per
+        // block (renderQueuedBlock → processBlock). Lights follow telemetry (~60 Hz).
+        if (fifo.latency > 0) {
+            const int k = fifo.pos;
+            float* q = fifo.in + k * 16;
+            for (int c = 0; c < 16; ++c) q[c] = (c < inCh) ? inVolt(c) : 0.f;
+            fifo.inCh[k] = inCh;                                        // 0 = unpatched
+            outputs[OUT_OUTPUT].setChannels(fifo.outCh[k]);
+            for (int c = 0; c < fifo.outCh[k]; ++c) outputs[OUT_OUTPUT].setVoltage(fifo.out[k * 16 + c], c);
+            if (++fifo.pos == fifo.latency) {
+                renderQueuedBlock(args.sampleTime);
+                fifo.pos = 0;
+            }
+            publishTelemetry(args.sampleRate);
+            feedChain();
+            return;
         }
-        
+
         // ───────────────────────────────────────────────────────────────────────────────────────────────
-        // Offset Control Processing: Global and Range Offsets from Dual-Mode Banks
+        // Signal Chain: Targets → Strum → Slew → Range → Quantizer → Output Clip → Poly Fade
         // ───────────────────────────────────────────────────────────────────────────────────────────────
-        float rangeOffset = 0.f;                               // Applied AFTER range, BEFORE quantizer
-        float globalOffset = 0.f;                              // Applied with per-channel offsets
-        bool useRangeOff = gOffset.mode || rangeOffsetAlwaysOn; // Use range offset mode
-        bool useGlobOff = (!gOffset.mode) || globalOffsetAlwaysOn; // Use global offset mode
-        
-        if (useRangeOff) {
-            float v = gOffset.mode ? params[GLOBAL_OFFSET_PARAM].getValue() : gOffset.b;
-            rangeOffset = clamp(v, -5.f, 5.f);                 // Range offset: ±5V limit
-        }
-        if (useGlobOff) {
-            float v = gOffset.mode ? gOffset.a : params[GLOBAL_OFFSET_PARAM].getValue();
-            globalOffset = clamp(v, -10.f, 10.f);              // Global offset: ±10V limit
+        float inArr[16] = {0};                                          // Input voltages (mono inputs feed every voice)
+        for (int c = 0; c < inCh; ++c) inArr[c] = inVolt(c);
+        int32_t chainSteps[16];
+        if (chainIn && chainIn->plan) {                                 // Upstream snapped: render() may adopt its steps
+            hi::dsp::chain::expandSteps(*chainIn, chainSteps);
+            chainStep = chainSteps; chainPlan = chainIn->plan;
         }
-        
-        // Pre-range limiter/scaler lambda: operates around 0V only; offset is applied after this
-        auto preRange = [&](float v) -> float {
-            return hi::dsp::range::apply(v, rangeMode == 0 ? hi::dsp::range::Mode::Clip : hi::dsp::range::Mode::Scale, clipLimit, softClipOut);
-        };
-
-        // ═══════════════════════════════════════════════════════════════════════════
-        // MAIN DSP PROCESSING - Two-Pass Algorithm for Slew and Quantization
-        // ═══════════════════════════════════════════════════════════════════════════
-        
-        bool modeChanged = (pitchSafeGlide != prevPitchSafeGlide);     // Detect pitch-safe mode changes
-        float outVals[16] = {0};                                       // Final output values per channel
-        
-        // ───────────────────────────────────────────────────────────────────────────────────────────────
-        // Pass 1: Compute Target Values and Detect Step Changes for Strum Timing
-        // ───────────────────────────────────────────────────────────────────────────────────────────────
-        float targetArr[16] = {0};                                     // Target values after processing
-        float aerrNArr[16] = {0};                                      // Normalized step error for strum
-        int signArr[16] = {0};                                         // Step direction for strum ordering
-        bool targetChangedArr[16] = {false};                           // Tracks raw target changes for strum detection
-        
-        // Track whether start-delay is active so we tick once per block
-        bool strumTickNeeded = false;
-
-        for (int c = 0; c < polyTrans.curProcN; ++c) {
-            if (strumEnabled && strumType == 1 && strumDelayLeft[c] > 0.f) {
-                strumTickNeeded = true;
-            }
-
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Input Processing: Polyphonic Input Handling and Global Attenuverter
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            float in = 0.f;
-            if (inConn) {
-                if (inCh <= 1) 
-                    in = inputs[IN_INPUT].getVoltage(0);               // Mono input to all channels
-                else if (c < inCh) 
-                    in = inputs[IN_INPUT].getVoltage(c);               // Polyphonic input per channel
-                // Note: channels beyond input count remain at 0V
-            }
-            
-            // Apply global attenuverter (if enabled) to input before offset/slew processing
-            if (useAttv) in *= gGain;                                  // Scale input by attenuverter gain
-            
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Offset Processing: Per-Channel and Global Offset Combination
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            float offCh = params[OFF_PARAM[c]].getValue();             // Per-channel offset knob
-            float offTot = offCh + globalOffset;                       // Combine with global offset
-            
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Offset Quantization: Snap Offsets to Musical Grid (Optional Per-Channel)
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            int qm = snapOffsetModeCh[c];                              // Get offset quantization mode for this channel
-            if (qm == 1) {                                             // Semitone (EDO or TET) quantization
-                int Nsteps = (tuningMode == 0 ? ((edo <= 0) ? 12 : edo) : (tetSteps > 0 ? tetSteps : 9));
-                float period = (tuningMode == 0) ? 1.f : ((tetPeriodOct > 0.f) ? tetPeriodOct : std::log2(3.f/2.f));
-                // Steps per octave (volts) = steps per period divided by period size in octaves
-                float stepsPerOct = (float)Nsteps / period;            // Calculate steps per volt
-                offTot = std::round(offTot * stepsPerOct) / stepsPerOct; // Quantize to nearest semitone
-            } else if (qm == 2) {                                      // Cents (1/1200 V) quantization
-                offTot = std::round(offTot * 1200.f) / 1200.f;         // Quantize to nearest cent
-            }
-            // qm == 0: No offset quantization (free voltage)
-            
-            float target = in + offTot;                                // Calculate initial target value
-            targetArr[c] = target;                                     // Store for later processing
-
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Per-Channel Pre-Range Transform: Apply Scaling and Offset Before Global Range Processing
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            targetArr[c] = targetArr[c] * preScale[c] + preOffset[c];  // Apply per-channel transform
-            float targetProcessed = targetArr[c];                      // Cache processed target for reuse
-
-            // Detect actual target changes for strum handling (skip noise-level moves)
-            bool targetChanged = false;
-            if (strumPrevInit[c]) {
-                targetChanged = std::fabs(targetProcessed - strumPrevTarget[c]) > STRUM_TARGET_TOL;
-            }
-            strumPrevTarget[c] = targetProcessed;                      // Update history for next block
-            strumPrevInit[c] = true;                                   // Mark history initialized
-            targetChangedArr[c] = targetChanged;                       // Remember change flag for assignment
-
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Step Detection: Calculate Error and Direction for Strum Timing
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            float yPrev = lastOut[c];                                  // Previous output value
-            float err = targetProcessed - yPrev;                       // Raw voltage error based on processed target
-            int sign = (err > 0.f) - (err < 0.f);                     // Step direction: +1, 0, or -1
-            float aerrV = std::fabs(err);                              // Absolute error in volts
-            float aerrN = pitchSafeGlide ? hi::dsp::glide::voltsToSemitones(aerrV) : aerrV; // Normalized error
-            signArr[c] = sign;                                         // Store direction for strum ordering
-            aerrNArr[c] = aerrN;                                       // Store normalized error for strum
-        }
-        
-        // ───────────────────────────────────────────────────────────────────────────────────────────────
-        // Strum Delay Assignment: Calculate Per-Channel Timing Offsets for Chord Articulation
-        // ───────────────────────────────────────────────────────────────────────────────────────────────
-        auto assignDelayFor = [&](int ch) {
-            if (!(strumEnabled && strumMs > 0.f && polyTrans.curProcN > 1)) { 
-                strumDelayAssigned[ch] = 0.f; 
-                strumDelayLeft[ch] = 0.f; 
-                return; 
-            }
-            // Convert strum mode to DSP enum
-            hi::dsp::strum::Mode mode = (strumMode == 0 ? hi::dsp::strum::Mode::Up : 
-                                        (strumMode == 1 ? hi::dsp::strum::Mode::Down : 
-                                         hi::dsp::strum::Mode::Random));
-            float tmp[16] = {0};                                       // Temporary delay array
-            hi::dsp::strum::assign(strumMs, polyTrans.curProcN, mode, tmp); // Calculate strum delays
-            strumDelayAssigned[ch] = tmp[ch];                          // Store assigned delay
-            strumDelayLeft[ch] = tmp[ch];                              // Initialize remaining delay
-        };
-        
-        // Trigger strum delay assignment when step changes are detected
-        if (strumEnabled && strumMs > 0.f && polyTrans.curProcN > 1) {
-            for (int c = 0; c < polyTrans.curProcN; ++c) {
-                // Assign new delays when: mode changed, target changed, direction flipped, or step jumped
-                if (modeChanged || targetChangedArr[c] || signArr[c] != stepSign[c] || aerrNArr[c] > stepNorm[c])
-                    assignDelayFor(c);
-            }
-        }
-
-        // ───────────────────────────────────────────────────────────────────────────────────────────────
-        // Pass 2: Apply Slew, Range Processing, and Quantization with Strum Timing
-        // ───────────────────────────────────────────────────────────────────────────────────────────────
-    for (int c = 0; c < polyTrans.curProcN; ++c) {
-            float target = targetArr[c];                               // Get pre-computed target value
-            
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Step Analysis: Recalculate Error and Direction for Current Channel
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            float yPrev = lastOut[c];                                  // Previous output value
-            float err = target - yPrev;                                // Current error
-            float aerrV = std::fabs(err);                              // Absolute error in volts
-            float aerrN = pitchSafeGlide ? hi::dsp::glide::voltsToSemitones(aerrV) : aerrV; // Normalized error
-            int sign = (err > 0.f) - (err < 0.f);                     // Step direction
-
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Slew Rate Calculation: Combine Per-Channel, Global, and Strum Timing
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            float sec = hi::ui::ExpTimeQuantity::knobToSec(params[SL_PARAM[c]].getValue()); // Per-channel slew time
-            float gsec = gsecAdd;                                      // Global slew addition from dual-mode
-            float assignedDelay = (strumEnabled && polyTrans.curProcN > 1) ? strumDelayAssigned[c] : 0.f;
-            
-            if (strumEnabled && strumType == 0) {
-                // Time-stretch mode: add assigned delay to effective glide time
-                sec += gsec + assignedDelay;
-            } else {
-                // Start-delay mode: no time-stretch addition; delay handled separately below
-                sec += gsec;
-            }
-            
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Slew Processing Gate: Check Time Threshold and Per-Channel Enable State
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            bool chSlewDisabled = !slewEnabled[c];                    // Per-channel slew disable flag
-            bool noSlew = (sec <= hconst::MIN_SEC) || chSlewDisabled;  // Skip slew if time too short or disabled
-
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Step Change Detection: Update Tracking State When New Steps Are Detected
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            if (modeChanged || sign != stepSign[c] || aerrN > stepNorm[c]) {
-                stepSign[c] = sign;                                    // Update step direction
-                stepNorm[c] = std::max(aerrN, hconst::EPS_ERR);        // Update step magnitude (with minimum)
-            }
-
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Start Delay Processing: Handle Strum Timing in Start-Delay Mode
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            float yRaw = target;                                       // Initialize with target value
-            bool inStartDelay = (strumEnabled && strumType == 1 && strumDelayLeft[c] > 0.f);
-            if (!inStartDelay && !noSlew && quantizerPos == QuantizerPos::Post) {
-                // Slew BEFORE the quantizer only when the voice is not being held by start-delay
-                float remainingV = aerrV;                              // Distance remaining to target
-                float totalJumpV = remainingV;                         // Total jump distance
-                float baseRateV = totalJumpV / sec;                    // Base rate: equal-time distance over seconds
-                float u = clamp(remainingV / std::max(totalJumpV, hconst::EPS_ERR), 0.f, 1.f); // Progress ratio
-
-                // Apply curve shaping to rise and fall rates
-                float rateRise = baseRateV * hi::dsp::glide::shapeMul(u, riseParams, hconst::EPS_ERR);
-                float rateFall = baseRateV * hi::dsp::glide::shapeMul(u, fallParams, hconst::EPS_ERR);
-
-                // Update slew processor only when rates change significantly (avoid zipper noise)
-                if (std::fabs(rateRise - prevRiseRate[c]) > hconst::RATE_EPS ||
-                    std::fabs(rateFall - prevFallRate[c]) > hconst::RATE_EPS) {
-                    slews[c].setRiseFall(rateRise, rateFall);          // Configure slew processor
-                    prevRiseRate[c] = rateRise;                        // Cache for comparison
-                    prevFallRate[c] = rateFall;                        // Cache for comparison
-                }
-                yRaw = slews[c].process(args.sampleTime, target);      // Apply slew processing
-            }
-
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Pre-Quantization Processing: Range Limiting and Octave Shifting
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            float yPre = preRange(yRaw);                               // Apply pre-quantization range limiting
-            // Apply range offset and octave shift before quantizer to shift whole quantization window
-            float yBasePre = yPre + rangeOffset + (float)postOctShift[c] * 1.f;
-
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            // Quantizer Position Logic: Pre (Q→S) vs Post (S→Q) Processing Order
-            // ───────────────────────────────────────────────────────────────────────────────────────────
-            float yFinal = 0.f;
-            if (quantizerPos == QuantizerPos::Pre) {
-                // ───────────────────────────────────────────────────────────────────────────────────────
-                // Pre-Quantization Mode: Legacy Q→S Order (Quantize → Mix Strength → Slew)
-                // ───────────────────────────────────────────────────────────────────────────────────────
-                float yPreForQ = yBasePre;                             // Input includes range offset & octave shift
-                float yRel = yPreForQ - rangeOffset;                   // Remove range offset for quantizer
-                float yQRel = yRel;                                    // Will hold quantized relative volts
-                
-                if (qzEnabled[c]) {
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    // Core Quantizer Configuration: Setup Scale and Tuning Parameters
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    hi::dsp::QuantConfig qc;
-                    if (tuningMode == 0) { 
-                        qc.edo = (edo <= 0) ? 12 : edo; 
-                        qc.periodOct = 1.f; 
-                    } else { 
-                        qc.edo = tetSteps > 0 ? tetSteps : 9; 
-                        qc.periodOct = (tetPeriodOct > 0.f) ? tetPeriodOct : std::log2(3.f/2.f); 
-                    }
-                    qc.root = rootNote; 
-                    qc.useCustom = useCustomScale; 
-                    qc.scaleIndex = scaleIndex; 
-                    if (qc.useCustom) { 
-                        if ((int)customMaskGeneric.size() == qc.edo) { 
-                            qc.customMaskGeneric = customMaskGeneric.data(); 
-                            qc.customMaskLen = (int)customMaskGeneric.size(); 
-                        } 
-                    }
-                    
-                    // Detect quantizer configuration changes and reset latched state
-                    bool cfgChanged = (prevRootNote != rootNote || prevScaleIndex != scaleIndex || 
-                                      prevEdo != qc.edo || prevTetSteps != tetSteps || 
-                                      prevTetPeriodOct != qc.periodOct || prevTuningMode != tuningMode || 
-                                      prevUseCustomScale != useCustomScale); 
-                    if (cfgChanged) { 
-                        for (int k = 0; k < 16; ++k) latchedInit[k] = false; // Reset all channels
-                        prevRootNote = rootNote; prevScaleIndex = scaleIndex; prevEdo = qc.edo; 
-                        prevTetSteps = tetSteps; prevTetPeriodOct = qc.periodOct; prevTuningMode = tuningMode; 
-                    }
-                    
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    // Step Calculation and Latched State Initialization
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    int N = qc.edo; 
-                    float period = qc.periodOct;
-                    double fs = (double)yRel * (double)N / (double)period; // Convert voltage to fractional steps
-                    
-                    if (!latchedInit[c]) {
-                        latchedStep[c] = hi::dsp::nearestAllowedStep((int)std::round(fs), (float)fs, qc);
-                        lastFs[c] = fs;                                // Seed direction state with current fs
-                        lastDir[c] = 0;                                // Start neutral so peaks don't mis-set direction
-                        latchedInit[c] = true;
-                    }
-                    
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    // Directional Snap: Hysteresis-Based Quantization with Direction Memory
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    int baseStep = (int)std::round(fs);                // Default for non-directional modes
-                    int dir = 0;                                       // Direction state for Directional Snap
-                    
-                    if (quantRoundMode == 0) {                         // Directional Snap mode
-                        float Hc = rack::clamp(stickinessCents, 0.f, 20.f); // Hysteresis in cents
-                        const float maxAllowed = 0.4f * 1200.f * (period / (float)N); // Maximum reasonable hysteresis
-                        if (Hc > maxAllowed) Hc = maxAllowed;          // Clamp to reasonable range
-                        float Hs = (Hc * (float)N) / 1200.0f;         // Convert cents to steps
-                        float Hd = std::max(0.75f * Hs, 0.02f);       // Widen direction hysteresis slightly
-                        double d = fs - lastFs[c];                     // Calculate step delta
-                        dir = lastDir[c];                              // Get previous direction
-                        if (d > +Hd) dir = +1;                        // Moving up beyond hysteresis
-                        else if (d < -Hd) dir = -1;                   // Moving down beyond hysteresis
-                        // else: stay in current direction (hysteresis)
-                        
-                        if (dir > 0)      baseStep = (int)std::ceil(fs);  // Round up when moving up
-                        else if (dir < 0) baseStep = (int)std::floor(fs); // Round down when moving down
-                        else              baseStep = latchedStep[c];       // Hold candidate at peak/valley
-                        lastDir[c] = dir;                              // Update direction state
-                        lastFs[c] = fs;                                // Update position state
-                    }
-                    
-                    // Ensure latched step is valid in current scale
-                    if (!hi::dsp::isAllowedStep(latchedStep[c], qc)) { 
-                        latchedStep[c] = hi::dsp::nearestAllowedStep(latchedStep[c], (float)fs, qc); 
-                    }
-                    
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    // Target Step Selection: Directional vs Standard Quantization
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    int targetStep;
-                    if (quantRoundMode == 0) {                         // Directional Snap mode
-                        int candidate = latchedStep[c];                // Start with current latched step
-                        if (dir > 0)      
-                            candidate = hi::dsp::nextAllowedStep(latchedStep[c], +1, qc); // Move to next higher allowed step
-                        else if (dir < 0) 
-                            candidate = hi::dsp::nextAllowedStep(latchedStep[c], -1, qc); // Move to next lower allowed step
-                        // dir == 0: hold candidate at current latched step
-                        targetStep = candidate;
-                    } else {
-                        // Standard quantization modes: nearest, up, down
-                        targetStep = hi::dsp::nearestAllowedStep(baseStep, (float)fs, qc);
-                    }
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    // Schmitt Latch Logic: Center-Anchored Hysteresis for Stable Quantization
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    float Hc = rack::clamp(stickinessCents, 0.f, 20.f);    // Hysteresis in cents
-                    float stepCents = 1200.f * (period / (float)N);        // Cents per step in current tuning
-                    const float maxAllowed = 0.4f * stepCents;             // Maximum reasonable hysteresis (40% of step)
-                    if (Hc > maxAllowed) Hc = maxAllowed;                  // Clamp to prevent excessive hysteresis
-                    float Hs = (Hc * (float)N) / 1200.0f;                 // Convert cents to steps
-                    float d = (float)(fs - (double)latchedStep[c]);        // Distance from latched center (in steps)
-                    float upThresh = +0.5f + Hs;                           // Upper switching threshold
-                    float downThresh = -0.5f - Hs;                         // Lower switching threshold
-                    
-                    // Switch latched step only when crossing thresholds and only by ±1 step
-                    if (targetStep > latchedStep[c] && d > upThresh) 
-                        latchedStep[c] = latchedStep[c] + 1;               // Move up one step
-                    else if (targetStep < latchedStep[c] && d < downThresh) 
-                        latchedStep[c] = latchedStep[c] - 1;               // Move down one step
-                    // else: hold at latchedStep[c] (within hysteresis zone)
-                    
-                    // Convert final latched step back to voltage with scale snapping
-                    yQRel = hi::dsp::snapEDO((latchedStep[c] / (float)N) * period, qc, 10.f, false, 0);
-                    
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    // Advanced Rounding Mode Processing: Directional Nudging and Scale-Aware Selection
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    if (quantRoundMode != 1) {
-                        // Step-aware rounding: derive the active tuning's volts-per-step so nudges follow the scale grid
-                        const float rawStepVolts = (N > 0 && period > 0.f)
-                                                     ? (period / static_cast<float>(N))
-                                                     : 0.f;
-                        const float voltsPerStep = (rawStepVolts > 0.f) ? rawStepVolts : (1.f / 12.f);
-                        const float nudgeVolts = voltsPerStep * 0.51f;          // Match legacy 51% bias, but scale by tuning
-                        const float stepTolVolts = std::max(1e-5f, voltsPerStep * 1e-3f); // ~0.1% of a step for hysteresis
-                        const float stepTolSteps = stepTolVolts / voltsPerStep;
-                        const float diffVolts = yRel - yQRel;
-                        const float diffSteps = diffVolts / voltsPerStep;
-                        float prev = prevYRel[c];
-                        float dir = (yRel > prev + 1e-6f) ? 1.f : (yRel < prev - 1e-6f ? -1.f : 0.f);
-                        int slopeDir = (dir > 0.f) ? +1 : (dir < 0.f ? -1 : 0);
-
-                        // Map quantization mode to DSP rounding mode
-                        hi::dsp::RoundMode rm = (quantRoundMode == 0 ? hi::dsp::RoundMode::Directional :
-                                                (quantRoundMode == 2 ? hi::dsp::RoundMode::Ceil :
-                                                (quantRoundMode == 3 ? hi::dsp::RoundMode::Floor : hi::dsp::RoundMode::Nearest)));
-                        hi::dsp::RoundPolicy rp{rm};
-                        (void)hi::dsp::pickRoundingTarget(0, diffSteps, (int)slopeDir, rp);
-
-                        // Apply directional nudging based on rounding mode (step thresholds follow tuning scale)
-                        if (rm == hi::dsp::RoundMode::Directional) {
-                            if (slopeDir > 0 && diffSteps > 0.f) {
-                                float nudged = quantizeToScale(yQRel + nudgeVolts, 0, clipLimit, true);
-                                if (nudged > yQRel + stepTolVolts) yQRel = nudged;
-                            } else if (slopeDir < 0 && diffSteps < 0.f) {
-                                float nudged = quantizeToScale(yQRel - nudgeVolts, 0, clipLimit, true);
-                                if (nudged < yQRel - stepTolVolts) yQRel = nudged;
-                            }
-                        } else if (rm == hi::dsp::RoundMode::Ceil) {
-                            if (diffSteps > stepTolSteps) {
-                                float nudged = quantizeToScale(yQRel + nudgeVolts, 0, clipLimit, true);
-                                if (nudged > yQRel + stepTolVolts) yQRel = nudged;
-                            }
-                        } else if (rm == hi::dsp::RoundMode::Floor) {
-                            if (diffSteps < -stepTolSteps) {
-                                float nudged = quantizeToScale(yQRel - nudgeVolts, 0, clipLimit, true);
-                                if (nudged < yQRel - stepTolVolts) yQRel = nudged;
-                            }
-                        }
-                        prevYRel[c] = yRel;                                // Update previous value for direction tracking
-                    } else { 
-                        prevYRel[c] = yRel;                                // Update previous value even when not processing
-                    }
-                } else { 
-                    prevYRel[c] = yRel;                                    // Update previous value when quantizer disabled
-                }
-                
-                // ───────────────────────────────────────────────────────────────────────────────────────
-                // Quantization Strength Blending: Mix Raw and Quantized Signals
-                // ───────────────────────────────────────────────────────────────────────────────────────
-                float yQAbs = yQRel + rangeOffset;                         // Add range offset back to quantized signal
-                float t = clamp(quantStrength, 0.f, 1.f);                  // Quantization strength (0=raw, 1=quantized)
-                float yMix = yPreForQ + (yQAbs - yPreForQ) * t;            // Blend raw (yPreForQ) and quantized signals
-                
-                // ───────────────────────────────────────────────────────────────────────────────────────
-                // Post-Quantization Slew Processing (Pre Mode): Apply Slew AFTER Quantization
-                // ───────────────────────────────────────────────────────────────────────────────────────
-                float yPost = yMix;                                        // Initialize with blended value
-                if (!noSlew && !inStartDelay) {
-                    // Calculate shape-aware slew rates targeting the quantized blend
-                    float remainingV = std::fabs(yMix - lastOut[c]);       // Distance to blended target
-                    float totalJumpV = remainingV;                         // Total jump distance
-                    float baseRateV = totalJumpV / sec;                    // Base rate: distance over time
-                    float u = clamp(remainingV / std::max(totalJumpV, hconst::EPS_ERR), 0.f, 1.f); // Progress ratio
-                    
-                    // Apply curve shaping to rise and fall rates
-                    float rateRise = baseRateV * hi::dsp::glide::shapeMul(u, riseParams, hconst::EPS_ERR);
-                    float rateFall = baseRateV * hi::dsp::glide::shapeMul(u, fallParams, hconst::EPS_ERR);
-                    
-                    // Update slew processor only when rates change significantly
-                    if (std::fabs(rateRise - prevRiseRate[c]) > hconst::RATE_EPS || 
-                        std::fabs(rateFall - prevFallRate[c]) > hconst::RATE_EPS) { 
-                        slews[c].setRiseFall(rateRise, rateFall); 
-                        prevRiseRate[c] = rateRise; 
-                        prevFallRate[c] = rateFall; 
-                    }
-                    yPost = slews[c].process(args.sampleTime, yMix);   // Apply slew to blended signal
-                }
-                yFinal = yPost;                                            // Set final output for Pre mode
-            } else {
-                // ───────────────────────────────────────────────────────────────────────────────────────
-                // Post-Quantization Mode: S→Q Order (Slew → Quantize for Pitch Stability)
-                // ───────────────────────────────────────────────────────────────────────────────────────
-                float ySlewed = yPre + rangeOffset + (float)postOctShift[c] * 1.f; // Apply range offset and octave shift
-                float yRel = (ySlewed - rangeOffset);                      // Remove range offset for quantizer input
-                float yOutQuant = ySlewed;                                 // Will hold final blended result
-                
-                if (qzEnabled[c]) {
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    // Post-Mode Quantizer Logic: Operating on Already-Slewed Signal
-                    // ───────────────────────────────────────────────────────────────────────────────────
-                    hi::dsp::QuantConfig qc;
-                    if (tuningMode == 0) { 
-                        qc.edo = (edo <= 0) ? 12 : edo; 
-                        qc.periodOct = 1.f; 
-                    } else { 
-                        qc.edo = tetSteps > 0 ? tetSteps : 9; 
-                        qc.periodOct = (tetPeriodOct > 0.f) ? tetPeriodOct : std::log2(3.f/2.f); 
-                    }
-                    qc.root = rootNote; 
-                    qc.useCustom = useCustomScale; 
-                    qc.customFollowsRoot = true;                           // Always follow root in Post mode
-                    qc.scaleIndex = scaleIndex;
-                    if (qc.useCustom) {
-                        if ((int)customMaskGeneric.size() == qc.edo) { 
-                            qc.customMaskGeneric = customMaskGeneric.data(); 
-                            qc.customMaskLen = (int)customMaskGeneric.size(); 
-                        }
-                    }
-                    
-                    // Configuration change detection and state management
-                    int N = qc.edo; 
-                    float period = qc.periodOct; 
-                    bool cfgChanged = (prevRootNote != rootNote || prevScaleIndex != scaleIndex || 
-                                      prevEdo != qc.edo || prevTetSteps != tetSteps || 
-                                      prevTetPeriodOct != qc.periodOct || prevTuningMode != tuningMode || 
-                                      prevUseCustomScale != useCustomScale); 
-                    if (cfgChanged) { 
-                        for (int k = 0; k < 16; ++k) latchedInit[k] = false; // Reset all channels
-                        prevRootNote = rootNote; prevScaleIndex = scaleIndex; prevEdo = qc.edo; 
-                        prevTetSteps = tetSteps; prevTetPeriodOct = qc.periodOct; prevTuningMode = tuningMode; 
-                    }
-                    
-                    // Step calculation and latched state initialization
-                    float fs = yRel * (float)N / period;                   // Convert voltage to fractional steps
-                    if (!latchedInit[c]) { 
-                        latchedStep[c] = hi::dsp::nearestAllowedStep((int)std::round(fs), fs, qc); 
-                        latchedInit[c] = true; 
-                    } 
-                    if (!hi::dsp::isAllowedStep(latchedStep[c], qc)) { 
-                        latchedStep[c] = hi::dsp::nearestAllowedStep(latchedStep[c], fs, qc); 
-                    }
-                    // Hysteresis-based Schmitt latch for stable quantization
-                    float dV = period / (float)N;                          // Voltage per step
-                    float stepCents = 1200.f * dV;                         // Cents per step
-                    float Hc = rack::clamp(stickinessCents, 0.f, 20.f);    // Clamp hysteresis to reasonable range
-                    float maxAllowed = 0.4f * stepCents;                   // Maximum hysteresis (40% of step size)
-                    if (Hc > maxAllowed) Hc = maxAllowed;                  // Prevent excessive hysteresis
-                    float H_V = Hc / 1200.f;                               // Convert cents to voltage
-                    
-                    // Calculate adjacent allowed steps for hysteresis boundaries
-                    int upStep = hi::dsp::nextAllowedStep(latchedStep[c], +1, qc);
-                    int dnStep = hi::dsp::nextAllowedStep(latchedStep[c], -1, qc);
-                    float center = (latchedStep[c] / (float)N) * period;   // Current step voltage
-                    float vUp = (upStep / (float)N) * period;              // Next step up voltage
-                    
-                    // Compute hysteresis thresholds around current step
-                    hi::dsp::HystSpec hs{ (vUp - center) * 2.f, H_V };
-                    auto th = hi::dsp::computeHysteresis(center, hs);
-                    float T_up = th.up;                                    // Upper threshold
-                    float T_down = th.down;                                // Lower threshold
-                    
-                    // Apply Schmitt latch logic for step transitions
-                    if (yRel >= T_up && upStep != latchedStep[c]) 
-                        latchedStep[c] = upStep;
-                    else if (yRel <= T_down && dnStep != latchedStep[c]) 
-                        latchedStep[c] = dnStep;
-                    
-                    // Snap to exact quantized voltage for current latched step
-                    float yqRel = hi::dsp::snapEDO((latchedStep[c] / (float)N) * period, qc, 10.f, false, 0);
-                    // Advanced rounding modes for fine-tuned quantization behavior
-                    if (quantRoundMode != 1) { 
-                        float rawSemi = yRel * 12.f;                           // Raw signal in semitones
-                        float snappedSemi = yqRel * 12.f;                      // Quantized signal in semitones
-                        float diff = rawSemi - snappedSemi;                    // Difference for rounding decisions
-                        float prev = prevYRel[c];                              // Previous voltage for direction detection
-                        float dir = (yRel > prev + 1e-6f) ? 1.f : (yRel < prev - 1e-6f ? -1.f : 0.f);
-                        int slopeDir = (dir > 0.f) ? +1 : (dir < 0.f ? -1 : 0); // Direction: +1=up, -1=down, 0=static
-                        
-                        // Map quantRoundMode to DSP rounding mode
-                        hi::dsp::RoundMode rm = (quantRoundMode == 0 ? hi::dsp::RoundMode::Directional : 
-                                               (quantRoundMode == 2 ? hi::dsp::RoundMode::Ceil : 
-                                               (quantRoundMode == 3 ? hi::dsp::RoundMode::Floor : 
-                                                                     hi::dsp::RoundMode::Nearest)));
-                        hi::dsp::RoundPolicy rp{rm};
-                        float posWithin = diff;
-                        (void)hi::dsp::pickRoundingTarget(0, posWithin, slopeDir, rp); 
-                        
-                        // Scale-aware directional selection (replaces chromatic nudging)
-                        if (rm == hi::dsp::RoundMode::Directional && std::fabs(diff) > 1e-5f) { 
-                            int targetStep = (slopeDir > 0) ? hi::dsp::nextAllowedStep(latchedStep[c], +1, qc) : 
-                                                             hi::dsp::nextAllowedStep(latchedStep[c], -1, qc); 
-                            if (targetStep != latchedStep[c]) { 
-                                float targetV = (targetStep / (float)N) * period; 
-                                yqRel = targetV; 
-                            } 
-                        } else if (rm == hi::dsp::RoundMode::Ceil && diff > 1e-5f) { 
-                            int targetStep = hi::dsp::nextAllowedStep(latchedStep[c], +1, qc); 
-                            if (targetStep != latchedStep[c]) { 
-                                float targetV = (targetStep / (float)N) * period; 
-                                yqRel = targetV; 
-                            } 
-                        } else if (rm == hi::dsp::RoundMode::Floor && diff < -1e-5f) { 
-                            int targetStep = hi::dsp::nextAllowedStep(latchedStep[c], -1, qc); 
-                            if (targetStep != latchedStep[c]) { 
-                                float targetV = (targetStep / (float)N) * period; 
-                                yqRel = targetV; 
-                            } 
-                        }
-                        prevYRel[c] = (ySlewed - rangeOffset);                 // Track pre-quant slew for direction
-                    } else {
-                        prevYRel[c] = (ySlewed - rangeOffset);                 // Standard nearest mode tracking
-                    }
-                    // Quantization strength blending (Post mode)
-                    float yq = yqRel + rangeOffset;                        // Add range offset back to quantized signal
-                    float t = clamp(quantStrength, 0.f, 1.f);              // Clamp blend factor to valid range
-                    yOutQuant = ySlewed + (yq - ySlewed) * t;              // Blend: raw slewed + (quantized - raw) * strength
-                    // Note: In Post mode, raw signal is ySlewed (already processed through slew)
-                } else {
-                    prevYRel[c] = (ySlewed - rangeOffset);                 // Track voltage for next frame
-                }
-                float yPost = yOutQuant;                               // Final quantized output (already slewed)
-                yFinal = yPost;                                        // Set as final channel output
-            }
-
-            // ───────────────────────────────────────────────────────────────────────────────────────
-            // Final Output Processing and Channel State Updates
-            // ───────────────────────────────────────────────────────────────────────────────────────
-            // Note: Strength crossfade raw source varies by mode:
-            // - Pre mode uses yPre (yPreForQ) as raw signal for blending
-            // - Post mode uses ySlewed as raw signal for blending
-            
-            // Apply output voltage limiting with soft or hard clipping
-            // Hold the previously latched output while start-delay counts down so the quantizer
-            // can still track the incoming gesture (prevents Directional Snap from chasing late).
-            float yOut = inStartDelay ? yPrev : yFinal;
-
-            if (softClipOut)
-                yOut = hi::dsp::clip::soft(yOut, hconst::MAX_VOLT_CLAMP);  // Smooth saturation curve
-            else
-                yOut = clamp(yOut, -hconst::MAX_VOLT_CLAMP, hconst::MAX_VOLT_CLAMP); // Hard limiting
-
-            outVals[c] = yOut;                                         // Store final output for this channel
-            lastOut[c] = yOut;                                         // Update last output for next frame
-            hi::ui::led::setBipolar(lights[CH_LIGHT + 2*c + 0], lights[CH_LIGHT + 2*c + 1], yOut, args.sampleTime);
-        }
-
-        // Advance strum countdowns after processing when any voice is still delaying
-        if (strumTickNeeded) {
-            hi::dsp::strum::tickStartDelays((float)args.sampleTime, polyTrans.curProcN, strumDelayLeft);
-        }
-
-    // ───────────────────────────────────────────────────────────────────────────────────────
-    // Polyphonic Output Processing with Fade Management
-    // ───────────────────────────────────────────────────────────────────────────────────────
-    // Apply polyphony transition ramp for pop-free fade during channel count changes
-    float ramp = clamp(polyTrans.polyRamp, 0.f, 1.f);                 // Get current fade ramp (0=silent, 1=full)
-    
-    if (sumToMonoOut) {
-        // Sum all active channels to single mono output
-        float sum = 0.f;
-        for (int c = 0; c < polyTrans.curProcN; ++c) 
-            sum += outVals[c];                                         // Accumulate all channel outputs
-        if (avgWhenSumming && polyTrans.curProcN > 0) 
-            sum /= (float)polyTrans.curProcN;                         // Average instead of sum if enabled
-        outputs[OUT_OUTPUT].setVoltage(clamp(sum * ramp, -hconst::MAX_VOLT_CLAMP, hconst::MAX_VOLT_CLAMP), 0);
-    } else {
-        // Standard polyphonic output - each channel gets its own output
-        for (int c = 0; c < polyTrans.curProcN; ++c) 
-            outputs[OUT_OUTPUT].setVoltage(outVals[c] * ramp, c);     // Apply fade ramp to each channel
-    }
-
-    // ───────────────────────────────────────────────────────────────────────────────────────
-    // LED Management and Cleanup
-    // ───────────────────────────────────────────────────────────────────────────────────────
-    // Clear LEDs for inactive channels to prevent visual artifacts
-    for (int c = polyTrans.curProcN; c < 16; ++c) {
-        lights[CH_LIGHT + 2*c + 0].setBrightness(0.f);               // Clear positive LED
-        lights[CH_LIGHT + 2*c + 1].setBrightness(0.f);               // Clear negative LED
-    }
-
-    // ───────────────────────────────────────────────────────────────────────────────────────
-    // Polyphony Transition State Machine
-    // ───────────────────────────────────────────────────────────────────────────────────────
-    // Handle fade phase progression at the end of processing block
-    if (polyTrans.transPhase == TRANS_FADE_OUT) {
-        if (polyFadeSec <= 0.f) {                                     // Instant fade (no time specified)
-            polyTrans.polyRamp = 0.f;                                 // Set ramp to silent immediately
-        } else {
-            // Gradual fade-out over specified time period
-            polyTrans.polyRamp = std::max(0.f, polyTrans.polyRamp - (float)args.sampleTime / polyFadeSec);
-        }
-        if (polyTrans.polyRamp <= 0.f + 1e-6f) {
-            // Fade-out complete - switch to new channel configuration while silent
-            polyTrans.curProcN = polyTrans.pendingProcN;              // Update processing channel count
-            polyTrans.curOutN  = polyTrans.pendingOutN;               // Update output channel count
-            outputs[OUT_OUTPUT].setChannels(polyTrans.curOutN);       // Set VCV Rack output channels
-            polyTrans.initToTargetsOnSwitch = true;                   // Flag for target reinitialization
-            polyTrans.transPhase = TRANS_FADE_IN;                     // Begin fade-in phase
-            // Prepare to fade in with new channel configuration
-        }
-    } else if (polyTrans.transPhase == TRANS_FADE_IN) {
-        // Fade-in phase: reinitialize targets and gradually increase volume
-        if (polyTrans.initToTargetsOnSwitch) {
-            // Recompute target voltages with current settings to avoid output jumps
-            for (int c = 0; c < polyTrans.curProcN; ++c) {
-                // Recreate minimal target calculation (input + offsets), matching main processing
-                float in = 0.f;
-                    // Get input voltage for this channel
-                if (inConn) {
-                    if (inCh <= 1) 
-                        in = inputs[IN_INPUT].getVoltage(0);              // Mono input
-                    else if (c < inCh) 
-                        in = inputs[IN_INPUT].getVoltage(c);              // Polyphonic input
-                }
-                
-                // Apply global attenuverter/gain if enabled
-                if ((params[GLOBAL_SLEW_MODE_PARAM].getValue() > 0.5f) || attenuverterAlwaysOn) {
-                    float rawAttv = gSlew.mode ? params[GLOBAL_SLEW_PARAM].getValue() : gSlew.b;
-                    rawAttv = rack::math::clamp(rawAttv, 0.f, 1.f);       // Clamp to valid range
-                    float gGain2 = -10.f + 20.f * rawAttv;               // Map to -10V to +10V gain
-                    in *= gGain2;                                         // Apply gain to input
-                }
-                
-                // Calculate total offset (per-channel + global)
-                float offCh = params[OFF_PARAM[c]].getValue();            // Per-channel offset
-                float offTot = offCh + (gOffset.mode ? gOffset.a : params[GLOBAL_OFFSET_PARAM].getValue());
-                
-                // Apply offset quantization if enabled
-                int qm = snapOffsetModeCh[c];                             // Offset snap mode for this channel
-                if (qm == 1) {                                            // Snap to scale steps
-                    int Nsteps = (tuningMode == 0 ? ((edo <= 0) ? 12 : edo) : (tetSteps > 0 ? tetSteps : 9));
-                    float period = (tuningMode == 0) ? 1.f : ((tetPeriodOct > 0.f) ? tetPeriodOct : std::log2(3.f/2.f));
-                    float stepsPerOct = (float)Nsteps / period;           // Steps per octave
-                    offTot = std::round(offTot * stepsPerOct) / stepsPerOct; // Quantize to scale steps
-                } else if (qm == 2) {                                     // Snap to cents
-                    offTot = std::round(offTot * 1200.f) / 1200.f;        // Quantize to cent boundaries
-                }
-                
-                float target = in + offTot;                               // Calculate target voltage
-
-                // ────────────────────────────────────────────────────────────────────────────────
-                // Per-Channel Pre-Range Transform Application
-                // ────────────────────────────────────────────────────────────────────────────────
-                // Apply per-channel scaling and offset during fade reinitialization
-                target = target * preScale[c] + preOffset[c];             // Scale and offset transform
-
-                // Initialize slew processors and output states to current targets
-                lastOut[c] = target;                                      // Set last output to target
-                slews[c].reset();                                         // Reset slew processor state
-                strumPrevTarget[c] = target;                              // Seed strum change detector with current target
-                strumPrevInit[c] = true;                                  // Mark detector initialized after poly switch
-            }
-            polyTrans.initToTargetsOnSwitch = false;                      // Clear reinitialization flag
-            polyTrans.polyRamp = 0.f;                                    // Start from silence
-        }
-        
-        // ───────────────────────────────────────────────────────────────────────────────────────
-        // Fade-In Progression
-        // ───────────────────────────────────────────────────────────────────────────────────────
-        if (polyFadeSec <= 0.f) {                                        // Instant fade-in
-            polyTrans.polyRamp = 1.f;                                    // Set ramp to full volume
-        } else {
-            // Gradual fade-in over specified time period
-            polyTrans.polyRamp = std::min(1.f, polyTrans.polyRamp + (float)args.sampleTime / polyFadeSec);
-        }
-        if (polyTrans.polyRamp >= 1.f - 1e-6f) {
-            polyTrans.polyRamp = 1.f;                                     // Ensure exact 1.0 when complete
-            polyTrans.transPhase = TRANS_STABLE;                          // Transition to stable state
-        }
-    } else {
-        // ───────────────────────────────────────────────────────────────────────────────────────
-        // Stable State - No Polyphony Transition Active
-        // ───────────────────────────────────────────────────────────────────────────────────────
-        polyTrans.polyRamp = 1.f;                                        // Keep ramp at full volume
-    }
-
-    // ───────────────────────────────────────────────────────────────────────────────────────
-    // Process Method State Preservation
-    // ───────────────────────────────────────────────────────────────────────────────────────
-    prevPitchSafeGlide = pitchSafeGlide;                                 // Remember mode for next frame
-    }
-};
+        float outArr[16];
+        const int outN = render(inArr, inCh, inConn, ctlW, args.sampleTime, outArr);
+        chainStep = nullptr; chainPlan = nullptr;
+        for (int c = 0; c < outN; ++c) outputs[OUT_OUTPUT].setVoltage(outArr[c], c);
+        outputs[OUT_OUTPUT].setChannels(polyTrans.curOutN);             // A completed fade-out switches width
+        publishTelemetry(args.sampleRate);                              // ~60 Hz: cents readouts and lights
+        feedChain();                                                    // Right PolyQuanta reads it next sample
+    }
+};
 
 // ═════════════════════════════════════════════════════════════════════════════════════════
 // CoreState Glue Helper Definitions
@@ -3101,6 +2364,7 @@ static void applyCoreStateToModule(const hi::dsp::CoreState& cs, PolyQuanta& m)
     // ───────────────────────────────────────────────────────────────────────────────────────
     m.useCustomScale = cs.useCustomScale;                            // Restore custom scale mode
     m.customMaskGeneric = cs.customMaskGeneric;                      // Restore custom scale mask (vector copy)
+    m.invalidateMOSCache();                                          // Mask replaced wholesale
     
     // ───────────────────────────────────────────────────────────────────────────────────────
     // Per-Channel Settings Restoration
@@ -3190,6 +2454,7 @@ namespace hi { namespace music { namespace mos {
      */
     void buildMaskFromCycle(PolyQuanta* mod, int N, const std::vector<int>& pcs){
         if(!mod || N <= 0) return;                                    // Validate inputs
+        mod->invalidateMOSCache();                                    // Bulk edit: drop the packed mirror
         
         // Initialize mask for all EDO sizes using unified vector system
         mod->customMaskGeneric.assign(N, 0);                          // Clear mask array
@@ -3225,7 +2490,17 @@ namespace hi { namespace music { namespace mos {
         // ───────────────────────────────────────────────────────────────────────────────────────
         // Cache Management for Performance Optimization
         // ───────────────────────────────────────────────────────────────────────────────────────
-        uint64_t h = mod->hashMask(N);                                   // Generate hash of current mask
+        if((int)mod->customMaskGeneric.size() != N) {                    // Unsized mask: nothing to analyze
+            mod->mosCache.valid = false;
+            return false;
+        }
+        hi::music::analysis::Result r;                                   // Worker's answer, when it is current
+        if(mod->analysisResult(r)){
+            if(r.mos){ mOut = r.mosM; gOut = r.mosG; }
+            return r.mos;
+        }
+        const MaskState& ms = mod->syncedMask(N);                        // O(1) after single-degree toggles
+        uint64_t h = ms.hash;                                            // Zobrist hash of current mask
         bool keyMatch = mod->mosCache.valid &&
             mod->mosCache.N == N &&
             mod->mosCache.tuningMode == mod->tuningMode &&
@@ -3261,54 +2536,16 @@ namespace hi { namespace music { namespace mos {
         if(!mod->useCustomScale){ return false; }                       // Only analyze custom scales
         
         // ───────────────────────────────────────────────────────────────────────────────────────
-        // Pitch Class Collection and Validation
-        // ───────────────────────────────────────────────────────────────────────────────────────
-        std::vector<int> pcs;                                            // Pitch class collection
-        pcs.reserve(32);                                                 // Reserve space for efficiency
-        
-        // Extract pitch classes from appropriate mask based on tuning system
-        // Extract pitch classes from unified vector mask
-        if((int)mod->customMaskGeneric.size() != N) return false;        // Validate mask size
-        for(int i = 0; i < N; ++i) 
-            if(mod->customMaskGeneric[(size_t)i]) pcs.push_back(i);      // Extract from mask
-        
-        // Validate pitch class count (must be reasonable for MOS detection)
-        if(pcs.size() < 2 || pcs.size() > 24) return false;
-        
-        // ───────────────────────────────────────────────────────────────────────────────────────
-        // Scale Normalization for MOS Analysis
+        // MOS Pattern Detection (packed mirror + shared memo, see mos::detect)
         // ───────────────────────────────────────────────────────────────────────────────────────
-        int rotateBy = 0;                                                // Root-relative scales need no rotation
-
-        // Apply rotation (no-op) and clean up duplicates
-        for(int& p : pcs){ p = (p + rotateBy) % N; }                    // Rotate each pitch class
-
-        std::sort(pcs.begin(), pcs.end());                              // Sort for analysis
-        pcs.erase(std::unique(pcs.begin(), pcs.end()), pcs.end());     // Remove duplicates
-        if(pcs.size() < 2 || pcs.size() > 24) return false;            // Revalidate after cleanup
-        
-        // ───────────────────────────────────────────────────────────────────────────────────────
-        // MOS Pattern Detection Algorithm
-        // ───────────────────────────────────────────────────────────────────────────────────────
-        int m = (int)pcs.size();                                         // Number of scale steps
-        
-        // Test all possible coprime generators for MOS pattern
-        for(int g = 1; g < N; ++g){
-            if(gcdInt(g, N) != 1) continue;                              // Skip non-coprime generators
-            auto cyc = generateCycle(N, g, m);                           // Generate cycle with this generator
-            if((int)cyc.size() != m) continue;                           // Skip if wrong size
-            if(cyc == pcs){
-                // Found matching MOS pattern - cache and return results
-                mod->mosCache.found = true; 
-                mod->mosCache.m = m; 
-                mod->mosCache.g = g;
-                mOut = m; 
-                gOut = g; 
-                return true;
-            }
-        }
-        // No MOS pattern found - return false (cache already updated)
-        return false;
+        int m = 0, g = 0;
+        if(!detect(ms, N, m, g)) return false;                            // Cache already updated
+        mod->mosCache.found = true; 
+        mod->mosCache.m = m; 
+        mod->mosCache.g = g;
+        mOut = m; 
+        gOut = g; 
+        return true;
     }
 } } }
 
@@ -3326,34 +2563,14 @@ namespace hi { namespace music { namespace scale {
         
         int N = (int)mask1.size();
         
-        // Normalize both masks to canonical form (root at position 0)
-        auto normalizeMask = [N](const std::vector<uint8_t>& mask) -> std::vector<uint8_t> {
-            std::vector<uint8_t> normalized(N, 0);
-            
-            // Find the first active note (root) in the mask
-            int rootOffset = 0;
-            for (int i = 0; i < N; ++i) {
-                if (mask[i] != 0) {
-                    rootOffset = i;
-                    break;
-                }
-            }
-            
-            // Rotate the mask so that the root is at position 0
-            for (int i = 0; i < N; ++i) {
-                int sourceIndex = (i + rootOffset) % N;
-                normalized[i] = mask[sourceIndex];
-            }
-            
-            return normalized;
+        // Root = first active note; compare both masks rotated to their roots in place (no copies)
+        auto rootOf = [N](const std::vector<uint8_t>& mask) {
+            for (int i = 0; i < N; ++i) if (mask[i] != 0) return i;
+            return 0;
         };
-        
-        std::vector<uint8_t> norm1 = normalizeMask(mask1);
-        std::vector<uint8_t> norm2 = normalizeMask(mask2);
-        
-        // Compare normalized masks
+        const int r1 = rootOf(mask1), r2 = rootOf(mask2);
         for (int i = 0; i < N; ++i) {
-            if (norm1[i] != norm2[i]) {
+            if (mask1[(i + r1) % N] != mask2[(i + r2) % N]) {
                 return false;
             }
         }
@@ -3370,20 +2587,9 @@ namespace hi { namespace music { namespace scale {
     const Scale* detectMatchingScale(const std::vector<uint8_t>& customMask, int edo) {
         if (customMask.empty() || edo < 1 || edo > 120) return nullptr;
         
-        // Get the predefined scales for this EDO
-        const Scale* scales = scalesEDO(edo);
-        int numScales = numScalesEDO(edo);
-        
-        if (!scales || numScales <= 0) return nullptr;
-        
-        // Check each predefined scale for a match
-        for (int i = 0; i < numScales; ++i) {
-            if (masksEqual(customMask, scales[i].mask)) {
-                return &scales[i];
-            }
-        }
-        
-        return nullptr;
+        // Hash lookup on the root-rotated mask (same match rule as masksEqual)
+        int idx = findScaleIndex(customMask, edo);
+        return idx >= 0 ? &scalesEDO(edo)[idx] : nullptr;
     }
 } } }
 
@@ -3837,6 +3043,9 @@ struct PolyQuantaWidget : ModuleWidget {
             PolyQuanta* mod = nullptr;                                   // Module reference
             int ch = 0;                                                  // Channel index
             std::shared_ptr<Font> font;                                  // Font for text rendering
+            uint32_t seenVersion = ~0u;                                  // Telemetry frame the text was built from
+            int shownCentiCents = INT32_MIN;                             // Displayed value in 1/100 cent (INT32_MIN = "—")
+            std::string txt = "—";                                       // Cached label, rebuilt only on change
             
             /**
              * @brief Constructor - sets up display widget positioning and module reference
@@ -3871,19 +3080,21 @@ struct PolyQuantaWidget : ModuleWidget {
                 NVGcolor col = nvgRGB(220, 220, 220);                    // Light gray text
                 nvgFillColor(args.vg, col);
                 
-                std::string txt = "—";                                   // Default inactive display
-                if (mod) {
-                    // Only show cents value when channel is active
-                    int activeN = std::max(0, mod->polyTrans.curProcN);
-                    if (ch < activeN) {
-                        float v = mod->lastOut[ch];                      // Get channel output voltage
-                        float cents = v * 1200.f;                       // Convert to cents (1V = 1200 cents)
-                        
-                        // Round to 2 decimal places and clamp to practical bounds
-                        cents = std::round(cents * 100.f) / 100.f;
-                        if (cents > 12000.f) cents = 12000.f;           // Clamp to ±10V equivalent
-                        else if (cents < -12000.f) cents = -12000.f;
-                        txt = rack::string::f("%+.2f¢", cents);         // Format with 2 decimals and sign
+                // Refresh from the latest telemetry frame; reformat only when the shown value changes
+                if (mod && mod->telemetry.version() != seenVersion) {
+                    hi::dsp::telemetry::Frame f;
+                    if (mod->telemetry.read(f)) {
+                        seenVersion = mod->telemetry.version();
+                        int cc = INT32_MIN;                              // Inactive channel
+                        if (ch < std::max(0, f.activeN)) {
+                            float cents = f.volts[ch] * 1200.f;         // Convert to cents (1V = 1200 cents)
+                            // Round to 2 decimal places and clamp to practical bounds (±10V equivalent)
+                            cc = (int)std::lround(rack::clamp(cents, -12000.f, 12000.f) * 100.f);
+                        }
+                        if (cc != shownCentiCents) {
+                            shownCentiCents = cc;
+                            txt = (cc == INT32_MIN) ? "—" : rack::string::f("%+.2f¢", cc / 100.f); // Format with 2 decimals and sign
+                        }
                     }
                 }
                 // Render the text centered in the widget
@@ -3990,6 +3201,16 @@ struct PolyQuantaWidget : ModuleWidget {
     // - Strum effects with timing, behavior, direction, and spread controls
     // ═════════════════════════════════════════════════════════════════════════════════════════
 
+        /**
+         * @brief Per-frame UI update: hands menu edits of the tuning/scale fields to the audio thread
+         * @note One snapshot per frame at most, so a multi-step edit is never seen half-done
+         */
+        void step() override {
+            if (auto* m = dynamic_cast<PolyQuanta*>(module))
+                if (m->publishTuning()) m->requestAnalysis();                // Tuning edited: re-analyze off-thread
+            ModuleWidget::step();
+        }
+
         /**
          * @brief Builds the main module context menu with organized sections
          * @param menu Pointer to the menu being constructed
@@ -4058,6 +3279,10 @@ struct PolyQuantaWidget : ModuleWidget {
             hi::ui::menu::addBoolPtr(menu, "Sum to mono (post‑slew)", &m->sumToMonoOut);
             hi::ui::menu::addBoolPtr(menu, "Average when summing", &m->avgWhenSumming, [m]{ return m->sumToMonoOut; });
             hi::ui::menu::addBoolPtr(menu, "Soft clip (range + final)", &m->softClipOut);
+            // Expander chaining: a PolyQuanta directly to the left feeds this one without a cable
+            hi::ui::menu::addBoolPtr(menu, "Chain input from left PolyQuanta", &m->chainFromLeft);
+            // Smaller patch files: packed per-channel keys and base64 masks (builds without schema 2 load defaults for those)
+            hi::ui::menu::addBoolPtr(menu, "Compact patch storage", &m->compactPatch);
             
             // ───────────────────────────────────────────────────────────────────────────────────────
             // Range Level Configuration (Peak-to-Peak Voltage)
@@ -4085,6 +3310,55 @@ struct PolyQuantaWidget : ModuleWidget {
                     [m]{ return m->rangeMode == 1; }, 
                     [m]{ m->rangeMode = 1; }));
             }));
+            
+            // ───────────────────────────────────────────────────────────────────────────────────────
+            // Control Rate Configuration (CPU vs Knob Response)
+            // ───────────────────────────────────────────────────────────────────────────────────────
+            // Knob-derived values are evaluated once per block; larger blocks save CPU in big patches
+            menu->addChild(rack::createSubmenuItem("Control rate", "", [m](rack::ui::Menu* sm){
+                for (int d : hi::dsp::ctlrate::kDivs) {
+                    std::string label = (d == 1) ? "Every sample (default)" : rack::string::f("Every %d samples", d);
+                    sm->addChild(rack::createCheckMenuItem(label, "", 
+                        [m, d]{ return m->controlRateDiv == d; }, 
+                        [m, d]{ m->controlRateDiv = d; }));                // advanceControl() wraps the phase on the audio thread
+                }
+                sm->addChild(new MenuSeparator);
+                hi::ui::menu::addBoolPtr(sm, "Smooth offsets/gain between blocks", &m->controlRateSmooth, [m]{ return m->controlRateDiv > 1; });
+            }));
+            // Block latency trades output delay for CPU: the chain renders 16/64 frames per call
+            menu->addChild(rack::createSubmenuItem("Block latency", "", [m](rack::ui::Menu* sm){
+                for (int l : hi::dsp::blockio::kLatencies) {
+                    std::string label = (l == 0) ? "None (default)" : rack::string::f("%d samples", l);
+                    sm->addChild(rack::createCheckMenuItem(label, "",
+                        [m, l]{ return m->blockLatency == l; },
+                        [m, l]{ m->blockLatency = l; }));
+                }
+            }));
+            // Hot-path counters (builds with -DHI_DIAGNOSTICS only; see hi::dsp::diag)
+            if (hi::dsp::diag::kEnabled) {
+                menu->addChild(rack::createSubmenuItem("Diagnostics", "", [m](rack::ui::Menu* sm){
+                    namespace dg = hi::dsp::diag;
+                    const float sr = std::max(1.f, m->rndSampleRate);
+                    const uint64_t calls = m->diag.get(dg::ProcessCalls);
+                    const double secs = (double)calls / (double)sr;
+                    auto perSec = [&](dg::Counter k) { return secs > 0.0 ? (double)m->diag.get(k) / secs : 0.0; };
+                    sm->addChild(rack::createMenuLabel(rack::string::f("%.1f %s / process()", calls ? (double)m->diag.get(dg::ProcessTicks) / (double)calls : 0.0, dg::kTickUnit)));
+                    sm->addChild(rack::createMenuLabel(rack::string::f("Snaps: %.1f /s", perSec(dg::Snaps))));
+                    sm->addChild(rack::createMenuLabel(rack::string::f("Nudges: %.1f /s", perSec(dg::Nudges))));
+                    sm->addChild(rack::createMenuLabel(rack::string::f("Strum reassignments: %.1f /s", perSec(dg::StrumAssigns))));
+                    sm->addChild(rack::createMenuLabel(rack::string::f("Relatches: %llu", (unsigned long long)m->diag.get(dg::Relatches))));
+                    sm->addChild(rack::createMenuLabel(rack::string::f("Poly transitions: %llu", (unsigned long long)m->diag.get(dg::PolyTransitions))));
+                    sm->addChild(rack::createMenuLabel(rack::string::f("Idle voice-samples: %.0f%%", calls ? 100.0 * (double)m->diag.get(dg::Settled) / ((double)calls * std::max(1, m->polyTrans.curProcN)) : 0.0)));
+                    sm->addChild(new MenuSeparator);
+                    sm->addChild(rack::createMenuItem("Reset counters", "", [m]{ m->diag.reset(); }));
+                    sm->addChild(rack::createMenuItem("Dump to user folder", "", [m]{
+                        char buf[1024];
+                        dg::formatReport(m->diag, m->rndSampleRate, buf, sizeof(buf));
+                        std::ofstream f(PanelExport::userDir() + "/PolyQuanta-diagnostics.txt", std::ios::binary);
+                        if (f) f << buf;
+                    }));
+                }));
+            }
             // ───────────────────────────────────────────────────────────────────────────────────────
             // Controls Section - Module Configuration and Utility Functions
             // ───────────────────────────────────────────────────────────────────────────────────────
@@ -4098,6 +3372,16 @@ struct PolyQuantaWidget : ModuleWidget {
                 // Delegated to extracted implementation for maintainability
                 PanelExport::exportPanelSnapshot(this, "PolyQuanta", "res/PolyQuanta.svg");
             }));
+            // Batch export: snapshot + overlay per module, written on worker threads (see PanelExport::Batch)
+            const PanelExport::Batch* batch = PanelExport::batch();
+            if (batch && !batch->finished()) {
+                menu->addChild(rack::createMenuLabel(rack::string::f("Exporting panels… %d/%d", batch->done(), batch->total())));
+            } else {
+                menu->addChild(rack::createSubmenuItem("Export all panels (user folder)", "", [](rack::ui::Menu* sm){
+                    sm->addChild(rack::createMenuItem("FUNmodules in this patch", "", []{ PanelExport::startBatch(PanelExport::capturePatch()); }));
+                    sm->addChild(rack::createMenuItem("Every FUNmodules model", "", []{ PanelExport::startBatch(PanelExport::captureModels()); }));
+                }));
+            }
             
             // ───────────────────────────────────────────────────────────────────────────────────────
             // Randomization Scope Controls
@@ -4108,6 +3392,17 @@ struct PolyQuantaWidget : ModuleWidget {
                 sm->addChild(rack::createBoolPtrMenuItem("Offsets", "", &m->randOffset));
                 sm->addChild(rack::createBoolPtrMenuItem("Shapes", "", &m->randShapes));
             }));
+            // Morph time: randomized knobs glide to their new values instead of jumping
+            menu->addChild(rack::createSubmenuItem("Randomize Morph", "", [m](rack::ui::Menu* sm){
+                for (float t : hi::dsp::morph::kTimesSec) {
+                    std::string label = (t == 0.f) ? "Off (jump)"
+                                      : (t < 1.f) ? rack::string::f("%d ms", (int)std::lround(t * 1000.f))
+                                                  : rack::string::f("%g s", t);
+                    sm->addChild(rack::createCheckMenuItem(label, "",
+                        [m, t]{ return m->rndMorphSec == t; },
+                        [m, t]{ m->rndMorphSec = t; }));
+                }
+            }));
 
             // ───────────────────────────────────────────────────────────────────────────────────────
             // Quantization Section - Musical Scale Processing Configuration
@@ -4199,7 +3494,7 @@ struct PolyQuantaWidget : ModuleWidget {
                     scaleStr = hi::music::scales24EDO()[idx].name;
                 } else if (m->useCustomScale) {
                     // Custom scale - try to detect if it matches a predefined scale
-                    const hi::music::Scale* matchingScale = hi::music::scale::detectMatchingScale(m->customMaskGeneric, steps);
+                    const hi::music::Scale* matchingScale = m->matchingScale();
                     if (matchingScale) {
                         scaleStr = matchingScale->name;
                     } else {
@@ -4241,7 +3536,7 @@ struct PolyQuantaWidget : ModuleWidget {
                 // Display comprehensive quantization status
                 menu->addChild(rack::createMenuLabel(rack::string::f(
                     "Status: %s %d, Root %s, Scale %s%s, Strength %d%%, Round %s, Stickiness %.1f¢ (max %.0f¢)",
-                    (m->tuningMode == 0 ? "EDO" : "TET"), steps, rootStr.c_str(), scaleStr.c_str(), mosStr.c_str(), pct,
+                    (m->tuningMode == 0 ? "EDO" : (m->tuningMode == 2 ? "Scala" : "TET")), steps, rootStr.c_str(), scaleStr.c_str(), mosStr.c_str(), pct,
                     roundStr, m->stickinessCents, maxStick)));
             }
             
@@ -4255,6 +3550,25 @@ struct PolyQuantaWidget : ModuleWidget {
                 sm->addChild(rack::createCheckMenuItem("TET (non-octave)", "", 
                     [m]{ return m->tuningMode == 1; }, 
                     [m]{ m->tuningMode = 1; m->invalidateMOSCache(); }));
+                // Scala: exact (e.g. just) tunings from .scl files, optionally anchored by a .kbm
+                sm->addChild(new MenuSeparator);
+                sm->addChild(rack::createCheckMenuItem(
+                    m->scalaName.empty() ? std::string("Scala (no scale loaded)") : "Scala: " + m->scalaName, "",
+                    [m]{ return m->tuningMode == 2; },
+                    [m]{ m->loadScala(m->scalaScl, m->scalaKbm, true); }, m->scalaScl.empty()));
+                sm->addChild(rack::createMenuItem("Load Scala scale (.scl)…", "", [m]{
+                    const std::string scl = PolyQuanta::pickScalaFile("Scala scale (.scl):scl");
+                    if (!scl.empty()) m->loadScala(scl, m->scalaKbm, true);
+                }));
+                sm->addChild(rack::createMenuItem("Load keyboard map (.kbm)…", "", [m]{
+                    const std::string kbm = PolyQuanta::pickScalaFile("Scala keyboard map (.kbm):kbm");
+                    if (!kbm.empty()) m->loadScala(m->scalaScl, kbm, true);
+                }, m->scalaScl.empty()));
+                sm->addChild(rack::createMenuItem("Clear keyboard map", "", [m]{
+                    m->loadScala(m->scalaScl, "", true);
+                }, m->scalaKbm.empty()));
+                if (!m->scalaError.empty())
+                    sm->addChild(rack::createMenuLabel("Scala load failed: " + m->scalaError));
             }));
             // ───────────────────────────────────────────────────────────────────────────────────────
             // EDO (Equal Division of Octave) Selection Menu
@@ -4435,49 +3749,12 @@ struct PolyQuantaWidget : ModuleWidget {
                 // ───────────────────────────────────────────────────────────────────────────────────────
                 // Root Note Range Helper Function
                 // ───────────────────────────────────────────────────────────────────────────────────────
-                // Capture N and period by value so submenu population works after lambda returns
+                // Labels (12-EDO pitch-class mapping) come from the per-module cache; a page's items
+                // are created only when its submenu opens
                 auto addRange = [m, N, period](rack::ui::Menu* menuDest, int start, int end){
-                    static const char* noteNames[12] = {"C","C#","D","D#","E","F","F#","G","G#","A","A#","B"};
+                    const std::vector<std::string>& labels = m->menuLabels.roots(m->tuningMode, N, period);
                     for (int n = start; n <= end && n < N; ++n) {
-                        // ───────────────────────────────────────────────────────────────────────────────────────
-                        // Pitch-Class Mapping and Label Generation
-                        // ───────────────────────────────────────────────────────────────────────────────────────
-                        float semis = (float)n * 12.f * period / (float)N;         // Convert to semitones
-                        int nearestPc = (int)std::round(semis);                     // Nearest 12-EDO pitch class
-                        float delta = semis - (float)nearestPc;                     // Deviation from 12-EDO
-                        float err = std::fabs(delta);                               // Absolute error
-                        
-                        // Determine if this step exactly matches a 12-EDO pitch class
-                        bool exact = false;
-                        if (m->tuningMode == 0 && (N % 12) == 0) {
-                            // For EDO systems divisible by 12, check exact alignment
-                            int stepPerSemi = N / 12;
-                            exact = (n % stepPerSemi) == 0;
-                        } else {
-                            // For other systems, use floating-point tolerance
-                            exact = err <= 1e-6f;
-                        }
-                        
-                        // Generate appropriate label based on pitch-class proximity
-                        int pc12 = ((nearestPc % 12) + 12) % 12;
-                        std::string label;
-                        if (exact) {
-                            // Exact match: show step number and note name
-                            label = rack::string::f("%d (%s)", n, noteNames[pc12]);
-                        } else if (err <= 0.05f) {
-                            // Close approximation: show cents deviation
-                            int cents = (int)std::round(delta * 100.f);
-                            if (cents != 0) 
-                                label = rack::string::f("%d (≈%s %+d¢)", n, noteNames[pc12], cents);
-                            else 
-                                label = rack::string::f("%d (≈%s)", n, noteNames[pc12]);
-                        } else {
-                            // Distant approximation: show only step number
-                            label = rack::string::f("%d", n);
-                        }
-                        
-                        // Create menu item for this root note option
-                        menuDest->addChild(rack::createCheckMenuItem(label, "", 
+                        menuDest->addChild(rack::createCheckMenuItem(labels[(size_t)n], "", 
                             [m, n]{ return m->rootNote == n; }, 
                             [m, n]{ m->rootNote = n; m->invalidateMOSCache(); }));
                     }
@@ -4486,34 +3763,15 @@ struct PolyQuantaWidget : ModuleWidget {
                 // ───────────────────────────────────────────────────────────────────────────────────────
                 // Root Note Range Organization
                 // ───────────────────────────────────────────────────────────────────────────────────────
-                if (N > 72) {
-                    // For large tuning systems, split into thirds with remainder distribution
-                    int base = N / 3;
-                    int rem = N % 3;
-                    int size1 = base + (rem > 0 ? 1 : 0);
-                    int size2 = base + (rem > 1 ? 1 : 0);
-                    // Third size is implied by remainder; no variable needed
-                    int s1 = 0;            int e1 = size1 - 1;
-                    int s2 = e1 + 1;       int e2 = s2 + size2 - 1;
-                    int s3 = e2 + 1;       int e3 = N - 1;
-                    sm->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", s1, e1), "", 
-                        [addRange, s1, e1](rack::ui::Menu* sm2){ addRange(sm2, s1, e1); }));
-                    sm->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", s2, e2), "", 
-                        [addRange, s2, e2](rack::ui::Menu* sm2){ addRange(sm2, s2, e2); }));
-                    sm->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", s3, e3), "", 
-                        [addRange, s3, e3](rack::ui::Menu* sm2){ addRange(sm2, s3, e3); }));
-                } else if (N > 36) {
-                    // For medium systems, split into halves (lower gets extra when odd)
-                    int halfLo = (N % 2 == 1) ? ((N + 1) / 2) : (N / 2);
-                    int loStart = 0;           int loEnd = halfLo - 1;
-                    int hiStart = halfLo;      int hiEnd = N - 1;
-                    sm->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", loStart, loEnd), "", 
-                        [addRange, loStart, loEnd](rack::ui::Menu* sm2){ addRange(sm2, loStart, loEnd); }));
-                    sm->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", hiStart, hiEnd), "", 
-                        [addRange, hiStart, hiEnd](rack::ui::Menu* sm2){ addRange(sm2, hiStart, hiEnd); }));
+                const hi::ui::labels::Pages pages = hi::ui::labels::split(N);
+                if (pages.count == 1) {
+                    addRange(sm, 0, N-1);                                       // Small systems: all roots directly
                 } else {
-                    // For small systems, show all root notes directly
-                    addRange(sm, 0, N-1);
+                    for (int k = 0; k < pages.count; ++k) {
+                        const int first = pages.lo[k], last = pages.hi[k];
+                        sm->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", first, last), "", 
+                            [addRange, first, last](rack::ui::Menu* sm2){ addRange(sm2, first, last); }));
+                    }
                 }
             }));
             
@@ -4548,19 +3806,30 @@ struct PolyQuantaWidget : ModuleWidget {
                 // Helper function to add scale submenu with checkmarks for matching scales
                 auto addScaleSubmenu = [&](const char* category, const hi::music::Scale* scales, int count) {
                     sm->addChild(rack::createSubmenuItem(category, "", [m, scales, count, selectPresetScale](rack::ui::Menu* smScales) {
-                        for (int i = 0; i < count; ++i) {
-                            // Check if this scale matches the current custom scale
-                            bool isMatching = false;
-                            if (m->useCustomScale) {
-                                const hi::music::Scale* matchingScale = hi::music::scale::detectMatchingScale(m->customMaskGeneric, m->tuningMode == 0 ? m->edo : m->tetSteps);
-                                isMatching = (matchingScale == &scales[i]);
+                        // Presets first..last; the current custom scale is detected once per page, not once per item
+                        auto addRange = [m, scales, count, selectPresetScale](rack::ui::Menu* dst, int first, int last) {
+                            const hi::music::Scale* matchingScale = m->useCustomScale ? m->matchingScale() : nullptr;
+                            for (int i = first; i <= last; ++i) {
+                                // Check if this scale matches the current custom scale
+                                bool isMatching = (matchingScale == &scales[i]);
+                                
+                                dst->addChild(rack::createCheckMenuItem(scales[i].name, "", 
+                                    [isMatching]{ return isMatching; },
+                                    [scales, i, count, selectPresetScale]{
+                                        selectPresetScale(scales, i, count);
+                                    }));
+                            }
+                        };
+                        // Long lists (12-EDO has 50+) are paged like roots and degrees (1-based numbering)
+                        const hi::ui::labels::Pages pages = hi::ui::labels::split(count);
+                        if (pages.count == 1) {
+                            addRange(smScales, 0, count - 1);
+                        } else {
+                            for (int k = 0; k < pages.count; ++k) {
+                                const int first = pages.lo[k], last = pages.hi[k];
+                                smScales->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", first + 1, last + 1), "",
+                                    [addRange, first, last](rack::ui::Menu* sm2){ addRange(sm2, first, last); }));
                             }
-                            
-                            smScales->addChild(rack::createCheckMenuItem(scales[i].name, "", 
-                                [isMatching]{ return isMatching; },
-                                [scales, i, count, selectPresetScale]{
-                                    selectPresetScale(scales, i, count);
-                                }));
                         }
                     }));
                 };
@@ -4610,7 +3879,42 @@ struct PolyQuantaWidget : ModuleWidget {
                         addScaleSubmenu("Experimental", hi::music::scalesEDO(steps), hi::music::numScalesEDO(steps));
                     }
                 }
-                
+
+                // Binary scale packs (.pqsp) registered at startup: one submenu per pack with
+                // scales for the current EDO. Masks are root-relative, like the presets above.
+                {
+                    int N = (m->tuningMode == 0 ? m->edo : m->tetSteps);
+                    if (N <= 0) N = 12;
+                    const auto& packs = hi::music::scalepack::registry();
+                    bool any = false;
+                    for (const auto& pk : packs)
+                        for (uint32_t i = 0; i < pk.view.count() && !any; ++i) any = (pk.view.at(i).edo == N);
+                    if (any) sm->addChild(rack::createSubmenuItem("Scale packs", "", [m, N](rack::ui::Menu* smPacks) {
+                        for (const auto& pk : hi::music::scalepack::registry()) {
+                            const hi::music::scalepack::View* v = &pk.view;
+                            bool has = false;
+                            for (uint32_t i = 0; i < v->count() && !has; ++i) has = (v->at(i).edo == N);
+                            if (!has) continue;
+                            smPacks->addChild(rack::createSubmenuItem(rack::system::getStem(pk.path), "", [m, N, v](rack::ui::Menu* smPack) {
+                                for (uint32_t i = 0; i < v->count(); ++i) {
+                                    const hi::music::ScaleBits b = v->at(i);
+                                    if (b.edo != N) continue;
+                                    bool isCurrent = m->useCustomScale && (int)m->customMaskGeneric.size() == N;
+                                    for (int d = 0; d < N && isCurrent; ++d) isCurrent = ((m->customMaskGeneric[(size_t)d] != 0) == b.test(d));
+                                    smPack->addChild(rack::createCheckMenuItem(b.name[0] ? b.name : "(unnamed)", "",
+                                        [isCurrent]{ return isCurrent; },
+                                        [m, N, b]{
+                                            m->customMaskGeneric.assign((size_t)N, 0);
+                                            for (int d = 0; d < N; ++d) m->customMaskGeneric[(size_t)d] = b.test(d) ? 1 : 0;
+                                            m->useCustomScale = true;
+                                            m->invalidateMOSCache();
+                                        }));
+                                }
+                            }));
+                        }
+                    }));
+                }
+
                 // MOS (Moment of Symmetry) Presets
                     sm->addChild(rack::createSubmenuItem("MOS presets (current EDO)", "", [m](rack::ui::Menu* smMos){
                     int N = (m->tuningMode == 0 ? m->edo : m->tetSteps);
@@ -4625,20 +3929,21 @@ struct PolyQuantaWidget : ModuleWidget {
                             std::string genLabel = rack::string::f("Generator %d", g);
                             smMos->addChild(rack::createSubmenuItem(genLabel, "", [m, N, g](rack::ui::Menu* smGen){
                                 // Find the best generator for 7-note scales as reference
-                                int bestGen = hi::music::mos::findBestGenerator(N, 7);
+                                hi::music::analysis::Result r;
+                                int bestGen = (m->analysisResult(r) && r.N == N) ? r.bestGen : hi::music::mos::findBestGenerator(N, 7);
                                 
-                                // Try different mode sizes (5-9 notes)
+                                // Try different mode sizes (5-9 notes); cycles and patterns come from the shared memo
                                 for (int modeSize = 5; modeSize <= 9; modeSize++) {
-                                    auto cyc = hi::music::mos::generateCycle(N, g, modeSize);
-                                    if (cyc.size() >= 2 && hi::music::mos::isMOS(cyc, N)) {
-                                        std::string pattern = hi::music::mos::patternLS(cyc, N);
+                                    const hi::music::mos::memo::Entry* e = hi::music::mos::memo::get(N, modeSize);
+                                    std::vector<int> cyc = e ? e->pcs(g) : hi::music::mos::generateCycle(N, g, modeSize);
+                                    if (cyc.size() >= 2 && (e ? e->mos[(size_t)g] : hi::music::mos::isMOS(cyc, N))) {
+                                        std::string pattern = e ? e->pattern(g) : hi::music::mos::patternLS(cyc, N);
                                         bool isBest = (g == bestGen && modeSize == 7);
                                         std::string label = rack::string::f("%d-note (%s)%s", 
                                             modeSize, pattern.c_str(), isBest ? " ★" : "");
                                         
-                                        smGen->addChild(rack::createMenuItem(label, "", [m, N, g, modeSize]{
-                                            // Generate MOS scale with this generator and mode size
-                                            auto cyc = hi::music::mos::generateCycle(N, g, modeSize);
+                                        smGen->addChild(rack::createMenuItem(label, "", [m, N, cyc]{
+                                            // Apply the MOS scale with this generator and mode size
                                             if (cyc.size() >= 2) {
                                                 // Convert to custom mask (stored in root-relative space)
                                                 m->customMaskGeneric.assign((size_t)N, 0);
@@ -4752,7 +4057,7 @@ struct PolyQuantaWidget : ModuleWidget {
                         }));
                     }
                     
-                // Individual Degree Editor with proper division
+                // Individual Degree Editor, paged like the root list; labels come from the cache
                 sm->addChild(rack::createSubmenuItem("Degrees", "", [m, getCurrentMask, setCurrentMask](rack::ui::Menu* smDeg){
                     int N = (m->tuningMode == 0 ? m->edo : m->tetSteps);
                     if (N <= 0) N = 12;
@@ -4763,171 +4068,30 @@ struct PolyQuantaWidget : ModuleWidget {
                         setCurrentMask(mask);
                     }
                     
-                    // Helper function to get note name for degree
-                    auto getNoteName = [](int deg, int root, int N, int displayIndex) -> std::string {
-                        const char* noteNames[] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
-                        // Calculate the actual pitch class relative to root
-                        int actualPC = (deg + root) % N;
-                        // Convert to 12-EDO equivalent for display
-                        float note12Float = (actualPC * 12.0f) / N;
-                        int note12 = (int)std::round(note12Float);
-                        if (note12 < 0) note12 += 12;
-                        note12 = note12 % 12;
-                        
-                        // Calculate cents deviation from 12-EDO
-                        float cents = (note12Float - note12) * 100.0f;
-                        if (cents > 50.0f) cents -= 100.0f;
-                        if (cents < -50.0f) cents += 100.0f;
-                        
-                        // Only show notes within ±5 cents of 12-EDO
-                        if (std::abs(cents) <= 5.0f) {
-                            if (std::abs(cents) < 0.1f) {
-                                return rack::string::f("%d (%s)", displayIndex + 1, noteNames[note12]);
-                            } else {
-                                return rack::string::f("%d (%s %+.0f¢)", displayIndex + 1, noteNames[note12], cents);
-                            }
-                        } else {
-                            // Show as microtonal degree without note name
-                            return rack::string::f("%d", displayIndex + 1);
+                    // Items for mask bits first..last (root-rotated labels, displayIndex relative to the page)
+                    auto addRange = [m, N, getCurrentMask](rack::ui::Menu* dst, int first, int last){
+                        auto mask = getCurrentMask();
+                        const std::vector<std::string>& labels = m->menuLabels.degrees(N, m->rootNote);
+                        for (int i = first; i <= last; ++i) {
+                            bool enabled = (i < (int)mask.size()) ? mask[i] : false;
+                            dst->addChild(rack::createCheckMenuItem(labels[(size_t)i], "", 
+                                [enabled]{ return enabled; }, 
+                                [m, N, i]{
+                                    m->toggleMaskDegree(N, i);                   // O(1) MOS mirror update
+                                }));
                         }
                     };
                     
-                    // Apply proper degree division logic
-                    if (N > 72) {
-                        // For large tuning systems, split into thirds with remainder distribution
-                        int base = N / 3;
-                        int rem = N % 3;
-                        int size1 = base + (rem > 0 ? 1 : 0);
-                        int size2 = base + (rem > 1 ? 1 : 0);
-                        int s1 = 0;            int e1 = size1 - 1;
-                        int s2 = e1 + 1;       int e2 = s2 + size2 - 1;
-                        int s3 = e2 + 1;       int e3 = N - 1;
-                        
-                        smDeg->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", s1, e1), "", 
-                            [m, N, getCurrentMask, setCurrentMask, getNoteName, s1, e1](rack::ui::Menu* sm2){
-                                auto mask = getCurrentMask();
-                                for (int i = s1; i <= e1; ++i) {
-                                    int deg = (i - m->rootNote + N) % N; // Rotate degrees so root appears first
-                                    int displayIndex = i - s1; // Display index relative to this submenu
-                                    std::string label = getNoteName(deg, 0, N, displayIndex); // Use 0 as root for display since we already rotated
-                                    bool enabled = (i < (int)mask.size()) ? mask[i] : false;
-                                    
-                                    sm2->addChild(rack::createCheckMenuItem(label, "", 
-                                        [enabled]{ return enabled; }, 
-                                        [i, getCurrentMask, setCurrentMask]{
-                                            auto mask = getCurrentMask();
-                                            if (i < (int)mask.size()) {
-                                                mask[i] = 1 - mask[i]; // toggle
-                                                setCurrentMask(mask);
-                                            }
-                                        }));
-                                }
-                            }));
-                        smDeg->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", s2, e2), "", 
-                            [m, N, getCurrentMask, setCurrentMask, getNoteName, s2, e2](rack::ui::Menu* sm2){
-                                auto mask = getCurrentMask();
-                                for (int i = s2; i <= e2; ++i) {
-                                    int deg = (i - m->rootNote + N) % N; // Rotate degrees so root appears first
-                                    int displayIndex = i - s2; // Display index relative to this submenu
-                                    std::string label = getNoteName(deg, 0, N, displayIndex); // Use 0 as root for display since we already rotated
-                                    bool enabled = (i < (int)mask.size()) ? mask[i] : false;
-                                    
-                                    sm2->addChild(rack::createCheckMenuItem(label, "", 
-                                        [enabled]{ return enabled; }, 
-                                        [i, getCurrentMask, setCurrentMask]{
-                                            auto mask = getCurrentMask();
-                                            if (i < (int)mask.size()) {
-                                                mask[i] = 1 - mask[i]; // toggle
-                                                setCurrentMask(mask);
-                                            }
-                                        }));
-                                }
-                            }));
-                        smDeg->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", s3, e3), "", 
-                            [m, N, getCurrentMask, setCurrentMask, getNoteName, s3, e3](rack::ui::Menu* sm2){
-                                auto mask = getCurrentMask();
-                                for (int i = s3; i <= e3; ++i) {
-                                    int deg = (i - m->rootNote + N) % N; // Rotate degrees so root appears first
-                                    int displayIndex = i - s3; // Display index relative to this submenu
-                                    std::string label = getNoteName(deg, 0, N, displayIndex); // Use 0 as root for display since we already rotated
-                                    bool enabled = (i < (int)mask.size()) ? mask[i] : false;
-                                    
-                                    sm2->addChild(rack::createCheckMenuItem(label, "", 
-                                        [enabled]{ return enabled; }, 
-                                        [i, getCurrentMask, setCurrentMask]{
-                                            auto mask = getCurrentMask();
-                                            if (i < (int)mask.size()) {
-                                                mask[i] = 1 - mask[i]; // toggle
-                                                setCurrentMask(mask);
-                                            }
-                                        }));
-                                }
-                            }));
-                    } else if (N > 36) {
-                        // For medium systems, split into halves (lower gets extra when odd)
-                        int halfLo = (N % 2 == 1) ? ((N + 1) / 2) : (N / 2);
-                        int loStart = 0;           int loEnd = halfLo - 1;
-                        int hiStart = halfLo;      int hiEnd = N - 1;
-                        
-                        smDeg->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", loStart, loEnd), "", 
-                            [m, N, getCurrentMask, setCurrentMask, getNoteName, loStart, loEnd](rack::ui::Menu* sm2){
-                                auto mask = getCurrentMask();
-                                for (int i = loStart; i <= loEnd; ++i) {
-                                    int deg = (i - m->rootNote + N) % N; // Rotate degrees so root appears first
-                                    int displayIndex = i - loStart; // Display index relative to this submenu
-                                    std::string label = getNoteName(deg, 0, N, displayIndex); // Use 0 as root for display since we already rotated
-                                    bool enabled = (i < (int)mask.size()) ? mask[i] : false;
-                                    
-                                    sm2->addChild(rack::createCheckMenuItem(label, "", 
-                                        [enabled]{ return enabled; }, 
-                                        [i, getCurrentMask, setCurrentMask]{
-                                            auto mask = getCurrentMask();
-                                            if (i < (int)mask.size()) {
-                                                mask[i] = 1 - mask[i]; // toggle
-                                                setCurrentMask(mask);
-                                            }
-                                        }));
-                                }
-                            }));
-                        smDeg->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", hiStart, hiEnd), "", 
-                            [m, N, getCurrentMask, setCurrentMask, getNoteName, hiStart, hiEnd](rack::ui::Menu* sm2){
-                                auto mask = getCurrentMask();
-                                for (int i = hiStart; i <= hiEnd; ++i) {
-                                    int deg = (i - m->rootNote + N) % N; // Rotate degrees so root appears first
-                                    int displayIndex = i - hiStart; // Display index relative to this submenu
-                                    std::string label = getNoteName(deg, 0, N, displayIndex); // Use 0 as root for display since we already rotated
-                                    bool enabled = (i < (int)mask.size()) ? mask[i] : false;
-                                    
-                                    sm2->addChild(rack::createCheckMenuItem(label, "", 
-                                        [enabled]{ return enabled; }, 
-                                        [i, getCurrentMask, setCurrentMask]{
-                                            auto mask = getCurrentMask();
-                                            if (i < (int)mask.size()) {
-                                                mask[i] = 1 - mask[i]; // toggle
-                                                setCurrentMask(mask);
-                                            }
-                                        }));
-                                }
-                            }));
+                    const hi::ui::labels::Pages pages = hi::ui::labels::split(N);
+                    if (pages.count == 1) {
+                        addRange(smDeg, 0, N - 1);                               // Small systems: all degrees directly
                     } else {
-                        // For small systems, show all degrees directly
-                        for (int i = 0; i < N; ++i) {
-                            int deg = (i - m->rootNote + N) % N; // Rotate degrees so root appears first
-                            int displayIndex = i; // Display index is just the loop index for small systems
-                            std::string label = getNoteName(deg, 0, N, displayIndex); // Use 0 as root for display since we already rotated
-                            bool enabled = (i < (int)mask.size()) ? mask[i] : false;
-                            
-                            smDeg->addChild(rack::createCheckMenuItem(label, "", 
-                                [enabled]{ return enabled; }, 
-                                [i, getCurrentMask, setCurrentMask]{
-                                    auto mask = getCurrentMask();
-                                    if (i < (int)mask.size()) {
-                                        mask[i] = 1 - mask[i]; // toggle
-                                        setCurrentMask(mask);
-                                    }
-                            }));
+                        for (int k = 0; k < pages.count; ++k) {
+                            const int first = pages.lo[k], last = pages.hi[k];
+                            smDeg->addChild(rack::createSubmenuItem(rack::string::f("%d..%d", first, last), "", 
+                                [addRange, first, last](rack::ui::Menu* sm2){ addRange(sm2, first, last); }));
+                        }
                     }
-                }
                 }));
             }));
             
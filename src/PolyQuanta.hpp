@@ -21,9 +21,19 @@
  #include <rack.hpp> // Include the Rack SDK
 #include "plugin.hpp" // Include the main plugin header which provides access to VCV Rack's Module class and basic types
 #include "core/PolyQuantaCore.hpp" // Core DSP functionality
+#include "core/Lanes.hpp" // 16-lane SoA stages for the per-voice process path
+#include "core/PolyQuantaEngine.hpp" // Rack-independent signal chain and per-voice state (module base class)
 #include "core/ScaleDefs.hpp" // Centralized musical scale definitions
 #include "core/EdoTetPresets.hpp" // Curated presets for Equal Division of Octave (EDO) and Temperament (TET) systems
 #include "core/Strum.hpp" // Strum timing functionality for creating delays between polyphonic channels
+#include "core/Morph.hpp" // Glided randomization targets (randomize morph)
+#include "core/Telemetry.hpp" // Lock-free audio → UI snapshot (cents readouts, lights)
+#include "core/Chain.hpp" // Expander frame between adjacent PolyQuanta modules
+#include "core/Scala.hpp" // Scala .scl/.kbm parsing for the arbitrary-tuning mode
+#include "core/ScalePack.hpp" // Binary scale packs (.pqsp) loaded at startup
+#include "core/MenuLabels.hpp" // Cached root/degree labels and page splits for the context menus
+#include "core/Analysis.hpp" // Background MOS / scale-match analysis shared by all instances
+#include "core/PatchCodec.hpp" // Compact patch schema encodings (base64 masks, packed channel flags)
 #include "core/ui/Quantities.hpp" // UI quantity classes for parameter display and input parsing
 #include "core/ui/MenuHelpers.hpp" // UI menu helper functions for creating consistent context menus
 #include "core/PanelExport.hpp" // Panel export functionality for generating SVG snapshots of the module layout
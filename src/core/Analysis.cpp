@@ -0,0 +1,98 @@
+#include "Analysis.hpp"
+#include "PolyQuantaCore.hpp"
+#include "ScaleDefs.hpp"
+/*
+ * Analysis.cpp — Query hashing, the analysis pass and the worker queue. The
+ * mutex guards only the queue and each client's pending query; analysis runs
+ * outside it, so a submit never waits for a running job.
+ */
+namespace hi { namespace music { namespace analysis {
+uint64_t key(const Query& q) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    auto mix = [&h](uint8_t b) { h = (h ^ b) * 0x100000001b3ull; };
+    for (int i = 0; i < 4; ++i) mix((uint8_t)((uint32_t)q.N >> (8 * i)));
+    mix(q.useCustom ? 1 : 0);
+    for (uint8_t b : q.mask) mix(b ? 1 : 0);
+    return h;
+}
+
+Result analyze(const Query& q) {
+    Result r;
+    r.key = key(q);
+    r.N = q.N;
+    if (q.N < 1) return r;
+    r.bestGen = mos::findBestGenerator(q.N, 7);
+    for (int m = 5; m <= 9 && m <= q.N; ++m) mos::memo::get(q.N, m);   // MOS presets submenu sizes
+    if (!q.useCustom || (int)q.mask.size() != q.N) return r;
+    mos::MaskState ms;
+    if (ms.assign(q.mask.data(), (int)q.mask.size(), q.N)) r.mos = mos::detect(ms, q.N, r.mosM, r.mosG);
+    r.scaleIndex = findScaleIndex(q.mask, q.N);
+    return r;
+}
+
+Worker::Worker(bool threaded) {
+    if (threaded) thread = std::thread([this] { loop(); });
+}
+
+Worker::~Worker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    if (thread.joinable()) thread.join();
+}
+
+void Worker::submit(const std::shared_ptr<Client>& c, Query q) {
+    if (!c) return;
+    const uint64_t k = key(q);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (c->submitted && c->submittedKey == k) return;           // Same analysis already requested
+        c->submitted = true;
+        c->submittedKey = k;
+        c->pending = std::move(q);
+        if (c->queued) return;                                      // Coalesced into the queued job
+        c->queued = true;
+        queue.push_back(c);
+    }
+    wake.notify_one();
+}
+
+bool Worker::runOne() {
+    std::shared_ptr<Client> c;
+    Query q;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) return false;
+        c = std::move(queue.front());
+        queue.pop_front();
+        c->queued = false;
+        q = std::move(c->pending);
+    }
+    const Result r = analyze(q);
+    c->result.publish(r);                                           // Only this thread writes results
+    return true;
+}
+
+size_t Worker::queued() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size();
+}
+
+void Worker::loop() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+        }
+        while (runOne()) {}
+    }
+}
+
+Worker& shared() {
+    static Worker w(true);
+    return w;
+}
+}}} // namespace hi::music::analysis
@@ -0,0 +1,80 @@
+#pragma once
+/*
+ * Analysis.hpp — Background tuning analysis shared by every PolyQuanta
+ * instance: MOS detection of the custom mask, the best 7-note generator for
+ * the MOS presets menu, the matching preset scale, and warming the MOS memo
+ * for the current division so its menus open without filling tables.
+ *
+ * The UI thread submits a Query whenever its tuning snapshot changes. Each
+ * Client holds at most one pending query (a newer submit replaces it), so a
+ * fast tuning sweep costs one analysis per worker wake-up, not one per step.
+ * Results come back through a telemetry::Seqlock: widgets read them without
+ * locking and check Result::key against their current query. The audio thread
+ * never touches any of this.
+ *
+ * Worker(false) has no thread; runOne() then does the work on the caller (the
+ * core tests drive it that way).
+ */
+#include "Telemetry.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hi { namespace music { namespace analysis {
+struct Query {
+    int N = 0;                               // Division count (EDO or TET steps)
+    bool useCustom = false;
+    std::vector<uint8_t> mask;               // Root-relative custom mask (customMaskGeneric)
+};
+
+struct Result {
+    uint64_t key = 0;                        // key() of the query this answers
+    int N = 0;
+    bool mos = false;                        // detectCurrentMOS: mask is an N-step MOS
+    int mosM = 0, mosG = 0;                  // Its size and generator
+    int bestGen = 1;                         // mos::findBestGenerator(N, 7)
+    int scaleIndex = -1;                     // findScaleIndex(mask, N), -1 = no preset matches
+};
+
+// FNV-1a over N, useCustom and the mask bytes.
+uint64_t key(const Query& q);
+// The analysis itself, on the calling thread (thread-safe: shared memos only).
+Result analyze(const Query& q);
+
+struct Client {
+    hi::dsp::telemetry::Seqlock<Result> result; // Written by the worker, read by the UI
+private:
+    friend class Worker;
+    Query pending;                           // Guarded by Worker::mutex
+    bool queued = false;
+    uint64_t submittedKey = 0;
+    bool submitted = false;
+};
+
+class Worker {
+public:
+    explicit Worker(bool threaded);
+    ~Worker();
+    std::shared_ptr<Client> connect() { return std::make_shared<Client>(); }
+    // Queue q for c, replacing c's pending query. A repeat of the last submitted key is dropped.
+    void submit(const std::shared_ptr<Client>& c, Query q);
+    // Analyze one queued client and publish its result; false when the queue is empty. Called
+    // by the worker thread only (or by the owner of an unthreaded Worker): results are single-writer.
+    bool runOne();
+    size_t queued() const;
+private:
+    void loop();
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::shared_ptr<Client>> queue; // Clients with a pending query, FIFO
+    bool stopping = false;
+    std::thread thread;
+};
+
+// Process-wide worker (one thread for all instances), started on first use.
+Worker& shared();
+}}} // namespace hi::music::analysis
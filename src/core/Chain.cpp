@@ -0,0 +1,25 @@
+#include "Chain.hpp"
+/*
+ * Chain.cpp — Producer/consumer helpers for the hi::dsp::chain expander frame.
+ */
+namespace hi { namespace dsp { namespace chain {
+void fill(Frame& f, const float* volts, int channels, const int32_t* latched,
+          int32_t* prevStep, const QuantPlan* plan) {
+    if (channels < 0) channels = 0;
+    if (channels > 16) channels = 16;
+    uint16_t changed = 0;
+    for (int c = 0; c < 16; ++c) {
+        f.volts[c] = (c < channels) ? volts[c] : 0.f;
+        f.step[c] = latched[c];
+        if (latched[c] != prevStep[c]) { changed |= (uint16_t)(1u << c); prevStep[c] = latched[c]; }
+    }
+    f.channels = channels;
+    f.stepChanged = changed;
+    f.plan = plan;
+    f.magic = kMagic;
+}
+
+void expandSteps(const Frame& f, int32_t out[16]) {
+    for (int c = 0; c < 16; ++c) out[c] = (f.channels == 1) ? f.step[0] : f.step[c];
+}
+}}} // namespace hi::dsp::chain
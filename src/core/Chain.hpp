@@ -0,0 +1,41 @@
+#pragma once
+/*
+ * Chain.hpp — Expander message passed between adjacent PolyQuanta modules.
+ *
+ * A module with a PolyQuanta on its right writes one Frame per sample into the
+ * neighbour's leftExpander.producerMessage and requests a flip; Rack swaps the
+ * neighbour's producer/consumer buffers between engine steps, so the receiver
+ * reads a complete frame from leftExpander.consumerMessage one sample later
+ * (the same delay as a cable, but no port round trip).
+ *
+ * Besides the output volts the frame carries each voice's latched quantizer
+ * step and the plan it indexes. A receiver on the same (interned) plan adopts
+ * those steps instead of re-running the latch on an input that is already
+ * sitting on them (see PolyQuantaEngine::chainStep).
+ */
+#include <cstdint>
+#include "PolyQuantaCore.hpp"
+
+namespace hi { namespace dsp { namespace chain {
+static constexpr uint32_t kMagic = 0x50514331u;  // "PQC1": set once a producer has written the buffer
+
+struct Frame {
+    uint32_t magic = 0;                       // kMagic when valid
+    int channels = 0;                         // Output width this sample (0 = output idle)
+    float volts[16] = {0.f};                  // Output voltage per channel
+    int32_t step[16] = {0};                   // Latched quantizer step per channel (meaningful only with plan)
+    uint16_t stepChanged = 0;                 // Bit c: voice c's latched step changed on this sample
+    const QuantPlan* plan = nullptr;          // Plan the steps index; nullptr when they don't describe volts
+};
+
+// Producer: fill f with this sample's output. prevStep is the producer's own copy of the
+// steps it sent last (updated here) and drives stepChanged. Pass plan = nullptr when the
+// output is not the latched steps (summed to mono, block-latency playback).
+void fill(Frame& f, const float* volts, int channels, const int32_t* latched,
+          int32_t* prevStep, const QuantPlan* plan);
+
+inline bool valid(const Frame* f) { return f && f->magic == kMagic && f->channels > 0; }
+
+// Consumer: per-voice steps for the receiving engine (a mono frame feeds every voice).
+void expandSteps(const Frame& f, int32_t out[16]);
+}}} // namespace hi::dsp::chain
@@ -0,0 +1,55 @@
+#include "Diagnostics.hpp"
+#include <chrono>
+#include <cstdio>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+/*
+ * Diagnostics.cpp — Counter names, the timestamp source and the text report
+ * for hi::dsp::diag.
+ */
+namespace hi { namespace dsp { namespace diag {
+const char* name(Counter c) {
+    switch (c) {
+        case ProcessCalls:    return "process_calls";
+        case ProcessTicks:    return "process_ticks";
+        case Snaps:           return "snaps";
+        case Relatches:       return "relatches";
+        case StrumAssigns:    return "strum_assigns";
+        case PolyTransitions: return "poly_transitions";
+        case Nudges:          return "nudges";
+        case Settled:         return "settled_voice_samples";
+        default:              return "?";
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+const char* const kTickUnit = "cycles";
+uint64_t ticks() { return __rdtsc(); }
+#else
+const char* const kTickUnit = "ns";
+uint64_t ticks() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+int formatReport(const Counters& c, float sampleRate, char* out, size_t cap) {
+    if (!out || cap == 0) return 0;
+    size_t n = 0;
+    auto put = [&](int w) { if (w > 0) n = (n + (size_t)w < cap) ? n + (size_t)w : cap - 1; };
+    for (int k = 0; k < kCount; ++k)
+        put(std::snprintf(out + n, cap - n, "%-22s %llu\n", name((Counter)k), (unsigned long long)c.get((Counter)k)));
+    const uint64_t calls = c.get(ProcessCalls);
+    const double secs = (sampleRate > 0.f) ? (double)calls / (double)sampleRate : 0.0;
+    const double perCall = calls ? (double)c.get(ProcessTicks) / (double)calls : 0.0;
+    put(std::snprintf(out + n, cap - n, "%-22s %.1f %s\n", "ticks_per_process", perCall, kTickUnit));
+    put(std::snprintf(out + n, cap - n, "%-22s %.2f\n", "audio_seconds", secs));
+    if (secs > 0.0) {
+        put(std::snprintf(out + n, cap - n, "%-22s %.1f\n", "snaps_per_sec", (double)c.get(Snaps) / secs));
+        put(std::snprintf(out + n, cap - n, "%-22s %.1f\n", "nudges_per_sec", (double)c.get(Nudges) / secs));
+        put(std::snprintf(out + n, cap - n, "%-22s %.1f\n", "strum_assigns_per_sec", (double)c.get(StrumAssigns) / secs));
+    }
+    return (int)n;
+}
+}}} // namespace hi::dsp::diag
@@ -0,0 +1,74 @@
+#pragma once
+/*
+ * Diagnostics.hpp — Opt-in hot-path counters for PolyQuanta (build with
+ * -DHI_DIAGNOSTICS). Without the flag kEnabled is false and every add()/Scope
+ * folds away, so release builds carry no cost beyond the (unused) storage.
+ *
+ * Single writer: only the audio thread bumps counters, with relaxed
+ * load + store (no locked read-modify-write). Other threads read them
+ * relaxed; reset() only raises a flag the writer honours on its next
+ * beginProcess(), so a UI reset can never race a bump.
+ */
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hi { namespace dsp { namespace diag {
+#ifdef HI_DIAGNOSTICS
+static constexpr bool kEnabled = true;
+#else
+static constexpr bool kEnabled = false;
+#endif
+
+enum Counter : int {
+    ProcessCalls = 0,   // Module::process() calls (= samples)
+    ProcessTicks,       // Time spent in process() (ticks(), see kTickUnit)
+    Snaps,              // Latched quantizer step changes (all voices)
+    Relatches,          // Quantizer config changes that cleared the latches (cfgChanged)
+    StrumAssigns,       // Per-voice strum delay (re)assignments
+    PolyTransitions,    // Channel-width changes started (fade or immediate)
+    Nudges,             // Rounding-mode re-quantizations that moved the output to a neighbour step
+    Settled,            // Voice-samples skipped by the idle fast path
+    kCount
+};
+const char* name(Counter c);
+
+// Timestamp source for ProcessTicks: TSC cycles on x86, steady_clock nanoseconds elsewhere.
+uint64_t ticks();
+extern const char* const kTickUnit;
+
+struct Counters {
+    void add(Counter c, uint64_t n = 1) {
+        if (!kEnabled) return;
+        v[c].store(v[c].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    uint64_t get(Counter c) const { return v[c].load(std::memory_order_relaxed); }
+    void reset() { resetPending.store(true, std::memory_order_relaxed); }
+    // Audio thread, once per process(): apply a pending reset.
+    void beginProcess() {
+        if (!kEnabled || !resetPending.load(std::memory_order_relaxed)) return;
+        for (auto& x : v) x.store(0, std::memory_order_relaxed);
+        resetPending.store(false, std::memory_order_relaxed);
+    }
+private:
+    std::atomic<uint64_t> v[kCount] = {};
+    std::atomic<bool> resetPending{false};
+};
+
+// RAII: one ProcessCalls bump plus the elapsed ticks, early returns included.
+struct Scope {
+    explicit Scope(Counters& c) : ctr(c), t0(kEnabled ? ticks() : 0) { ctr.beginProcess(); }
+    ~Scope() {
+        if (!kEnabled) return;
+        ctr.add(ProcessCalls);
+        ctr.add(ProcessTicks, ticks() - t0);
+    }
+private:
+    Counters& ctr;
+    uint64_t t0;
+};
+
+// Plain-text report (one "name value" line per counter plus derived rates) for the menu
+// dump. Returns the number of characters written (snprintf semantics, truncated to cap).
+int formatReport(const Counters& c, float sampleRate, char* out, size_t cap);
+}}} // namespace hi::dsp::diag
@@ -0,0 +1,166 @@
+#include "Lanes.hpp"
+#include <cmath>
+#include <algorithm>
+/*
+ * Lanes.cpp — Vector and scalar-reference implementations of the per-voice
+ * SoA stages. The *Ref functions mirror the original per-channel code in
+ * PolyQuanta::process() line for line; the vector versions apply the same
+ * operations in the same order, 4 lanes at a time.
+ */
+namespace hi { namespace dsp { namespace lanes {
+
+// Hard clamp to ±maxV; knee lanes of the soft clipper (rare) fall back to clip::soft per lane.
+static inline f4 _clip4(f4 v, float maxV, bool soft) {
+    f4 r = vmax(splat(-maxV), vmin(v, splat(maxV)));
+    if (soft) {
+        const f4 a = vabs(v);
+        const i4 knee = (a > splat(maxV - 1.f)) & (a < splat(maxV)); // clip::soft knee is 1 V wide
+        if (any(knee))
+            for (int i = 0; i < 4; ++i) if (knee[i]) r[i] = clip::soft(v[i], maxV);
+    }
+    return r;
+}
+
+void computeTargets(const float* in, const float* off, const int32_t* snapMode, const float* preScale,
+                    const float* preOffset, const TargetParams& tp, int n, float* target) {
+    const f4 gain = splat(tp.useGain ? tp.gain : 1.f);
+    const f4 gOff = splat(tp.globalOffset);
+    const f4 spv = splat(tp.stepsPerVolt), cents = splat(1200.f), one = splat(1.f);
+    for (int b = 0; b < n; b += 4) {
+        const i4 qm = loadi(snapMode + b);
+        const i4 isSteps = (qm == splati(1)), isCents = (qm == splati(2));
+        f4 offTot = load(off + b) + gOff;
+        const f4 k = select(isSteps, spv, select(isCents, cents, one));        // Per-lane snap grid
+        offTot = select(isSteps | isCents, roundHalfAway(offTot * k) / k, offTot);
+        f4 t = load(in + b) * gain + offTot;
+        t = t * load(preScale + b) + load(preOffset + b);                       // Per-channel pre-range transform
+        storeN(target + b, t, n - b);
+    }
+}
+
+void computeTargetsRef(const float* in, const float* off, const int32_t* snapMode, const float* preScale,
+                       const float* preOffset, const TargetParams& tp, int n, float* target) {
+    for (int c = 0; c < n; ++c) {
+        float x = in[c];
+        if (tp.useGain) x *= tp.gain;
+        float offTot = off[c] + tp.globalOffset;
+        if (snapMode[c] == 1) offTot = std::round(offTot * tp.stepsPerVolt) / tp.stepsPerVolt;
+        else if (snapMode[c] == 2) offTot = std::round(offTot * 1200.f) / 1200.f;
+        float t = x + offTot;
+        target[c] = t * preScale[c] + preOffset[c];
+    }
+}
+
+void stepError(const float* target, const float* lastOut, bool pitchSafe, int n, float* aerrV, float* aerrN, int32_t* sign) {
+    const f4 norm = splat(pitchSafe ? 12.f : 1.f);                           // glide::voltsToSemitones
+    const f4 zero = splat(0.f);
+    for (int b = 0; b < n; b += 4) {
+        const f4 err = load(target + b) - load(lastOut + b);
+        const f4 a = vabs(err);
+        storeN(aerrV + b, a, n - b);
+        storeN(aerrN + b, a * norm, n - b);
+        storeNi(sign + b, (err < zero) - (err > zero), n - b);               // Compare masks are -1/0
+    }
+}
+
+void stepErrorRef(const float* target, const float* lastOut, bool pitchSafe, int n, float* aerrV, float* aerrN, int32_t* sign) {
+    for (int c = 0; c < n; ++c) {
+        float err = target[c] - lastOut[c];
+        sign[c] = (err > 0.f) - (err < 0.f);
+        aerrV[c] = std::fabs(err);
+        aerrN[c] = pitchSafe ? glide::voltsToSemitones(aerrV[c]) : aerrV[c];
+    }
+}
+
+void preRange(const float* x, range::Mode mode, float clipLimit, bool soft, int n, float* out) {
+    const f4 s = splat(mode == range::Mode::Scale ? clipLimit / hi::consts::MAX_VOLT_CLAMP : 1.f);
+    const bool softClip = soft && mode == range::Mode::Clip;                 // Scale mode always hard-clamps
+    for (int b = 0; b < n; b += 4)
+        storeN(out + b, _clip4(load(x + b) * s, clipLimit, softClip), n - b);
+}
+
+void preRangeRef(const float* x, range::Mode mode, float clipLimit, bool soft, int n, float* out) {
+    for (int c = 0; c < n; ++c) out[c] = range::apply(x[c], mode, clipLimit, soft);
+}
+
+void finishOutputs(const float* yFinal, const float* yPrev, const int32_t* hold, bool soft, float maxV, int n, float* out) {
+    for (int b = 0; b < n; b += 4) {
+        const f4 y = select(loadi(hold + b) != splati(0), load(yPrev + b), load(yFinal + b));
+        storeN(out + b, _clip4(y, maxV, soft), n - b);
+    }
+}
+
+void finishOutputsRef(const float* yFinal, const float* yPrev, const int32_t* hold, bool soft, float maxV, int n, float* out) {
+    for (int c = 0; c < n; ++c) {
+        float y = hold[c] ? yPrev[c] : yFinal[c];
+        out[c] = soft ? clip::soft(y, maxV) : std::max(-maxV, std::min(y, maxV));
+    }
+}
+
+void scale(const float* x, float gain, int n, float* out) {
+    const f4 g = splat(gain);
+    for (int b = 0; b < n; b += 4) storeN(out + b, load(x + b) * g, n - b);
+}
+
+void scaleRef(const float* x, float gain, int n, float* out) {
+    for (int c = 0; c < n; ++c) out[c] = x[c] * gain;
+}
+}}} // namespace hi::dsp::lanes
+
+namespace hi { namespace dsp { namespace glide {
+using namespace hi::dsp::lanes;
+
+// Shape multiplier for 4 lanes: when every active lane sits at u = 1 (the usual case) they share tbl[kSize].
+static inline f4 _shapeMul4(const ShapeLUT& lut, f4 u, i4 act) {
+    const i4 partial = act & (u < splat(1.f));
+    if (!any(partial)) return splat(lut.tbl[ShapeLUT::kSize]);
+    f4 m;
+    for (int i = 0; i < 4; ++i) m[i] = lut.at(u[i]);
+    return m;
+}
+
+void PolySlew::process(const float* target, const float* remaining, const float* sec, const int32_t* active,
+                       float dt, int n, float* y) {
+    const f4 eps = splat(hi::consts::EPS_ERR), rateEps = splat(hi::consts::RATE_EPS);
+    const f4 vdt = splat(dt), zero = splat(0.f), one = splat(1.f);
+    for (int b = 0; b < n; b += 4) {
+        const i4 act = (loadi(active + b) != splati(0));
+        if (!any(act)) continue;
+        const f4 rem = load(remaining + b);
+        const f4 u = vmin(vmax(rem / vmax(rem, eps), zero), one);     // Progress ratio
+        const f4 base = rem / load(sec + b);                           // Inactive lanes may divide by 0; masked below
+        const f4 rr = base * _shapeMul4(riseLut, u, act);
+        const f4 rf = base * _shapeMul4(fallLut, u, act);
+        f4 r0 = load(rise + b), f0 = load(fall + b);
+        const i4 upd = act & ((vabs(rr - r0) > rateEps) | (vabs(rf - f0) > rateEps));
+        r0 = select(upd, rr, r0);
+        f0 = select(upd, rf, f0);
+        const f4 o = load(out + b);
+        const f4 no = select(act, vmax(vmin(load(target + b), o + r0 * vdt), o - f0 * vdt), o);
+        storeN(rise + b, r0, n - b);
+        storeN(fall + b, f0, n - b);
+        storeN(out + b, no, n - b);
+        storeN(y + b, select(act, no, load(y + b)), n - b);
+    }
+}
+
+void PolySlew::processRef(const float* target, const float* remaining, const float* sec, const int32_t* active,
+                          float dt, int n, float* y) {
+    for (int c = 0; c < n; ++c) {
+        if (!active[c]) continue;
+        float remainingV = remaining[c];
+        float totalJumpV = remainingV;
+        float baseRateV = totalJumpV / sec[c];
+        float u = std::max(0.f, std::min(remainingV / std::max(totalJumpV, hi::consts::EPS_ERR), 1.f));
+        float rateRise = baseRateV * shapeMul(u, riseLut.params, hi::consts::EPS_ERR);
+        float rateFall = baseRateV * shapeMul(u, fallLut.params, hi::consts::EPS_ERR);
+        if (std::fabs(rateRise - rise[c]) > hi::consts::RATE_EPS ||
+            std::fabs(rateFall - fall[c]) > hi::consts::RATE_EPS) {
+            rise[c] = rateRise;
+            fall[c] = rateFall;
+        }
+        out[c] = std::fmax(std::fmin(target[c], out[c] + rise[c] * dt), out[c] - fall[c] * dt);
+        y[c] = out[c];
+    }
+}
+}}} // namespace hi::dsp::glide
@@ -0,0 +1,103 @@
+#pragma once
+/*
+ * Lanes.hpp — 16-voice SoA lane helpers for the branch-light parts of
+ * PolyQuanta::process() (target assembly, step error, pre-range, output clip,
+ * fade ramp) plus the PolySlew bank. Each stage has a vector implementation working on 4 channels per
+ * f4 register and a scalar *Ref implementation kept as the reference; the core
+ * tests assert both agree within kParityTol.
+ *
+ * f4/i4 use GCC/Clang vector extensions, which lower to SSE on x86 and NEON on
+ * ARM (every Rack toolchain is GCC or Clang). Arrays are 16 lanes; stages read
+ * whole 4-lane blocks but only write lanes [0, n).
+ */
+#include <cstdint>
+#include <cstring>
+#include "PolyQuantaCore.hpp"
+
+namespace hi { namespace dsp { namespace lanes {
+typedef float   f4 __attribute__((vector_size(16)));
+typedef int32_t i4 __attribute__((vector_size(16)));
+
+static constexpr int   kMaxLanes = 16;
+#ifdef HI_LANES_SCALAR
+static constexpr bool  kVector = false;      // -DHI_LANES_SCALAR routes PolyQuanta through the *Ref stages
+#else
+static constexpr bool  kVector = true;
+#endif
+static constexpr float kParityTol = 1e-5f;   // Max |vector - scalar| / max(1, |scalar|) in core tests (~0.01 cent at 1 V)
+
+// Unaligned 4-lane load/store (movups/vld1q); storeN writes only the first count lanes.
+inline f4 load(const float* p) { f4 v; std::memcpy(&v, p, sizeof(v)); return v; }
+inline i4 loadi(const int32_t* p) { i4 v; std::memcpy(&v, p, sizeof(v)); return v; }
+inline void storeN(float* p, f4 v, int count) { if (count >= 4) std::memcpy(p, &v, sizeof(v)); else for (int i = 0; i < count; ++i) p[i] = v[i]; }
+inline void storeNi(int32_t* p, i4 v, int count) { if (count >= 4) std::memcpy(p, &v, sizeof(v)); else for (int i = 0; i < count; ++i) p[i] = v[i]; }
+inline f4 splat(float x) { return f4{x, x, x, x}; }
+inline i4 splati(int32_t x) { return i4{x, x, x, x}; }
+// Branchless select: m lanes are all-ones (true) or zero (false) as produced by vector compares.
+inline f4 select(i4 m, f4 a, f4 b) { return (f4)(((i4)a & m) | ((i4)b & ~m)); }
+inline f4 vabs(f4 x) { return (f4)((i4)x & splati(0x7fffffff)); }
+inline f4 vmin(f4 a, f4 b) { return select(a < b, a, b); }
+inline f4 vmax(f4 a, f4 b) { return select(a > b, a, b); }
+inline bool any(i4 m) { return (m[0] | m[1] | m[2] | m[3]) != 0; }
+// std::round semantics (halfway cases away from zero); exact for |x| < 2^31.
+inline f4 roundHalfAway(f4 x) {
+    const f4 t = __builtin_convertvector(__builtin_convertvector(x, i4), f4); // trunc toward zero
+    const f4 d = x - t;                                                        // exact fractional part
+    const f4 one = splat(1.f), zero = splat(0.f);
+    return t + select(d >= splat(0.5f), one, zero) - select(d <= splat(-0.5f), one, zero);
+}
+
+// Pass 1 inputs: per-lane SoA arrays plus the shared scalars derived once per sample.
+struct TargetParams {
+    bool  useGain = false;       // Global attenuverter active
+    float gain = 1.f;            // Attenuverter gain (-10..+10)
+    float globalOffset = 0.f;    // Added to every per-channel offset
+    float stepsPerVolt = 12.f;   // Offset snap grid for mode 1 (tuning steps)
+};
+// target = ((in * gain) + snap(off + globalOffset)) * preScale + preOffset; snapMode 0=volts, 1=steps, 2=cents
+void computeTargets(const float* in, const float* off, const int32_t* snapMode, const float* preScale,
+                    const float* preOffset, const TargetParams& tp, int n, float* target);
+void computeTargetsRef(const float* in, const float* off, const int32_t* snapMode, const float* preScale,
+                       const float* preOffset, const TargetParams& tp, int n, float* target);
+// err = target - lastOut → |err| (volts), normalized |err| (semitones when pitchSafe), sign(err)
+void stepError(const float* target, const float* lastOut, bool pitchSafe, int n, float* aerrV, float* aerrN, int32_t* sign);
+void stepErrorRef(const float* target, const float* lastOut, bool pitchSafe, int n, float* aerrV, float* aerrN, int32_t* sign);
+// range::apply() for all lanes (pre-quant Clip/Scale around 0 V)
+void preRange(const float* x, range::Mode mode, float clipLimit, bool soft, int n, float* out);
+void preRangeRef(const float* x, range::Mode mode, float clipLimit, bool soft, int n, float* out);
+// out = clip(hold ? yPrev : yFinal) with soft or hard limiting at ±maxV
+void finishOutputs(const float* yFinal, const float* yPrev, const int32_t* hold, bool soft, float maxV, int n, float* out);
+void finishOutputsRef(const float* yFinal, const float* yPrev, const int32_t* hold, bool soft, float maxV, int n, float* out);
+// out = x * gain (poly fade ramp)
+void scale(const float* x, float gain, int n, float* out);
+void scaleRef(const float* x, float gain, int n, float* out);
+}}} // namespace hi::dsp::lanes
+
+namespace hi { namespace dsp { namespace glide {
+// PolySlew: 16-channel SoA replacement for dsp::SlewLimiter slews[16] and its rate cache.
+// Per active lane (Equal-time glide):
+//   u    = clamp(|err| / max(|err|, EPS_ERR), 0, 1)
+//   rate = (|err| / sec) * shapeMul(u)            (rise and fall shapes)
+//   rise/fall are replaced only when either moved by more than RATE_EPS (anti-zipper)
+//   out  = clamp(target, out - fall*dt, out + rise*dt)  (SlewLimiter::process)
+// process() uses the ShapeLUTs and 4-wide lanes; processRef() is the scalar reference
+// that evaluates shapeMul() directly, exactly as the per-channel code did.
+struct PolySlew {
+    float out[16] = {0};                  // SlewLimiter::out per channel
+    float rise[16] = {0}, fall[16] = {0}; // Current rates in V/s (-1 = force update on next step)
+    ShapeLUT riseLut, fallLut;
+    // Once per sample: rebuild shape tables only when a shape knob moved.
+    void setShapes(float riseShape, float fallShape) {
+        riseLut.update(riseShape, hi::consts::EPS_ERR);
+        fallLut.update(fallShape, hi::consts::EPS_ERR);
+    }
+    void reset(int c) { out[c] = 0.f; }                     // SlewLimiter::reset() semantics
+    void invalidateRates(int c) { rise[c] = -1.f; fall[c] = -1.f; }
+    // Advance lanes with active[c] != 0 toward target[c]; remaining[c] = |target - lastOut|.
+    // y[c] receives the slewed value on active lanes and is left untouched elsewhere.
+    void process(const float* target, const float* remaining, const float* sec, const int32_t* active,
+                 float dt, int n, float* y);
+    void processRef(const float* target, const float* remaining, const float* sec, const int32_t* active,
+                    float dt, int n, float* y);
+};
+}}} // namespace hi::dsp::glide
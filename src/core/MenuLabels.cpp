@@ -0,0 +1,99 @@
+#include "MenuLabels.hpp"
+#include <cmath>
+#include <cstdio>
+/*
+ * MenuLabels.cpp — Label formatting (moved verbatim from the Root and Degrees
+ * submenus of PolyQuantaWidget) and the per-module label cache.
+ */
+namespace hi { namespace ui { namespace labels {
+namespace {
+const char* const kNoteNames[12] = {"C","C#","D","D#","E","F","F#","G","G#","A","A#","B"};
+
+template <typename... Args>
+std::string format(const char* fmt, Args... args) {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), fmt, args...);
+    return buf;
+}
+} // namespace
+
+std::string rootLabel(int n, int N, float period, bool edo) {
+    float semis = (float)n * 12.f * period / (float)N;         // Convert to semitones
+    int nearestPc = (int)std::round(semis);                     // Nearest 12-EDO pitch class
+    float delta = semis - (float)nearestPc;                     // Deviation from 12-EDO
+    float err = std::fabs(delta);                               // Absolute error
+
+    // Exact 12-EDO pitch class: step alignment for EDOs divisible by 12, else a float tolerance
+    bool exact = (edo && (N % 12) == 0) ? (n % (N / 12)) == 0 : err <= 1e-6f;
+
+    int pc12 = ((nearestPc % 12) + 12) % 12;
+    if (exact) return format("%d (%s)", n, kNoteNames[pc12]);
+    if (err <= 0.05f) {
+        int cents = (int)std::round(delta * 100.f);
+        return cents != 0 ? format("%d (≈%s %+d¢)", n, kNoteNames[pc12], cents)
+                          : format("%d (≈%s)", n, kNoteNames[pc12]);
+    }
+    return format("%d", n);                                     // Distant: step number only
+}
+
+std::string degreeLabel(int deg, int N, int displayIndex) {
+    int actualPC = deg % N;
+    float note12Float = (actualPC * 12.0f) / N;                 // 12-EDO equivalent
+    int note12 = (int)std::round(note12Float);
+    if (note12 < 0) note12 += 12;
+    note12 = note12 % 12;
+
+    float cents = (note12Float - note12) * 100.0f;              // Deviation from 12-EDO
+    if (cents > 50.0f) cents -= 100.0f;
+    if (cents < -50.0f) cents += 100.0f;
+
+    // Only name notes within ±5 cents of 12-EDO
+    if (std::fabs(cents) <= 5.0f) {
+        if (std::fabs(cents) < 0.1f) return format("%d (%s)", displayIndex + 1, kNoteNames[note12]);
+        return format("%d (%s %+.0f¢)", displayIndex + 1, kNoteNames[note12], cents);
+    }
+    return format("%d", displayIndex + 1);
+}
+
+Pages split(int n) {
+    Pages p;
+    if (n > 72) {
+        const int base = n / 3, rem = n % 3;
+        const int size1 = base + (rem > 0 ? 1 : 0);
+        const int size2 = base + (rem > 1 ? 1 : 0);
+        p.count = 3;
+        p.lo[0] = 0;         p.hi[0] = size1 - 1;
+        p.lo[1] = size1;     p.hi[1] = size1 + size2 - 1;
+        p.lo[2] = p.hi[1] + 1; p.hi[2] = n - 1;
+    } else if (n > 36) {
+        const int halfLo = (n + 1) / 2;
+        p.count = 2;
+        p.lo[0] = 0;         p.hi[0] = halfLo - 1;
+        p.lo[1] = halfLo;    p.hi[1] = n - 1;
+    } else {
+        p.hi[0] = n - 1;
+    }
+    return p;
+}
+
+const std::vector<std::string>& Cache::roots(int tuningMode, int N, float period) {
+    if (tuningMode == rootMode && N == rootN && period == rootPeriod && (int)rootText.size() == N) return rootText;
+    rootText.clear();
+    rootText.reserve((size_t)N);
+    for (int n = 0; n < N; ++n) rootText.push_back(rootLabel(n, N, period, tuningMode == 0));
+    rootMode = tuningMode; rootN = N; rootPeriod = period;
+    return rootText;
+}
+
+const std::vector<std::string>& Cache::degrees(int N, int root) {
+    if (N == degreeN && root == degreeRoot && (int)degreeText.size() == N) return degreeText;
+    degreeText.clear();
+    degreeText.reserve((size_t)N);
+    const Pages p = split(N);
+    for (int k = 0; k < p.count; ++k)
+        for (int i = p.lo[k]; i <= p.hi[k]; ++i)
+            degreeText.push_back(degreeLabel((i - root + N) % N, N, i - p.lo[k]));  // Root appears first
+    degreeN = N; degreeRoot = root;
+    return degreeText;
+}
+}}} // namespace hi::ui::labels
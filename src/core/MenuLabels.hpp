@@ -0,0 +1,44 @@
+#pragma once
+/*
+ * MenuLabels.hpp — Root and degree labels for PolyQuanta's context menus,
+ * computed once per (tuning, root) instead of on every submenu hover.
+ *
+ * The menus themselves are built lazily (createSubmenuItem callbacks run on
+ * hover); this module supplies the text those callbacks need and the page
+ * split shared by every long list (roots, degrees, scale presets). Rack-free
+ * so the label rules are covered by the core tests; the widget owns one
+ * Cache per module and touches it only from the UI thread.
+ */
+#include <string>
+#include <vector>
+
+namespace hi { namespace ui { namespace labels {
+// Root menu entry for step n of an N-step system whose period is `period` octaves
+// ("7 (G)", "5 (≈D# -16¢)" or just "5" when far from any 12-EDO pitch class).
+std::string rootLabel(int n, int N, float period, bool edo);
+// Degree editor entry: displayIndex + 1, with the 12-EDO note name when the root-relative
+// degree lies within 5 cents of one ("3 (D)", "9 (E +3¢)", "4").
+std::string degreeLabel(int deg, int N, int displayIndex);
+
+// Split of an n-item list into submenu pages: one page up to 36 items, halves up to 72
+// (the lower half takes the odd item), thirds beyond that (remainder to the first pages).
+struct Pages {
+    int count = 1;
+    int lo[3] = {0, 0, 0};
+    int hi[3] = {0, 0, 0};                  // Inclusive
+};
+Pages split(int n);
+
+struct Cache {
+    // Labels for steps 0..N-1; rebuilt only when the tuning changes.
+    const std::vector<std::string>& roots(int tuningMode, int N, float period);
+    // Degree labels in menu order (entry i toggles mask bit i); displayIndex restarts on every
+    // page of split(N). Rebuilt only when N or the root changes.
+    const std::vector<std::string>& degrees(int N, int root);
+private:
+    std::vector<std::string> rootText, degreeText;
+    int rootMode = -1, rootN = 0;
+    float rootPeriod = 0.f;
+    int degreeN = 0, degreeRoot = 0;
+};
+}}} // namespace hi::ui::labels
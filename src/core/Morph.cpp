@@ -0,0 +1,27 @@
+#include "Morph.hpp"
+/*
+ * Morph.cpp — Slot bookkeeping for hi::dsp::morph::Bank (tick() is inline in
+ * the header so the host's read/write callbacks inline into the loop).
+ */
+namespace hi { namespace dsp { namespace morph {
+void Bank::start(int k, float from, float to, uint32_t lenSamples, uint16_t every, uint16_t phase) {
+    if (k < 0 || k >= kSlots) return;
+    Slot& s = slots[k];
+    if (!s.active) ++nActive;
+    s.from = from; s.to = to; s.last = from;
+    s.len = lenSamples > 0 ? lenSamples : 1; s.t = 0;
+    s.every = every > 0 ? every : 1; s.phase = phase;
+    s.active = true;
+}
+
+void Bank::cancel(int k) {
+    if (k < 0 || k >= kSlots || !slots[k].active) return;
+    slots[k].active = false;
+    --nActive;
+}
+
+void Bank::clear() {
+    for (Slot& s : slots) s.active = false;
+    nActive = 0;
+}
+}}} // namespace hi::dsp::morph
@@ -0,0 +1,55 @@
+#pragma once
+/*
+ * Morph.hpp — Glided randomization targets for PolyQuanta's doRandomize().
+ * Instead of jumping every randomized knob at once, each knob gets a slot that
+ * walks linearly from its current value to the drawn target over the morph
+ * time. Slots write back on a staggered schedule (every `every` samples at
+ * their own phase) so the costly consumers — per-channel rate recomputation
+ * for slew times, curve-table rebuilds for the shapes — are spread across
+ * samples instead of all landing on the randomize edge.
+ *
+ * Rack-free: the host supplies read/write callbacks for its parameters. A
+ * slot whose parameter no longer holds the last written value (the user moved
+ * the knob) is released without writing.
+ */
+#include <cstdint>
+
+namespace hi { namespace dsp { namespace morph {
+static constexpr float kTimesSec[] = {0.f, 0.01f, 0.05f, 0.2f, 1.f}; // Menu choices (0 = jump, legacy)
+static inline bool isValidTime(float s) { for (float t : kTimesSec) if (t == s) return true; return false; }
+
+struct Slot {
+    float from = 0.f, to = 0.f;     // Segment end points
+    float last = 0.f;               // Value last written to the parameter
+    uint32_t len = 0, t = 0;        // Segment length / elapsed (samples)
+    uint16_t every = 1, phase = 0;  // Write when (t + phase) % every == 0, and on the final sample
+    bool active = false;
+};
+
+struct Bank {
+    static constexpr int kSlots = 34;   // PolyQuanta: 16 slews, 16 offsets, rise, fall
+    Slot slots[kSlots];
+    int nActive = 0;
+    // Glide slot k from `from` to `to` over lenSamples (>= 1), restarting any glide in progress.
+    void start(int k, float from, float to, uint32_t lenSamples, uint16_t every = 1, uint16_t phase = 0);
+    void cancel(int k);
+    void clear();
+    bool idle() const { return nActive == 0; }
+    // One sample: for each active slot, read(k) is compared with the last written value (a
+    // mismatch releases the slot), then write(k, v) runs on the slot's scheduled samples.
+    template <class Read, class Write> void tick(Read&& read, Write&& write) {
+        if (nActive == 0) return;
+        for (int k = 0; k < kSlots; ++k) {
+            Slot& s = slots[k];
+            if (!s.active) continue;
+            if (read(k) != s.last) { cancel(k); continue; }      // Knob moved by hand: stop gliding
+            ++s.t;
+            const bool done = s.t >= s.len;
+            if (!done && (s.t + s.phase) % s.every != 0) continue;
+            s.last = done ? s.to : s.from + (s.to - s.from) * ((float)s.t / (float)s.len);
+            write(k, s.last);
+            if (done) cancel(k);
+        }
+    }
+};
+}}} // namespace hi::dsp::morph
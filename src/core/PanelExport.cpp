@@ -5,8 +5,13 @@
 #include <app/ParamWidget.hpp>
 #include <app/PortWidget.hpp>
 #include <app/LightWidget.hpp>
+#include "SvgStream.hpp" // Buffered panel-artwork streaming
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
 #include <typeinfo>
 
 // NOTE: This file contains code MOVED from PolyQuanta.cpp (PolyQuantaWidget context menu lambda)
@@ -18,56 +23,36 @@ namespace PanelExport {
 
 using namespace rack;
 
-bool exportPanelSnapshot(rack::app::ModuleWidget* mw,
-                         const std::string& moduleName,
-                         const std::string& panelSvgRelPath,
-                         const std::string& outPath) {
-    if (!mw) return false; // defensive
+std::string userDir() {
+    std::string dir = ::rack::asset::user(::rack::string::f("%s/overlays", ::pluginInstance->slug.c_str()));
+    ::rack::system::createDirectories(dir);
+    return dir;
+}
+
+Job capture(rack::app::ModuleWidget* mw,
+            const std::string& moduleName,
+            const std::string& panelSvgRelPath,
+            const std::string& outPath) {
+    Job job;
+    job.moduleName = moduleName;
+    job.snapshotPath = outPath;
+    if (!mw) return job; // defensive
 
     // 1) Recreate original constants / conversions (identical to previous lambda)
     const float pxPerMM = rack::app::RACK_GRID_WIDTH / 5.08f; // Rack constant: 1 HP = 5.08 mm
-    const float wMM = mw->box.size.x / pxPerMM;
-    const float hMM = rack::app::RACK_GRID_HEIGHT / pxPerMM;
-
-    // 2) Load panel SVG (same path construction) and strip outer <svg> wrapper.
-    std::string panelPath = ::rack::asset::plugin(::pluginInstance, panelSvgRelPath);
-    std::ifstream pf(panelPath, std::ios::binary);
-    std::string panelSrc; if (pf) panelSrc.assign(std::istreambuf_iterator<char>(pf), std::istreambuf_iterator<char>());
-    auto stripOuterSvg = [](const std::string& src)->std::string {
-        size_t open = src.find("<svg"); if (open == std::string::npos) return src;
-        size_t gt = src.find('>', open); if (gt == std::string::npos) return src;
-        size_t close = src.rfind("</svg"); if (close == std::string::npos || close <= gt) return src.substr(gt+1);
-        return src.substr(gt+1, close - (gt+1));
-    };
-    std::string panelInner = stripOuterSvg(panelSrc);
-
-    // 3) Prepare output directory & filename – identical naming (moduleName + "-panel-snapshot.svg")
-    std::string dir = ::rack::asset::user(::rack::string::f("%s/overlays", ::pluginInstance->slug.c_str()));
-    ::rack::system::createDirectories(dir);
-    std::string finalPath = outPath.empty() ? (dir + "/" + moduleName + "-panel-snapshot.svg") : outPath;
-    std::ofstream out(finalPath, std::ios::binary); if (!out) return false;
+    job.wMM = mw->box.size.x / pxPerMM;
+    job.hMM = rack::app::RACK_GRID_HEIGHT / pxPerMM;
 
-    auto pxToMM = [pxPerMM](float px){ return px / pxPerMM; };
+    // 2) Panel SVG path (same path construction); the artwork itself is streamed by writeSnapshot.
+    job.panelPath = ::rack::asset::plugin(::pluginInstance, panelSvgRelPath);
 
-    // 4) Emit SVG header, defs, and embedded panel artwork group EXACTLY as original.
-    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-    out << rack::string::f("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%.3fmm\" height=\"%.3fmm\" viewBox=\"0 0 %.3f %.3f\" font-family=\"ShareTechMono,monospace\" font-size=\"3.2\" stroke-linejoin=\"round\" stroke-linecap=\"round\">\n", wMM, hMM, wMM, hMM);
-    out <<
-        "  <defs>\n"
-        "    <style><![CDATA[\n"
-        "      .knob-body{fill:#222;stroke:#888;stroke-width:0.3}\n"
-        "      .knob-pointer{stroke:#ffb300;stroke-width:0.45}\n"
-        "      .jack{fill:#111;stroke:#5c6bc0;stroke-width:0.35}\n"
-        "      .btn{fill:#303030;stroke:#aaa;stroke-width:0.35}\n"
-        "      .sw{fill:#252525;stroke:#ba68c8;stroke-width:0.35}\n"
-        "      .led{fill:#000}\n"
-        "      .panel-group *{vector-effect:non-scaling-stroke}\n"
-        "    ]]></style>\n"
-        "  </defs>\n";
-    out << "  <g class=\"panel-group\" id=\"panelArtwork\">\n" << panelInner << "\n  </g>\n";
-    out << "  <g id=\"components\">\n";
+    auto pxToMM = [pxPerMM](float px){ return px / pxPerMM; };
+    using hi::ui::overlay::Kind;
+    auto mark = [&job](Kind k, float x, float y, float r){ job.marks.push_back(hi::ui::overlay::Marker{k, x, y, r}); };
+    std::ostringstream out;
 
-    // 5) Iterate widget children and write simplified geometry (same classification logic).
+    // 3) Iterate widget children and write simplified geometry (same classification logic).
+    //    The overlay markers come from the same walk.
     for (widget::Widget* w : mw->children) {
         if (!w) continue;
     math::Vec center = w->box.getCenter();
@@ -78,6 +63,7 @@ bool exportPanelSnapshot(rack::app::ModuleWidget* mw,
     if (dynamic_cast<app::LightWidget*>(w)) {
             float r = 1.2f; // approximate radius (identical)
             out << rack::string::f("    <circle class=\"led\" cx=\"%.3f\" cy=\"%.3f\" r=\"%.3f\"/>\n", cxMM, cyMM, r);
+            mark(Kind::Led, cxMM, cyMM, r);
             continue;
         }
 
@@ -90,6 +76,7 @@ bool exportPanelSnapshot(rack::app::ModuleWidget* mw,
             if (isKnob) {
                 float bodyR = r * 0.95f;
                 out << rack::string::f("    <circle class=\"knob-body\" cx=\"%.3f\" cy=\"%.3f\" r=\"%.3f\"/>\n", cxMM, cyMM, bodyR);
+                mark(Kind::Knob, cxMM, cyMM, bodyR);
                 if (pq) {
                     float v = pq->getValue();
                     float norm = 0.f;
@@ -109,28 +96,138 @@ bool exportPanelSnapshot(rack::app::ModuleWidget* mw,
                 float wMMb = pxToMM(w->box.size.x);
                 float hMMb = pxToMM(w->box.size.y);
                 out << rack::string::f("    <rect class=\"sw\" x=\"%.3f\" y=\"%.3f\" width=\"%.3f\" height=\"%.3f\" rx=\"0.8\" ry=\"0.8\"/>\n", cxMM - wMMb*0.5f, cyMM - hMMb*0.5f, wMMb, hMMb);
+                mark(Kind::Switch, cxMM, cyMM, r);
                 continue;
             }
             if (isButton) {
                 out << rack::string::f("    <circle class=\"btn\" cx=\"%.3f\" cy=\"%.3f\" r=\"%.3f\"/>\n", cxMM, cyMM, r*0.85f);
+                mark(Kind::Button, cxMM, cyMM, r*0.85f);
                 continue;
             }
             // Generic param fallback (unchanged)
             out << rack::string::f("    <circle class=\"knob-body\" cx=\"%.3f\" cy=\"%.3f\" r=\"%.3f\"/>\n", cxMM, cyMM, r*0.6f);
+            mark(Kind::Knob, cxMM, cyMM, r*0.6f);
             continue;
         }
 
     if (dynamic_cast<app::PortWidget*>(w)) {
             float rr = pxToMM(std::max(w->box.size.x, w->box.size.y) * 0.5f) * 0.85f;
             out << rack::string::f("    <circle class=\"jack\" cx=\"%.3f\" cy=\"%.3f\" r=\"%.3f\"/>\n", cxMM, cyMM, rr);
+            mark(Kind::Jack, cxMM, cyMM, rr);
             continue;
         }
+
+        // Screws are overlay-only (the snapshot never drew them)
+        if (cls.find("Screw") != std::string::npos)
+            mark(Kind::Screw, cxMM, cyMM, pxToMM(std::max(w->box.size.x, w->box.size.y) * 0.5f));
     }
+    job.components = out.str();
+    return job;
+}
+
+bool writeSnapshot(const Job& job) {
+    // 4) Prepare output directory & filename – identical naming (moduleName + "-panel-snapshot.svg")
+    std::string finalPath = job.snapshotPath.empty() ? (userDir() + "/" + job.moduleName + "-panel-snapshot.svg") : job.snapshotPath;
+    std::ofstream out(finalPath, std::ios::binary); if (!out) return false;
+
+    // 5) Emit SVG header, defs, and embedded panel artwork group EXACTLY as original.
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    out << rack::string::f("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%.3fmm\" height=\"%.3fmm\" viewBox=\"0 0 %.3f %.3f\" font-family=\"ShareTechMono,monospace\" font-size=\"3.2\" stroke-linejoin=\"round\" stroke-linecap=\"round\">\n", job.wMM, job.hMM, job.wMM, job.hMM);
+    out <<
+        "  <defs>\n"
+        "    <style><![CDATA[\n"
+        "      .knob-body{fill:#222;stroke:#888;stroke-width:0.3}\n"
+        "      .knob-pointer{stroke:#ffb300;stroke-width:0.45}\n"
+        "      .jack{fill:#111;stroke:#5c6bc0;stroke-width:0.35}\n"
+        "      .btn{fill:#303030;stroke:#aaa;stroke-width:0.35}\n"
+        "      .sw{fill:#252525;stroke:#ba68c8;stroke-width:0.35}\n"
+        "      .led{fill:#000}\n"
+        "      .panel-group *{vector-effect:non-scaling-stroke}\n"
+        "    ]]></style>\n"
+        "  </defs>\n";
+    out << "  <g class=\"panel-group\" id=\"panelArtwork\">\n";
+    hi::ui::svg::copyInner(job.panelPath, out);           // Missing artwork: empty group, as before
+    out << "\n  </g>\n";
+    out << "  <g id=\"components\">\n" << job.components;
     out << "  </g>\n";
     out << "</svg>\n";
     return true;
 }
 
+bool exportPanelSnapshot(rack::app::ModuleWidget* mw,
+                         const std::string& moduleName,
+                         const std::string& panelSvgRelPath,
+                         const std::string& outPath) {
+    if (!mw) return false; // defensive
+    return writeSnapshot(capture(mw, moduleName, panelSvgRelPath, outPath));
+}
+
+bool writeJob(const Job& job) {
+    bool ok = writeSnapshot(job);
+    ok = PanelExport::exportOverlay(job.moduleName, job.wMM, job.hMM, job.marks, job.overlayPath) && ok;
+    return ok;
+}
+
+std::vector<Job> capturePatch() {
+    std::vector<Job> jobs;
+    if (!APP || !APP->scene || !APP->scene->rack) return jobs;
+    std::map<std::string, int> seen;                       // Slug -> instances so far (file names stay unique)
+    for (app::ModuleWidget* mw : APP->scene->rack->getModules()) {
+        if (!mw || !mw->model || mw->model->plugin != ::pluginInstance) continue;
+        const std::string& slug = mw->model->slug;
+        const int n = ++seen[slug];
+        const std::string name = (n == 1) ? slug : rack::string::f("%s-%d", slug.c_str(), n);
+        jobs.push_back(capture(mw, name, "res/" + slug + ".svg"));
+    }
+    return jobs;
+}
+
+std::vector<Job> captureModels() {
+    std::vector<Job> jobs;
+    for (Model* model : ::pluginInstance->models) {
+        app::ModuleWidget* mw = model->createModuleWidget(nullptr);    // Browser-style preview: no module
+        if (!mw) continue;
+        jobs.push_back(capture(mw, model->slug, "res/" + model->slug + ".svg"));
+        delete mw;
+    }
+    return jobs;
+}
+
+Batch::Batch(std::vector<Job> jobs_, int threads) : jobs(std::move(jobs_)) {
+    if (threads <= 0) threads = (int)std::min(4u, std::max(1u, std::thread::hardware_concurrency()));
+    threads = std::min(threads, total());
+    for (int i = 0; i < threads; ++i) pool.emplace_back([this]{ run(); });
+}
+
+Batch::~Batch() {
+    for (std::thread& t : pool) if (t.joinable()) t.join();
+}
+
+void Batch::run() {
+    for (int i; (i = next.fetch_add(1)) < total();) {
+        if (!writeJob(jobs[(size_t)i])) failCount.fetch_add(1);
+        if (doneCount.fetch_add(1) + 1 == total())
+            INFO("PanelExport: %d modules exported to %s (%d failed)", total(), userDir().c_str(), failed());
+    }
+}
+
+namespace {
+std::unique_ptr<Batch>& current() {
+    static std::unique_ptr<Batch> b;
+    return b;
+}
+} // namespace
+
+bool startBatch(std::vector<Job> jobs) {
+    std::unique_ptr<Batch>& b = current();
+    if (b && !b->finished()) return false;
+    b.reset();                                              // Joins the finished workers
+    b.reset(new Batch(std::move(jobs)));
+    return true;
+}
+
+const Batch* batch() { return current().get(); }
+
 // ----------------------------------------------------------------------------
 // Overlay exporter implementation (moved from PolyQuanta.cpp). Produces a
 // minimalist SVG containing the panel outline plus marker circles and cross
@@ -142,8 +239,7 @@ bool exportOverlay(const std::string& moduleName,
                 float hMM,
                 const std::vector<hi::ui::overlay::Marker>& marks,
                 const std::string& outPath) {
-    std::string dir = ::rack::asset::user(::rack::string::f("%s/overlays", ::pluginInstance->slug.c_str()));
-    ::rack::system::createDirectories(dir);
+    std::string dir = userDir();
     std::string path = outPath.empty() ? (dir + "/" + moduleName + "-overlay.svg") : outPath;
     std::ofstream f(path, std::ios::binary); if (!f) return false;
     f << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
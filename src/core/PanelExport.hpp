@@ -1,5 +1,7 @@
 #pragma once
 #include "../plugin.hpp"
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <string>
 
@@ -8,18 +10,6 @@
 // Behavior MUST remain identical to the original inline implementation (file names, styles, geometry, math).
 // (Overlay export helper from original file is defined elsewhere; only panel snapshot API is required here.)
 
-namespace PanelExport {
-    // Export a rich panel snapshot SVG that embeds the panel artwork plus simplified component geometry
-    // (knob bodies + pointer angle, switches, buttons, jacks, LEDs). The output path is the same location
-    // and naming scheme as the original implementation unless outPath is explicitly provided.
-    // Returns true on success (file created) and false on failure to open the output file.
-    bool exportPanelSnapshot(rack::app::ModuleWidget* mw,
-                             const std::string& moduleName,
-                             const std::string& panelSvgRelPath,
-                             const std::string& outPath = "");
-
-}
-
 // ----------------------------------------------------------------------------
 // Overlay export support (migrated from original inline static implementation
 // in PolyQuanta.cpp). The goal is to centralize the logic while keeping the
@@ -40,6 +30,70 @@ namespace hi { namespace ui { namespace overlay {
     }
 }}} // namespace hi::ui::overlay
 
+namespace PanelExport {
+    // User-folder output directory shared by the exporters (<user>/<plugin slug>/overlays),
+    // created on demand. Other per-module dumps (e.g. diagnostics) write here as well.
+    std::string userDir();
+
+    // Export a rich panel snapshot SVG that embeds the panel artwork plus simplified component geometry
+    // (knob bodies + pointer angle, switches, buttons, jacks, LEDs). The output path is the same location
+    // and naming scheme as the original implementation unless outPath is explicitly provided.
+    // Returns true on success (file created) and false on failure to open the output file.
+    bool exportPanelSnapshot(rack::app::ModuleWidget* mw,
+                             const std::string& moduleName,
+                             const std::string& panelSvgRelPath,
+                             const std::string& outPath = "");
+
+    // ------------------------------------------------------------------------
+    // Batch export: snapshot + overlay for many modules in one pass each.
+    // capture() walks a widget once on the UI thread (geometry, knob values)
+    // and keeps everything the files need; writeJob() then touches only the
+    // filesystem, streaming the panel artwork (hi::ui::svg::copyInner), so a
+    // Batch can run it on worker threads while the UI keeps drawing.
+    // ------------------------------------------------------------------------
+    struct Job {
+        std::string moduleName;
+        std::string panelPath;                      // Absolute path of the panel artwork SVG
+        std::string snapshotPath, overlayPath;      // "" = default names in userDir()
+        float wMM = 0.f, hMM = 0.f;
+        std::string components;                     // Body of the snapshot's <g id="components">
+        std::vector<hi::ui::overlay::Marker> marks; // Overlay markers from the same widget walk
+    };
+    Job capture(rack::app::ModuleWidget* mw,
+                const std::string& moduleName,
+                const std::string& panelSvgRelPath,
+                const std::string& outPath = "");
+    // File work only (safe off the UI thread). writeJob = snapshot + overlay.
+    bool writeSnapshot(const Job& job);
+    bool writeJob(const Job& job);
+
+    // Every FUNmodules widget in the current patch (repeated modules get "-2", "-3", ...
+    // suffixes), or one preview widget per registered model. Panels are "res/<slug>.svg".
+    std::vector<Job> capturePatch();
+    std::vector<Job> captureModels();
+
+    // Worker pool over a job list; progress counters may be read from any thread.
+    class Batch {
+    public:
+        explicit Batch(std::vector<Job> jobs, int threads = 0);   // 0 = one per core, at most 4
+        ~Batch();                                                 // Waits for the running writes
+        int total() const { return (int)jobs.size(); }
+        int done() const { return doneCount.load(); }
+        int failed() const { return failCount.load(); }
+        bool finished() const { return done() == total(); }
+    private:
+        void run();
+        std::vector<Job> jobs;
+        std::atomic<int> next{0}, doneCount{0}, failCount{0};
+        std::vector<std::thread> pool;
+    };
+    // Start a batch unless the previous one is still writing (false then); the last batch
+    // stays readable through batch() for progress labels. UI thread only.
+    bool startBatch(std::vector<Job> jobs);
+    const Batch* batch();
+}
+
+
 namespace PanelExport {
     // Export an overlay-only SVG (outline + component circles / crosses).
     // Mirrors the original static inline function signature and default.
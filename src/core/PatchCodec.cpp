@@ -0,0 +1,76 @@
+#include "PatchCodec.hpp"
+#include <cstring>
+/*
+ * PatchCodec.cpp — Base64 bitsets and flag packing for the compact schema.
+ */
+namespace hi { namespace util { namespace patch {
+namespace {
+const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int sextet(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+} // namespace
+
+std::string encodeBits(const std::vector<uint8_t>& mask) {
+    std::vector<uint8_t> bytes((mask.size() + 7) / 8, 0);
+    for (size_t d = 0; d < mask.size(); ++d)
+        if (mask[d]) bytes[d >> 3] |= (uint8_t)(1u << (d & 7));
+    std::string out;
+    out.reserve((bytes.size() + 2) / 3 * 4);
+    for (size_t i = 0; i < bytes.size(); i += 3) {
+        const size_t left = bytes.size() - i;
+        uint32_t w = (uint32_t)bytes[i] << 16;
+        if (left > 1) w |= (uint32_t)bytes[i + 1] << 8;
+        if (left > 2) w |= bytes[i + 2];
+        out.push_back(kAlphabet[(w >> 18) & 63]);
+        out.push_back(kAlphabet[(w >> 12) & 63]);
+        out.push_back(left > 1 ? kAlphabet[(w >> 6) & 63] : '=');
+        out.push_back(left > 2 ? kAlphabet[w & 63] : '=');
+    }
+    return out;
+}
+
+bool decodeBits(const char* text, int n, std::vector<uint8_t>& out) {
+    if (!text || n < 0) return false;
+    const size_t len = std::strlen(text);
+    const size_t nbytes = ((size_t)n + 7) / 8;
+    if (len != (nbytes + 2) / 3 * 4) return false;
+    std::vector<uint8_t> bytes;
+    bytes.reserve(nbytes + 2);
+    for (size_t i = 0; i < len; i += 4) {
+        uint32_t w = 0;
+        int pad = 0;
+        for (size_t k = 0; k < 4; ++k) {
+            const char c = text[i + k];
+            int v = 0;
+            if (c == '=' && i + 4 == len && k >= 2) ++pad;             // Padding only at the tail
+            else if (pad || (v = sextet(c)) < 0) return false;
+            w = (w << 6) | (uint32_t)v;
+        }
+        bytes.push_back((uint8_t)(w >> 16));
+        if (pad < 2) bytes.push_back((uint8_t)(w >> 8));
+        if (pad < 1) bytes.push_back((uint8_t)w);
+    }
+    if (bytes.size() != nbytes) return false;
+    out.assign((size_t)n, 0);
+    for (int d = 0; d < n; ++d) out[(size_t)d] = (uint8_t)((bytes[(size_t)d >> 3] >> (d & 7)) & 1u);
+    return true;
+}
+
+uint32_t packFlags(const bool* flags, int n) {
+    uint32_t bits = 0;
+    for (int i = 0; i < n && i < 32; ++i)
+        if (flags[i]) bits |= 1u << i;
+    return bits;
+}
+
+void unpackFlags(uint32_t bits, bool* flags, int n) {
+    for (int i = 0; i < n && i < 32; ++i) flags[i] = ((bits >> i) & 1u) != 0;
+}
+}}} // namespace hi::util::patch
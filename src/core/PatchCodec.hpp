@@ -0,0 +1,35 @@
+#pragma once
+/*
+ * PatchCodec.hpp — Encodings for PolyQuanta's compact patch schema.
+ *
+ * The legacy schema (schema 1, no "schema" key) writes one JSON key per
+ * channel flag and a JSON integer per mask degree. The opt-in compact schema
+ * (kCompactSchema) is not a superset of it: per-channel flags go out only as
+ * one packed integer bitfield, masks only as base64 bitsets, and keys holding
+ * their default are left out; the legacy per-channel keys (qzEnabledN,
+ * postOctShiftN, the lock/allow keys, snapOffsets, rndTimeRaw) are not written.
+ * Readers here take the packed key when present and fall back to the legacy
+ * keys, so schema 1 patches load everywhere, but compact patches need a reader
+ * that knows schema 2; older builds fall back to defaults for the packed fields.
+ *
+ * Rack-free (no jansson) so the encodings are covered by the core tests;
+ * PolyQuanta.cpp and coreToJson/coreFromJson do the JSON plumbing.
+ */
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hi { namespace util { namespace patch {
+static constexpr int kCompactSchema = 2;     // "schema" value written by the compact writer
+
+// Degree d of the mask is bit (d & 7) of byte d >> 3; the bytes go out as RFC 4648 base64
+// with padding. A 120-EDO mask is 20 characters instead of ~240 for the integer array.
+std::string encodeBits(const std::vector<uint8_t>& mask);
+// Inverse of encodeBits for an n-degree mask. False (out untouched) on bad characters or a
+// length that does not match n; bits past n in the last byte are ignored.
+bool decodeBits(const char* text, int n, std::vector<uint8_t>& out);
+
+// Per-channel flags as a bitfield: bit i = flags[i] (n <= 32).
+uint32_t packFlags(const bool* flags, int n);
+void unpackFlags(uint32_t bits, bool* flags, int n);
+}}} // namespace hi::util::patch
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <limits>
 #include <climits> // relocated MOS uses INT_MAX
+#include <cstring> // QuantPlan mask compare
 #include "ScaleDefs.hpp" // centralized scale definitions (single source of truth)
 
 namespace hi { namespace dsp {
@@ -67,23 +68,14 @@ float snapEDO(float volts, const QuantConfig& qc, float boundLimit, bool boundTo
     // FIX: nearest ALLOWED step (root-relative), then feed hysteresis
     int quantStep = _nearestAllowedStepRoot(baseStep, rawSteps, qc);
 
-    // Bound quantized step within a symmetric range if requested.
+    // Bound quantized step within a symmetric range if requested (clamp to precomputed extremes).
+    // The window check is O(1); the allowed extremes are only needed once the step falls outside it.
     if (boundToLimit) {
-        // Compute min/max step that map inside ±boundLimit volts.
-        int maxStep = (int)std::floor(boundLimit * stepsPerVolt);
-        int minStep = -maxStep;
-        if (quantStep > maxStep) {
-            bool found = false;
-            for (int step = maxStep; step >= minStep; --step) {
-                if (_isAllowedStepRootRel(step, qc)) { quantStep = step; found = true; break; }
-            }
-            if (!found) quantStep = maxStep; // fallback: behave like legacy clamp
-        } else if (quantStep < minStep) {
-            bool found = false;
-            for (int step = minStep; step <= maxStep; ++step) {
-                if (_isAllowedStepRootRel(step, qc)) { quantStep = step; found = true; break; }
-            }
-            if (!found) quantStep = minStep; // fallback: behave like legacy clamp
+        const int maxStep = (int)std::floor(boundLimit * stepsPerVolt), minStep = -maxStep;
+        if (quantStep > maxStep || quantStep < minStep) {
+            const QuantBound b = (qc.boundCache && qc.boundCache->limit == boundLimit) ? *qc.boundCache
+                                                                                      : computeQuantBound(qc, boundLimit);
+            quantStep = (quantStep > maxStep) ? b.hiStep : b.loStep;
         }
     }
 
@@ -91,6 +83,21 @@ float snapEDO(float volts, const QuantConfig& qc, float boundLimit, bool boundTo
     float snapped = ((float)quantStep - (float)shiftSteps) / stepsPerVolt; // do not remove root; keep absolute pitch
     return snapped;
 }
+// Highest/lowest allowed step inside ±limit, exactly as snapEDO's former linear scans found
+// them (window edge when none). The mask repeats every edo steps, so at most edo candidates
+// per side need checking instead of the whole window.
+QuantBound computeQuantBound(const QuantConfig& qc, float limit) {
+    QuantBound b; b.limit = limit;
+    const float stepsPerVolt = (float)qc.edo / qc.periodOct; // same expression as snapEDO
+    b.maxStep = (int)std::floor(limit * stepsPerVolt);
+    b.minStep = -b.maxStep;
+    const int period = (qc.edo > 0 ? qc.edo : 12);
+    const int span = std::min(period, b.maxStep - b.minStep + 1);
+    b.hiStep = b.maxStep; b.loStep = b.minStep;               // fallback: behave like legacy clamp
+    for (int k = 0; k < span; ++k) if (_isAllowedStepRootRel(b.maxStep - k, qc)) { b.hiStep = b.maxStep - k; break; }
+    for (int k = 0; k < span; ++k) if (_isAllowedStepRootRel(b.minStep + k, qc)) { b.loStep = b.minStep + k; break; }
+    return b;
+}
 // Return whether pitch-class step s is allowed under qc (root/mask aware)
 bool isAllowedStep(int s, const QuantConfig& qc) {
     int N = (qc.edo <= 0) ? 12 : qc.edo; 
@@ -141,10 +148,131 @@ int nearestAllowedStepWithHistory(int sGuess, float fs, const QuantConfig& qc, i
     }
     return candidate;
 }
+
+// QuantPlan: one-time table build (runs on config change only, never per sample)
+void QuantPlan::build(int edo, float period, int rootStep, const uint8_t* maskData, int maskLen,
+                      const float* degrees, float tonicVolts) {
+    N = (edo <= 0) ? 12 : edo;
+    periodOct = period;
+    root = _modWrap(rootStep, N);
+    stepsPerVolt = (float)N / periodOct;
+    degree.clear(); bucketLo.clear(); tonic = 0.f;
+    if (degrees && periodOct > 0.f) {
+        degree.assign(degrees, degrees + N);
+        degree.push_back(periodOct);
+        tonic = tonicVolts;
+        const int B = 4 * N;
+        bucketLo.resize((size_t)B);
+        for (int b = 0, i = 0; b < B; ++b) {
+            const float x = periodOct * (float)b / (float)B;
+            while (i + 1 < N && degree[(size_t)i + 1] <= x) ++i;
+            bucketLo[(size_t)b] = i;
+        }
+    }
+    chromatic = !(maskData && maskLen == N);
+    anyAllowed = true;
+    mask.assign(chromatic ? nullptr : maskData, chromatic ? nullptr : maskData + maskLen);
+    allowed.assign((size_t)N, 1);
+    upDist.assign((size_t)N, 1);
+    dnDist.assign((size_t)N, 1);
+    const float span = std::ceil((kStepVoltsRange + std::fabs(tonic)) * stepsPerVolt);
+    stepVoltsSpan = (span > 0.f) ? ((span < (float)kMaxStepVoltsSpan) ? (int)span : kMaxStepVoltsSpan) : 0;
+    stepVolts.clear();                                   // volts() uses the formula while the table fills
+    std::vector<float> table((size_t)(2 * stepVoltsSpan + 1));
+    for (int s = -stepVoltsSpan; s <= stepVoltsSpan; ++s) table[(size_t)(s + stepVoltsSpan)] = volts(s);
+    stepVolts.swap(table);
+    if (chromatic) return;
+    anyAllowed = false;
+    for (int pc = 0; pc < N; ++pc) {
+        allowed[(size_t)pc] = mask[(size_t)_modWrap(pc - root, N)] ? 1 : 0; // rotate into absolute pitch classes
+        anyAllowed = anyAllowed || allowed[(size_t)pc];
+    }
+    // Distances scan k = 1..N exactly like nextAllowedStep (k = N lands on the same pc one period away)
+    for (int pc = 0; pc < N; ++pc) {
+        int up = 0, dn = 0;
+        for (int k = 1; k <= N && (!up || !dn); ++k) {
+            if (!up && allowed[(size_t)_modWrap(pc + k, N)]) up = k;
+            if (!dn && allowed[(size_t)_modWrap(pc - k, N)]) dn = k;
+        }
+        upDist[(size_t)pc] = up;
+        dnDist[(size_t)pc] = dn;
+    }
+}
+
+bool QuantPlan::matches(int edo, float period, int rootStep, const uint8_t* maskData, int maskLen,
+                        const float* degrees, float tonicVolts) const {
+    const int n = (edo <= 0) ? 12 : edo;
+    if (n != N || period != periodOct || _modWrap(rootStep, n) != root) return false;
+    const bool w = degrees && period > 0.f;
+    if (w != warped()) return false;
+    if (w && (tonicVolts != tonic || std::memcmp(degree.data(), degrees, sizeof(float) * (size_t)n) != 0)) return false;
+    const bool chrom = !(maskData && maskLen == n);
+    if (chrom != chromatic) return false;
+    return chrom || std::memcmp(mask.data(), maskData, (size_t)n) == 0;
+}
+
+QuantConfig QuantPlan::config() const {
+    QuantConfig qc;
+    qc.edo = N; qc.periodOct = periodOct; qc.root = root;
+    qc.useCustom = !chromatic; qc.customFollowsRoot = true;
+    if (!chromatic) { qc.customMaskGeneric = mask.data(); qc.customMaskLen = N; }
+    return qc;
+}
+
+int QuantPlan::nearest(float fs) const {
+    const int s0 = (int)std::round(fs);
+    if (!anyAllowed || isAllowed(s0)) return s0;
+    const int pc = pcOf(s0);
+    const int du = upDist[(size_t)pc], dd = dnDist[(size_t)pc];
+    const int up = s0 + du, dn = s0 - dd;
+    // The scan visits the closer ring first (up before down on equal rings); a later
+    // candidate only wins when strictly nearer, reproducing nearestAllowedStep ties.
+    const int first = (du <= dd) ? up : dn, second = (du <= dd) ? dn : up;
+    return (std::fabs(fs - (float)second) < std::fabs(fs - (float)first)) ? second : first;
+}
+
+float QuantPlan::snap(float volts) const {
+    const float rawSteps = toSteps(volts);
+    return this->volts(nearest(rawSteps));
+}
+
+double QuantPlan::stepPos(float volts) const {
+    const double r = ((double)volts - (double)tonic) / (double)periodOct;  // Periods above step 0
+    const double k = std::floor(r);
+    const double x = (r - k) * (double)periodOct;                           // Offset inside the period
+    const int B = (int)bucketLo.size();
+    int b = (int)((r - k) * (double)B);
+    if (b >= B) b = B - 1;
+    int i = bucketLo[(size_t)b];                                            // Uniform bucket: O(1) on average
+    while (i > 0 && (double)degree[(size_t)i] > x) --i;                     // Float bucket edge vs double x
+    while (i + 1 < N && (double)degree[(size_t)i + 1] <= x) ++i;
+    const double lo = degree[(size_t)i], hi = degree[(size_t)i + 1];
+    return k * (double)N + (double)i + ((hi > lo) ? (x - lo) / (hi - lo) : 0.0);
+}
+
+QuantBound QuantPlan::bound(float limit) const {
+    QuantBound b; b.limit = limit;
+    b.maxStep = (int)std::floor(toSteps(limit));
+    b.minStep = warped() ? (int)std::ceil(toSteps(-limit)) : -b.maxStep;
+    // snapEDO scans maxStep→minStep (resp. minStep→maxStep) for the first allowed step and
+    // falls back to the window edge; next() gives the same answer from the tables.
+    auto scan = [&](int edge, int dir) -> int {
+        if (isAllowed(edge)) return edge;
+        const int s = next(edge, dir);
+        const bool inside = (s != edge) && s >= b.minStep && s <= b.maxStep;
+        return inside ? s : edge;
+    };
+    b.hiStep = scan(b.maxStep, -1);
+    b.loStep = scan(b.minStep, +1);
+    return b;
+}
 }} // namespace hi::dsp
 #include <unordered_set>
 #include <set>
 #include <map>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 // -----------------------------------------------------------------------------
 // Phase 4A (relocated): MOS helpers (verbatim logic) + poly::processWidth.
@@ -174,8 +302,177 @@ const std::map<int, std::vector<int>> curated = {
 int gcdInt(int a, int b){ while(b){ int t=a%b; a=b; b=t;} return a<0?-a:a; }
 std::vector<int> generateCycle(int N, int g, int m){ std::vector<int> pcs; pcs.reserve(m); std::unordered_set<int> seen; for(int k=0;k<m;++k){ int v=((long long)k*g)%N; if(seen.insert(v).second) pcs.push_back(v); else break; } std::sort(pcs.begin(),pcs.end()); return pcs; }
 bool isMOS(const std::vector<int>& pcs, int N){ if(pcs.size()<2) return false; std::set<int> steps; for(size_t i=0;i<pcs.size();++i){ int a=pcs[i]; int b=pcs[(i+1)%pcs.size()]; int step=(i+1<pcs.size()? b-a : (N-a+b)); if(step<=0) step+=N; steps.insert(step); if(steps.size()>2) return false; } return true; }
-int findBestGenerator(int N, int m){ if(m<2) return 1; if(m>N) m=N; struct Cand{int g; int diff; float dist;} best{0,INT_MAX,1e9f}; for(int g=1; g<N; ++g){ if(gcdInt(g,N)!=1) continue; auto cyc=generateCycle(N,g,m); if((int)cyc.size()!=m) continue; if(!isMOS(cyc,N)) continue; auto bal = [&](){ std::map<int,int> freq; int M=(int)cyc.size(); for(int i=0;i<M;++i){ int a=cyc[i]; int b=cyc[(i+1)%M]; int step=(i+1<M? b-a : (N-a+b)); if(step<=0) step+=N; freq[step]++; } if(freq.size()==1) return std::pair<int,float>{0,0.f}; if(freq.size()==2){ auto it=freq.begin(); int c1=it->second; ++it; int c2=it->second; return std::pair<int,float>{std::abs(c1-c2),0.f}; } return std::pair<int,float>{1000,0.f}; }(); int diff=bal.first; float gn=(float)g/N; float dist=std::min(std::fabs(gn-7.f/12.f), std::fabs(gn-3.f/12.f)); if(diff<best.diff || (diff==best.diff && dist<best.dist)) best={g,diff,dist}; } if(best.g) return best.g; int cand[2]={ std::max(1,std::min(N-1,(int)std::lround(N*7.0/12.0))), std::max(1,std::min(N-1,(int)std::lround(N*3.0/12.0))) }; for(int g: cand){ if(gcdInt(g,N)!=1) continue; auto cyc=generateCycle(N,g,m); if((int)cyc.size()==m) return g; } return 1; }
+int findBestGeneratorRef(int N, int m){ if(m<2) return 1; if(m>N) m=N; struct Cand{int g; int diff; float dist;} best{0,INT_MAX,1e9f}; for(int g=1; g<N; ++g){ if(gcdInt(g,N)!=1) continue; auto cyc=generateCycle(N,g,m); if((int)cyc.size()!=m) continue; if(!isMOS(cyc,N)) continue; auto bal = [&](){ std::map<int,int> freq; int M=(int)cyc.size(); for(int i=0;i<M;++i){ int a=cyc[i]; int b=cyc[(i+1)%M]; int step=(i+1<M? b-a : (N-a+b)); if(step<=0) step+=N; freq[step]++; } if(freq.size()==1) return std::pair<int,float>{0,0.f}; if(freq.size()==2){ auto it=freq.begin(); int c1=it->second; ++it; int c2=it->second; return std::pair<int,float>{std::abs(c1-c2),0.f}; } return std::pair<int,float>{1000,0.f}; }(); int diff=bal.first; float gn=(float)g/N; float dist=std::min(std::fabs(gn-7.f/12.f), std::fabs(gn-3.f/12.f)); if(diff<best.diff || (diff==best.diff && dist<best.dist)) best={g,diff,dist}; } if(best.g) return best.g; int cand[2]={ std::max(1,std::min(N-1,(int)std::lround(N*7.0/12.0))), std::max(1,std::min(N-1,(int)std::lround(N*3.0/12.0))) }; for(int g: cand){ if(gcdInt(g,N)!=1) continue; auto cyc=generateCycle(N,g,m); if((int)cyc.size()==m) return g; } return 1; }
 std::string patternLS(const std::vector<int>& pcs, int N){ if(pcs.size()<2) return ""; std::vector<int> steps; for(size_t i=0;i<pcs.size();++i){ int a=pcs[i]; int b=pcs[(i+1)%pcs.size()]; int step=(i+1<pcs.size()? b-a : (N-a+b)); if(step<=0) step+=N; steps.push_back(step);} int mn=*std::min_element(steps.begin(),steps.end()); int mx=*std::max_element(steps.begin(),steps.end()); std::string out; out.reserve(steps.size()); for(int s:steps) out.push_back((mx!=mn && s==mx)?'L':'S'); return out; }
+
+int findBestGenerator(int N, int m){
+    if(m<2) return 1;
+    if(m>N) m=N;
+    if(const memo::Entry* e = memo::get(N, m)) return e->best;
+    return findBestGeneratorRef(N, m);                          // Beyond the memo range
+}
+
+namespace memo {
+std::string Entry::pattern(int g) const {
+    std::string out;
+    if(g<1 || g>=N || size[g]<2) return out;
+    out.reserve(size[g]);
+    for(int i=0;i<size[g];++i) out.push_back(large[g][(size_t)i] ? 'L' : 'S');
+    return out;
+}
+
+std::vector<int> Entry::pcs(int g) const {
+    std::vector<int> out;
+    if(g<1 || g>=N) return out;
+    out.reserve(size[g]);
+    for(int p=0;p<N;++p) if(cycle[g][(size_t)p]) out.push_back(p);
+    return out;
+}
+
+// Same results as generateCycle/isMOS/patternLS/findBestGeneratorRef, without node containers.
+static void fill(Entry& e, int N, int m){
+    e.N = N; e.m = m;
+    struct Cand{int g; int diff; float dist;} best{0,INT_MAX,1e9f};
+    for(int g=1; g<N; ++g){
+        Bits& cyc = e.cycle[g];
+        int n = 0;
+        for(int k=0;k<m;++k){ int v=(int)(((long long)k*g)%N); if(cyc[(size_t)v]) break; cyc.set((size_t)v); ++n; }
+        e.size[g] = (uint8_t)n;
+        if(n<2) continue;
+        // Steps between consecutive (ascending) pitch classes, closing the octave
+        int steps[kMaxN]; int first=-1, prev=-1, k=0;
+        for(int p=0;p<N;++p){ if(!cyc[(size_t)p]) continue; if(first<0) first=p; else steps[k++]=p-prev; prev=p; }
+        steps[k++] = N-prev+first;
+        int s1=steps[0], s2=-1, c1=0, c2=0, mn=steps[0], mx=steps[0]; bool mos=true;
+        for(int i=0;i<k;++i){
+            mn=std::min(mn,steps[i]); mx=std::max(mx,steps[i]);
+            if(steps[i]==s1) ++c1;
+            else if(s2<0 || steps[i]==s2){ s2=steps[i]; ++c2; }
+            else mos=false;
+        }
+        if(mx!=mn) for(int i=0;i<k;++i) if(steps[i]==mx) e.large[g].set((size_t)i);
+        if(!mos) continue;
+        e.mos.set((size_t)g);
+        if(gcdInt(g,N)!=1 || n!=m) continue;
+        int diff = (s2<0) ? 0 : std::abs(c1-c2);
+        float gn=(float)g/N; float dist=std::min(std::fabs(gn-7.f/12.f), std::fabs(gn-3.f/12.f));
+        if(diff<best.diff || (diff==best.diff && dist<best.dist)) best={g,diff,dist};
+    }
+    if(best.g){ e.best = best.g; return; }
+    int cand[2]={ std::max(1,std::min(N-1,(int)std::lround(N*7.0/12.0))), std::max(1,std::min(N-1,(int)std::lround(N*3.0/12.0))) };
+    for(int g: cand){ if(gcdInt(g,N)!=1) continue; if(e.size[g]==m){ e.best = g; return; } }
+    e.best = 1;
+}
+
+const Entry* get(int N, int m){
+    if(m<2 || m>N || N>kMaxN) return nullptr;
+    // Double-checked: published entries are immutable, the mutex only serializes fills
+    static std::atomic<const Entry*> table[(kMaxN + 1) * (kMaxN + 1)];
+    static std::mutex fillMutex;
+    static std::vector<std::unique_ptr<Entry>> owned;             // Freed at exit
+    std::atomic<const Entry*>& slot = table[N * (kMaxN + 1) + m];
+    if(const Entry* e = slot.load(std::memory_order_acquire)) return e;
+    std::lock_guard<std::mutex> lock(fillMutex);
+    if(const Entry* e = slot.load(std::memory_order_relaxed)) return e;
+    owned.emplace_back(new Entry());
+    fill(*owned.back(), N, m);
+    slot.store(owned.back().get(), std::memory_order_release);
+    return owned.back().get();
+}
+} // namespace memo
+
+uint64_t MaskState::zobrist(int p){
+    uint64_t z = 0x9E3779B97F4A7C15ull * (uint64_t)(p + 1);   // splitmix64 finalizer of the index
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void MaskState::step(int size, int delta){
+    const int before = stepHist[size];
+    stepHist[size] = (uint8_t)(before + delta);
+    if(before == 0) ++distinct;
+    else if(before + delta == 0) --distinct;
+}
+
+// First set bit in [from, to) / last set bit in [to, from]; -1 if none. At most kWords words.
+static int scanUp(const uint64_t* w, int from, int to){
+    for(int q = from; q < to; q = ((q >> 6) + 1) << 6){
+        const uint64_t x = w[q >> 6] >> (q & 63);
+        if(x){ const int r = q + __builtin_ctzll(x); return r < to ? r : -1; }
+    }
+    return -1;
+}
+static int scanDown(const uint64_t* w, int from, int to){
+    for(int q = from; q >= to; q = ((q >> 6) << 6) - 1){
+        const uint64_t x = w[q >> 6] << (63 - (q & 63));
+        if(x){ const int r = q - __builtin_clzll(x); return r >= to ? r : -1; }
+    }
+    return -1;
+}
+
+int MaskState::nextSet(int p) const {
+    int q = scanUp(words, p + 1, N);
+    if(q < 0) q = scanUp(words, 0, p + 1);                    // Wrap past the octave
+    return q < 0 ? p : q;
+}
+
+int MaskState::prevSet(int p) const {
+    int q = scanDown(words, p - 1, 0);
+    if(q < 0) q = scanDown(words, N - 1, p);
+    return q < 0 ? p : q;
+}
+
+void MaskState::toggle(int p){
+    if(p < 0 || p >= N) return;
+    const bool on = !test(p);
+    words[p >> 6] ^= (uint64_t)1 << (p & 63);
+    hash ^= zobrist(p);
+    auto dist = [this](int a, int b){ const int d = (b - a + N) % N; return d == 0 ? N : d; };
+    if(on){
+        if(count > 0){
+            const int a = prevSet(p), b = nextSet(p);             // Neighbours around the new degree
+            step(dist(a, b), -1); step(dist(a, p), +1); step(dist(p, b), +1);
+        } else step(N, +1);                                       // Lone pitch class: one full-period step
+        ++count;
+    } else {
+        --count;
+        if(count > 0){
+            const int a = prevSet(p), b = nextSet(p);             // p is already cleared
+            step(dist(a, p), -1); step(dist(p, b), -1); step(dist(a, b), +1);
+        } else step(N, -1);
+    }
+}
+
+bool MaskState::assign(const uint8_t* mask, int len, int n){
+    *this = MaskState();
+    if(n < 1 || n > memo::kMaxN) return false;
+    N = n;
+    for(int p = 0; p < n && p < len; ++p) if(mask[p]) toggle(p);
+    return true;
+}
+
+memo::Bits MaskState::bits() const {
+    memo::Bits b;
+    for(int w = kWords - 1; w >= 0; --w){ b <<= 64; b |= memo::Bits(words[w]); }
+    return b;
+}
+
+bool detect(const MaskState& ms, int N, int& mOut, int& gOut){
+    if(N < 2 || N > 24 || ms.N != N) return false;
+    int m = ms.count;                                             // Number of scale steps
+    if(m < 2 || m > 24) return false;
+    if(ms.distinct > 3) return false;                             // Three-distance theorem
+    const memo::Entry* e = memo::get(N, m);
+    if(!e) return false;
+    const memo::Bits want = ms.bits();
+    for(int g = 1; g < N; ++g){
+        if(gcdInt(g, N) != 1) continue;                           // Coprime generators only
+        if((int)e->size[g] != m) continue;
+        if(e->cycle[g] == want){ mOut = m; gOut = g; return true; }
+    }
+    return false;
+}
 }}} // namespace hi::music::mos
 
 namespace hi { namespace dsp { namespace poly {
@@ -312,6 +609,14 @@ float shapeMul(float u, const ShapeParams& p, float eps) {
     float out = p.c * m;
     return out < eps ? eps : out;
 }
+// ShapeLUT rebuild: O(kSize) shapeMul evaluations, only on shape change.
+bool ShapeLUT::update(float shapeIn, float epsIn) {
+    if (valid && shapeIn == shape && epsIn == eps) return false;
+    shape = shapeIn; eps = epsIn; valid = true;
+    params = makeShape(shape);
+    for (int i = 0; i <= kSize; ++i) tbl[i] = shapeMul((float)i / (float)kSize, params, eps);
+    return true;
+}
 }}} // namespace hi::dsp::glide
 
 // range helpers ensure voltages stay inside ±clipLimit before quantization.
@@ -347,38 +652,60 @@ float apply(float v, Mode mode, float clipLimit, bool soft) {
 // identical JSON for quantization-related fields.
 // -----------------------------------------------------------------------------
 #if !defined(UNIT_TESTS)
+#include "PatchCodec.hpp"
 namespace hi { namespace dsp {
-void coreToJson(json_t* root, const CoreState& s) noexcept {
+void coreToJson(json_t* root, const CoreState& s, bool compact) noexcept {
+    const CoreState def;
+    // Compact schema: a field still at its CoreState default is left out (coreFromJson keeps the default)
+    auto setInt=[&](const char* k, int v, int d){ if (!compact || v != d) json_object_set_new(root, k, json_integer(v)); };
+    auto setReal=[&](const char* k, float v, float d){ if (!compact || v != d) json_object_set_new(root, k, json_real(v)); };
     // Quantization meta
-    json_object_set_new(root, "quantStrength", json_real(s.quantStrength));
-    json_object_set_new(root, "quantRoundMode", json_integer(s.quantRoundMode));
-    json_object_set_new(root, "stickinessCents", json_real(s.stickinessCents));
+    setReal("quantStrength", s.quantStrength, def.quantStrength);
+    setInt("quantRoundMode", s.quantRoundMode, def.quantRoundMode);
+    setReal("stickinessCents", s.stickinessCents, def.stickinessCents);
     // Tuning system
-    json_object_set_new(root, "edo", json_integer(s.edo));
-    json_object_set_new(root, "tuningMode", json_integer(s.tuningMode));
-    json_object_set_new(root, "tetSteps", json_integer(s.tetSteps));
-    json_object_set_new(root, "tetPeriodOct", json_real(s.tetPeriodOct));
+    setInt("edo", s.edo, def.edo);
+    setInt("tuningMode", s.tuningMode, def.tuningMode);
+    setInt("tetSteps", s.tetSteps, def.tetSteps);
+    setReal("tetPeriodOct", s.tetPeriodOct, def.tetPeriodOct);
     // Custom scale flags
-    json_object_set_new(root, "useCustomScale", s.useCustomScale ? json_true() : json_false());
+    if (!compact || s.useCustomScale != def.useCustomScale)
+        json_object_set_new(root, "useCustomScale", s.useCustomScale ? json_true() : json_false());
     // Custom mask
     if (!s.customMaskGeneric.empty()) {
-        json_t* arr = json_array();
-        for (size_t i = 0; i < s.customMaskGeneric.size(); ++i)
-            json_array_append_new(arr, json_integer((int)s.customMaskGeneric[i]));
         json_object_set_new(root, "customMaskGenericN", json_integer((int)s.customMaskGeneric.size()));
-        json_object_set_new(root, "customMaskGeneric", arr);
+        if (compact) {
+            json_object_set_new(root, "customMaskBits", json_string(hi::util::patch::encodeBits(s.customMaskGeneric).c_str()));
+        } else {
+            json_t* arr = json_array();
+            for (size_t i = 0; i < s.customMaskGeneric.size(); ++i)
+                json_array_append_new(arr, json_integer((int)s.customMaskGeneric[i]));
+            json_object_set_new(root, "customMaskGeneric", arr);
+        }
     }
     // Per-channel quantize enables + octave shifts
-    for (int i = 0; i < 16; ++i) {
-        char key[32];
-        std::snprintf(key, sizeof(key), "qzEnabled%d", i+1);
-        json_object_set_new(root, key, s.qzEnabled[i] ? json_true() : json_false());
-        std::snprintf(key, sizeof(key), "postOctShift%d", i+1);
-        json_object_set_new(root, key, json_integer(s.postOctShift[i]));
+    if (compact) {
+        const uint32_t qz = hi::util::patch::packFlags(s.qzEnabled, 16);
+        if (qz) json_object_set_new(root, "qzEnabledBits", json_integer(qz));
+        bool anyShift = false;
+        for (int i = 0; i < 16; ++i) anyShift |= s.postOctShift[i] != 0;
+        if (anyShift) {
+            json_t* arr = json_array();
+            for (int i = 0; i < 16; ++i) json_array_append_new(arr, json_integer(s.postOctShift[i]));
+            json_object_set_new(root, "postOctShiftCh", arr);
+        }
+    } else {
+        for (int i = 0; i < 16; ++i) {
+            char key[32];
+            std::snprintf(key, sizeof(key), "qzEnabled%d", i+1);
+            json_object_set_new(root, key, s.qzEnabled[i] ? json_true() : json_false());
+            std::snprintf(key, sizeof(key), "postOctShift%d", i+1);
+            json_object_set_new(root, key, json_integer(s.postOctShift[i]));
+        }
     }
     // Scale/root
-    json_object_set_new(root, "rootNote", json_integer(s.rootNote));
-    json_object_set_new(root, "scaleIndex", json_integer(s.scaleIndex));
+    setInt("rootNote", s.rootNote, def.rootNote);
+    setInt("scaleIndex", s.scaleIndex, def.scaleIndex);
 }
 
 void coreFromJson(const json_t* root, CoreState& s) noexcept {
@@ -393,9 +720,14 @@ void coreFromJson(const json_t* root, CoreState& s) noexcept {
     getInt("edo", s.edo); getInt("tuningMode", s.tuningMode); getInt("tetSteps", s.tetSteps); getFloat("tetPeriodOct", s.tetPeriodOct);
     // Custom scale flags
     getBool("useCustomScale", s.useCustomScale);
-    // Custom mask
+    // Custom mask: base64 bitset (compact schema) first, then the integer array
     s.customMaskGeneric.clear();
-    if (auto* arr = json_object_get(root, "customMaskGeneric")) {
+    int maskN = -1;
+    getInt("customMaskGenericN", maskN);
+    json_t* bits = json_object_get(root, "customMaskBits");
+    const bool decoded = bits && json_is_string(bits)
+                      && hi::util::patch::decodeBits(json_string_value(bits), maskN, s.customMaskGeneric);
+    if (!decoded) if (auto* arr = json_object_get(root, "customMaskGeneric")) {
         if (json_is_array(arr)) {
             size_t len = json_array_size(arr);
             s.customMaskGeneric.resize(len);
@@ -405,7 +737,7 @@ void coreFromJson(const json_t* root, CoreState& s) noexcept {
             }
         }
     }
-    // Per-channel quantize enable + octave shift
+    // Per-channel quantize enable + octave shift (packed keys win over the per-channel ones)
     for (int i = 0; i < 16; ++i) {
         char key[32];
         std::snprintf(key, sizeof(key), "qzEnabled%d", i+1);
@@ -413,6 +745,16 @@ void coreFromJson(const json_t* root, CoreState& s) noexcept {
         std::snprintf(key, sizeof(key), "postOctShift%d", i+1);
         if (auto* j = json_object_get(root, key)) if (json_is_integer(j)) s.postOctShift[i] = (int)json_integer_value(j);
     }
+    if (auto* j = json_object_get(root, "qzEnabledBits"))
+        if (json_is_integer(j)) hi::util::patch::unpackFlags((uint32_t)json_integer_value(j), s.qzEnabled, 16);
+    if (auto* arr = json_object_get(root, "postOctShiftCh")) {
+        if (json_is_array(arr)) {
+            for (size_t i = 0; i < json_array_size(arr) && i < 16; ++i) {
+                json_t* v = json_array_get(arr, i);
+                if (json_is_integer(v)) s.postOctShift[i] = (int)json_integer_value(v);
+            }
+        }
+    }
     // Scale/root
     getInt("rootNote", s.rootNote); getInt("scaleIndex", s.scaleIndex);
 }
@@ -430,6 +772,19 @@ void coreFromJson(const json_t* root, CoreState& s) noexcept {
 #include <vector>
 #include <iostream> // (Only used in optional diagnostic branches; no output on success.)
 #include "Strum.hpp" // ensure strum namespace visible in test build
+#include "Lanes.hpp" // SoA lane stages (vector vs scalar reference parity)
+#include "PolyQuantaEngine.hpp" // Rack-free signal chain (render/updateWidth)
+#include "Morph.hpp" // glided randomization slots
+#include "Telemetry.hpp" // audio → UI seqlock
+#include "Diagnostics.hpp" // opt-in hot-path counters
+#include "Chain.hpp" // expander frame between adjacent modules
+#include "Scala.hpp" // .scl/.kbm parsing
+#include "ScalePack.hpp" // Binary scale packs
+#include "MenuLabels.hpp" // Context-menu labels and page splits
+#include "Analysis.hpp" // Background tuning analysis
+#include "PatchCodec.hpp" // Compact patch schema encodings
+#include "SvgStream.hpp" // Streaming outer-<svg> strip for panel export
+#include <sstream>
 
 // FIX: file-scope test helper for latch behavior (center-anchored, ±0.5±Hs)
 static int _test_schmittLatch(int lastStep, double fs, int targetStep, float stickinessCents, const hi::dsp::QuantConfig& qc) {
@@ -937,6 +1292,929 @@ int pqtests::run_core_tests() {
     }
 #endif
 
+    // --- QuantPlan_Parity (tables vs scan helpers) ---
+    {
+        // Deterministic LCG so mask coverage is reproducible across runs
+        uint32_t seed = 0x1234567u;
+        auto rnd = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+        const int edos[] = {1, 5, 7, 12, 13, 19, 24, 31, 53, 120};
+        for (int e : edos) {
+            for (int trial = 0; trial < 6; ++trial) {
+                std::vector<uint8_t> mask((size_t)e, 0);
+                // trial 0: empty mask, trial 1: chromatic (no mask), others: random subsets
+                if (trial >= 2) for (int i = 0; i < e; ++i) mask[(size_t)i] = (rnd() % 3 == 0) ? 1 : 0;
+                const bool useMask = (trial != 1);
+                const float period = (trial % 2) ? std::log2(3.f/2.f) : 1.f;
+                const int root = (int)(rnd() % (uint32_t)e) - (trial == 5 ? e : 0); // include negative roots
+                QuantConfig qc; qc.edo = e; qc.periodOct = period; qc.root = root; qc.useCustom = useMask;
+                if (useMask) { qc.customMaskGeneric = mask.data(); qc.customMaskLen = e; }
+                QuantPlan qp; qp.build(e, period, root, useMask ? mask.data() : nullptr, useMask ? e : 0);
+                assert(qp.matches(e, period, root, useMask ? mask.data() : nullptr, useMask ? e : 0));
+                for (int s = -3 * e - 2; s <= 3 * e + 2; ++s) {
+                    assert(qp.isAllowed(s) == isAllowedStep(s, qc));
+                    assert(qp.next(s, +1) == nextAllowedStep(s, +1, qc));
+                    assert(qp.next(s, -1) == nextAllowedStep(s, -1, qc));
+                }
+                for (int k = -400; k <= 400; ++k) {
+                    const float fs = (float)k * 0.0625f * (float)e / 12.f + 0.03125f * (float)(k % 3); // includes exact midpoints
+                    assert(qp.nearest(fs) == nearestAllowedStep(0, fs, qc));
+                    const float v = fs / qp.stepsPerVolt;
+                    _assertClose(qp.snap(v), snapEDO(v, qc, 10.f, false, 0), 0.f, "QuantPlan snap parity");
+                }
+            }
+        }
+        // Bounded snaps (directional nudge path) match snapEDO(boundToLimit) for every range limit
+        {
+            const float limits[] = {10.f, 7.5f, 5.f, 2.5f, 1.f, 0.5f, 0.01f};
+            for (int e : edos) {
+                for (int trial = 0; trial < 4; ++trial) {
+                    std::vector<uint8_t> mask((size_t)e, 0);
+                    if (trial == 2) mask[(size_t)(rnd() % (uint32_t)e)] = 1;         // single degree (far from the edge)
+                    if (trial == 3) for (int i = 0; i < e; ++i) mask[(size_t)i] = (rnd() % 4 == 0) ? 1 : 0;
+                    const bool useMask = (trial != 1);
+                    const float period = (trial == 3) ? std::log2(3.f/2.f) : 1.f;
+                    const int root = (int)(rnd() % (uint32_t)e);
+                    QuantConfig qc; qc.edo = e; qc.periodOct = period; qc.root = root; qc.useCustom = useMask;
+                    if (useMask) { qc.customMaskGeneric = mask.data(); qc.customMaskLen = e; }
+                    QuantPlan qp; qp.build(e, period, root, useMask ? mask.data() : nullptr, useMask ? e : 0);
+                    for (float lim : limits) {
+                        const QuantBound qb = qp.bound(lim);
+                        for (int k = -300; k <= 300; ++k) {
+                            const float v = (float)k * 0.05f + 0.013f * (float)(k % 5);  // ±15 V sweep, beyond every limit
+                            _assertClose(qp.snapBounded(v, qb), snapEDO(v, qc, lim, true, 0), 1e-6f, "QuantPlan bounded snap parity");
+                            // Directional nudge: ±51% of a step from a snapped degree
+                            const float yq = qp.snapBounded(v, qb), nv = 0.51f / qp.stepsPerVolt;
+                            _assertClose(qp.snapBounded(yq + nv, qb), snapEDO(yq + nv, qc, lim, true, 0), 1e-6f, "QuantPlan nudge up parity");
+                            _assertClose(qp.snapBounded(yq - nv, qb), snapEDO(yq - nv, qc, lim, true, 0), 1e-6f, "QuantPlan nudge down parity");
+                        }
+                    }
+                }
+            }
+        }
+        // snapEDO boundToLimit: precomputed extremes (cached or not) match the legacy window scans
+        {
+            auto legacyBound = [](int quantStep, const QuantConfig& qc, float limit) {
+                const float spv = (float)qc.edo / qc.periodOct;
+                int maxStep = (int)std::floor(limit * spv), minStep = -maxStep;
+                if (quantStep > maxStep) {
+                    for (int st = maxStep; st >= minStep; --st) if (isAllowedStep(st, qc)) return st;
+                    return maxStep;
+                } else if (quantStep < minStep) {
+                    for (int st = minStep; st <= maxStep; ++st) if (isAllowedStep(st, qc)) return st;
+                    return minStep;
+                }
+                return quantStep;
+            };
+            const int bigEdos[] = {12, 31, 72, 120};
+            const float limits[] = {10.f, 5.f, 1.f, 0.5f, 0.004f};
+            for (int e : bigEdos) {
+                for (int trial = 0; trial < 4; ++trial) {
+                    std::vector<uint8_t> mask((size_t)e, 0);
+                    if (trial == 1) mask[(size_t)(rnd() % (uint32_t)e)] = 1;         // sparse: one degree
+                    if (trial >= 2) for (int i = 0; i < e; ++i) mask[(size_t)i] = (rnd() % 17 == 0) ? 1 : 0;
+                    QuantConfig qc; qc.edo = e; qc.root = (int)(rnd() % (uint32_t)e); qc.useCustom = true;
+                    qc.customMaskGeneric = mask.data(); qc.customMaskLen = e;
+                    for (float lim : limits) {
+                        const QuantBound qb = computeQuantBound(qc, lim);
+                        QuantConfig qcc = qc; qcc.boundCache = &qb;
+                        for (int k = -240; k <= 240; ++k) {
+                            const float v = (float)k * 0.0625f + 0.01f;
+                            const float spv = (float)e, raw = v * spv;
+                            const int legacy = legacyBound(nearestAllowedStep(0, raw, qc), qc, lim);
+                            _assertClose(snapEDO(v, qc, lim, true, 0), (float)legacy / spv, 1e-6f, "snapEDO bound parity");
+                            _assertClose(snapEDO(v, qcc, lim, true, 0), (float)legacy / spv, 1e-6f, "snapEDO cached bound parity");
+                        }
+                    }
+                }
+            }
+        }
+        // Mask edits must be detected without an explicit invalidation
+        std::vector<uint8_t> m12 = {1,0,1,0,1,1,0,1,0,1,0,1};
+        QuantPlan qp; qp.build(12, 1.f, 2, m12.data(), 12);
+        assert(qp.matches(12, 1.f, 14, m12.data(), 12)); // root compared by pitch class
+        m12[1] = 1; assert(!qp.matches(12, 1.f, 2, m12.data(), 12));
+        assert(!qp.matches(13, 1.f, 2, m12.data(), 12));
+    }
+
+    // --- Lanes_VectorMatchesScalar (SoA stages vs scalar reference) ---
+    {
+        namespace ln = hi::dsp::lanes;
+        uint32_t seed = 0xC0FFEEu;
+        auto frand = [&seed](float lo, float hi) { seed = seed * 1664525u + 1013904223u; return lo + (hi - lo) * (float)(seed >> 8) / 16777216.f; };
+        auto check = [](const float* a, const float* b, int n, const char* ctx) { for (int i = 0; i < n; ++i) _assertClose(a[i], b[i], ln::kParityTol * std::max(1.f, std::fabs(b[i])), ctx); };
+        for (int iter = 0; iter < 400; ++iter) {
+            const int n = 1 + iter % 16;                         // every active-voice count, incl. partial blocks
+            float in[16], off[16], ps[16], po[16], last[16], yf[16];
+            int32_t mode[16], hold[16];
+            for (int c = 0; c < 16; ++c) {
+                in[c] = frand(-12.f, 12.f); off[c] = frand(-10.f, 10.f); ps[c] = frand(-2.f, 2.f); po[c] = frand(-1.f, 1.f);
+                last[c] = frand(-10.f, 10.f); yf[c] = frand(-12.f, 12.f);
+                mode[c] = (int32_t)(frand(0.f, 3.f)); hold[c] = frand(0.f, 1.f) > 0.7f ? 1 : 0;
+                if (c % 5 == 0) off[c] = (float)(int)(off[c] * 24.f) / 24.f + 1.f / 48.f; // exact snap midpoints
+            }
+            ln::TargetParams tp; tp.useGain = (iter % 3) != 0; tp.gain = frand(-10.f, 10.f); tp.globalOffset = frand(-2.f, 2.f);
+            tp.stepsPerVolt = (iter % 4 == 0) ? 12.f : 9.f / std::log2(3.f/2.f);
+            // Sentinels beyond n must stay untouched (partial-block stores)
+            float tv[16], tr[16]; for (int c = 0; c < 16; ++c) tv[c] = tr[c] = 123.f;
+            ln::computeTargets(in, off, mode, ps, po, tp, n, tv);
+            ln::computeTargetsRef(in, off, mode, ps, po, tp, n, tr);
+            check(tv, tr, 16, "lanes computeTargets");
+            float av[16], an[16], ar[16], anr[16]; int32_t sv[16], sr[16];
+            ln::stepError(tr, last, iter & 1, n, av, an, sv);              // same input: isolate this stage
+            ln::stepErrorRef(tr, last, iter & 1, n, ar, anr, sr);
+            check(av, ar, n, "lanes stepError aerrV"); check(an, anr, n, "lanes stepError aerrN");
+            for (int c = 0; c < n; ++c) assert(sv[c] == sr[c]);
+            const float limits[] = {10.f, 7.5f, 5.f, 2.5f, 1.f, 0.5f};
+            const float cl = limits[iter % 6];
+            const hi::dsp::range::Mode rm = (iter & 2) ? hi::dsp::range::Mode::Scale : hi::dsp::range::Mode::Clip;
+            float pv[16], pr[16];
+            ln::preRange(in, rm, cl, iter & 4, n, pv);
+            ln::preRangeRef(in, rm, cl, iter & 4, n, pr);
+            check(pv, pr, n, "lanes preRange");
+            float ov[16], orf[16];
+            ln::finishOutputs(yf, last, hold, iter & 8, 10.f, n, ov);
+            ln::finishOutputsRef(yf, last, hold, iter & 8, 10.f, n, orf);
+            check(ov, orf, n, "lanes finishOutputs");
+        }
+    }
+
+    // --- PolySlew_VectorMatchesScalar (LUT shapes + SoA slew bank vs per-channel reference) ---
+    {
+        using namespace hi::dsp::glide;
+        const float shapes[] = {-1.f, -0.4f, 0.f, 0.25f, 1.f};
+        for (float sh : shapes) {
+            ShapeLUT lut; assert(lut.update(sh, hi::consts::EPS_ERR)); assert(!lut.update(sh, hi::consts::EPS_ERR));
+            ShapeParams p = makeShape(sh);
+            assert(lut.at(1.f) == shapeMul(1.f, p, hi::consts::EPS_ERR));   // steady-state entry is exact
+            for (int i = 0; i <= 100; ++i) {
+                float u = (float)i / 100.f, m = shapeMul(u, p, hi::consts::EPS_ERR);
+                _assertClose(lut.at(u), m, 0.01f * m, "ShapeLUT interpolation");
+            }
+        }
+        uint32_t seed = 0xBADC0DEu;
+        auto frand = [&seed](float lo, float hi) { seed = seed * 1664525u + 1013904223u; return lo + (hi - lo) * (float)(seed >> 8) / 16777216.f; };
+        PolySlew sv, sr;
+        for (int c = 0; c < 16; ++c) { sv.invalidateRates(c); sr.invalidateRates(c); }
+        float tgt[16] = {0}, sec[16], yv[16] = {0}, yr[16] = {0};
+        for (int c = 0; c < 16; ++c) sec[c] = frand(0.001f, 0.05f);
+        const float dt = 1.f / 48000.f;
+        for (int iter = 0; iter < 4000; ++iter) {
+            const int n = 1 + (iter / 250) % 16;
+            if (iter % 250 == 0) { float rs = frand(-1.f, 1.f), fs = frand(-1.f, 1.f); sv.setShapes(rs, fs); sr.setShapes(rs, fs); }
+            if (iter % 97 == 0) for (int c = 0; c < 16; ++c) tgt[c] = frand(-5.f, 5.f);   // new steps mid-glide
+            float remV[16], remR[16]; int32_t act[16];
+            for (int c = 0; c < 16; ++c) { remV[c] = std::fabs(tgt[c] - yv[c]); remR[c] = std::fabs(tgt[c] - yr[c]); act[c] = (c + iter) % 7 != 0; }
+            float ov[16], orf[16]; for (int c = 0; c < 16; ++c) ov[c] = orf[c] = 123.f;
+            sv.process(tgt, remV, sec, act, dt, n, ov);
+            sr.processRef(tgt, remR, sec, act, dt, n, orf);
+            for (int c = 0; c < 16; ++c) {
+                if (c >= n || !act[c]) { assert(ov[c] == 123.f && orf[c] == 123.f); continue; } // inactive lanes untouched
+                _assertClose(ov[c], orf[c], 1e-4f, "PolySlew vector vs ref");
+                yv[c] = ov[c]; yr[c] = orf[c];
+            }
+        }
+    }
+
+    // --- ScaleDefs_PackedPool (lazy Scale arrays match the constexpr bit pool; indices stable) ---
+    {
+        using namespace hi::music;
+        assert(NUM_SCALES_12EDO == 54 && numScalesEDO(12) == 54 && NUM_SCALES_7EDO == 16 && numScalesEDO(0) == 1);
+        const Scale* s12 = scales12EDO();
+        assert(s12 == scalesEDO(12) && s12 == scalesEDO(999));                // materialized once; 12-EDO fallback
+        assert(std::strcmp(s12[44].name, "Scale: Major") == 0);
+        const uint8_t major[12] = {1,0,1,0,1,1,0,1,0,1,0,1};
+        assert(s12[44].mask.size() == 12 && std::memcmp(s12[44].mask.data(), major, 12) == 0);
+        assert(std::strcmp(scales7EDO()[1].name, "Scale: 7-EDO Pentatonic (omit 2,3)") == 0);
+        for (int e = 1; e <= MAX_SCALE_EDO; ++e) {
+            const Scale* sc = scalesEDO(e);
+            for (int i = 0; i < numScalesEDO(e); ++i) {
+                ScaleBits sb = scaleBits(e, i);
+                assert(sb.edo == e && sb.name == sc[i].name && (int)sc[i].mask.size() == e);
+                for (int d = 0; d < e; ++d) assert(sb.test(d) == (sc[i].mask[d] != 0));
+            }
+        }
+        ScaleBits chrom = scaleBits(120, 0);                                    // spans two pool words
+        for (int d = 0; d < 120; ++d) assert(chrom.test(d));
+    }
+
+    // --- ScaleDetect_HashIndex (findScaleIndex vs legacy normalize-and-scan) ---
+    {
+        using namespace hi::music;
+        auto norm = [](const std::vector<uint8_t>& m) {       // legacy masksEqual normalization
+            int N = (int)m.size(), r = 0;
+            for (int i = 0; i < N; ++i) if (m[i]) { r = i; break; }
+            std::vector<uint8_t> o(N);
+            for (int i = 0; i < N; ++i) o[i] = m[(i + r) % N] ? 1 : 0;
+            return o;
+        };
+        auto scan = [&](const std::vector<uint8_t>& m, int e) {
+            for (int i = 0; i < numScalesEDO(e); ++i) if (norm(m) == norm(scalesEDO(e)[i].mask)) return i;
+            return -1;
+        };
+        uint32_t seed = 0x5CA1Eu;
+        auto irand = [&seed](int n) { seed = seed * 1664525u + 1013904223u; return (int)((seed >> 8) % (uint32_t)n); };
+        for (int e = 1; e <= MAX_SCALE_EDO; ++e) {
+            for (int i = 0; i < numScalesEDO(e); ++i) {
+                std::vector<uint8_t> m = scalesEDO(e)[i].mask;
+                assert(findScaleIndex(m, e) == scan(m, e));
+                int lead = irand(e);                                 // shift up so degrees [0, lead) are empty
+                std::vector<uint8_t> sh(e, 0);
+                for (int d = 0; d + lead < e; ++d) sh[d + lead] = m[d];
+                assert(findScaleIndex(sh, e) == scan(sh, e));
+            }
+            for (int t = 0; t < 8; ++t) {                            // random masks (mostly no match)
+                std::vector<uint8_t> r(e);
+                for (int d = 0; d < e; ++d) r[d] = (uint8_t)irand(2);
+                assert(findScaleIndex(r, e) == scan(r, e));
+            }
+        }
+        assert(findScaleIndex(std::vector<uint8_t>(11, 1), 12) == -1);     // length must equal the EDO
+        std::vector<uint8_t> penta = {1,0,1,0,1,0,0,1,0,1,0,0}, dPenta(12, 0);
+        for (int d = 0; d < 12; ++d) dPenta[(d + 2) % 12] = penta[d];          // same shape rooted on step 2
+        assert(findScaleIndex(penta, 12) == 49 && findScaleIndex(dPenta, 12) == 49);
+    }
+
+    // --- Engine_QuantizeAndFade (render() quantizes to the mask; width change fades out → in) ---
+    {
+        hi::dsp::PolyQuantaEngine e;
+        const uint8_t major[12] = {1,0,1,0,1,1,0,1,0,1,0,1};
+        e.customMaskGeneric.assign(major, major + 12);
+        for (int c = 0; c < 16; ++c) e.qzEnabled[c] = true;
+        e.polyFadeSec = 0.001f; e.quantRoundMode = 1;                          // Nearest: no directional nudge
+        const float dt = 1.f / 48000.f;
+        float in[16], out[16];
+        for (int c = 0; c < 16; ++c) in[c] = 1.f / 12.f * (float)c + 0.01f;     // Chromatic steps, slightly sharp
+        e.applyControls(hi::dsp::ControlSnapshot{});
+        assert(e.updateWidth(true, 4) == 4);
+        assert(e.render(in, 4, true, 1.f, dt, out) == 4);
+        const float want[4] = {0.f, 2.f / 12.f, 2.f / 12.f, 4.f / 12.f};       // C, C#→D, D, D#→E (nearest allowed)
+        for (int c = 0; c < 4; ++c) assert(std::fabs(out[c] - want[c]) < 1e-5f);
+        assert(e.voices.ledBright[0] == 0.f && e.voices.ledBright[2*1] > 0.f && e.voices.ledBright[2*1 + 1] == 0.f && e.voices.ledBright[2*5] == 0.f);
+        int fadeOut = 0, n = 0;
+        for (; n < 480 && e.updateWidth(true, 8) != 8; ++n) {                  // 1 ms fade-out at 48 kHz
+            assert(e.render(in, 8, true, 1.f, dt, out) == 4);
+            assert(std::fabs(out[3]) <= 4.f / 12.f + 1e-5f);
+            ++fadeOut;
+        }
+        assert(fadeOut >= 47 && fadeOut <= 49 && e.polyTrans.transPhase == hi::dsp::polytrans::TRANS_FADE_IN);
+        assert(e.render(in, 8, true, 1.f, dt, out) == 8);                      // Reseeded voices start from silence
+        assert(std::fabs(out[7]) < 0.05f);
+        for (n = 0; n < 96; ++n) e.render(in, 8, true, 1.f, dt, out);
+        assert(e.polyTrans.transPhase == hi::dsp::polytrans::TRANS_STABLE && std::fabs(out[7] - 7.f / 12.f) < 1e-5f);
+    }
+
+    // --- Engine_ControlBlockAndReset (snapshot ramps across a block; reset() clears voices only) ---
+    {
+        hi::dsp::PolyQuantaEngine e;
+        static_assert(alignof(hi::dsp::VoiceBank) == 64, "voice state starts on a cache line");
+        assert(((uintptr_t)&e.voices % 64) == 0);
+        e.controlRateDiv = 4;
+        hi::dsp::ControlSnapshot cs;
+        for (int c = 0; c < 16; ++c) cs.off[c] = 1.f;
+        float w[8];
+        for (int n = 0; n < 8; ++n) {
+            if (e.controlDue()) { e.applyControls(cs); for (int c = 0; c < 16; ++c) cs.off[c] = 2.f; }
+            w[n] = e.advanceControl();
+        }
+        assert(w[0] == 0.25f && w[3] == 1.f && w[4] == 0.25f);                // Phase wraps every 4 samples
+        assert(e.ctl.off[0][0] == 1.f && e.ctl.off[1][0] == 2.f);             // Second block ramps 1 V → 2 V
+        assert(std::fabs(e.ctl.offAt(0, w[5]) - 1.5f) < 1e-6f);
+        e.controlRateDiv = 32;                                                 // Menu shrinks the divisor mid-block:
+        for (int n = 0; n < 10; ++n) e.advanceControl();
+        e.controlRateDiv = 4;                                                  // the stale phase ends the block at full weight
+        assert(e.advanceControl() == 1.f && e.controlDue());
+        float in[16] = {0.5f}, out[16];
+        e.qzEnabled[0] = true;
+        e.updateWidth(true, 1);
+        e.render(in, 1, true, 1.f, 1.f / 48000.f, out);
+        assert(e.voices.lastOut[0] != 0.f && e.voices.latchedInit[0]);
+        e.preScale[0] = 2.f; e.pitchSafeGlide = true;
+        e.reset();
+        assert(e.voices.lastOut[0] == 0.f && !e.voices.latchedInit[0] && e.voices.stepNorm[0] == 10.f);
+        assert(e.preScale[0] == 1.f && e.pitchSafeGlide && e.controlDue() && !e.ctl.valid);
+    }
+
+    // --- Engine_SettledFastPath (constant input at every-sample control rate settles every voice) ---
+    {
+        hi::dsp::PolyQuantaEngine e;
+        const uint8_t major[12] = {1,0,1,0,1,1,0,1,0,1,0,1};
+        e.customMaskGeneric.assign(major, major + 12);                        // Default useCustomScale = true
+        for (int c = 0; c < 16; ++c) e.qzEnabled[c] = true;
+        e.polyFadeSec = 0.001f; e.controlRateDiv = 1;
+        float in[16], out[16];
+        for (int c = 0; c < 16; ++c) in[c] = 0.07f * (float)c;
+        const hi::dsp::ControlSnapshot cs;
+        uint32_t gen = 0;
+        for (int n = 0; n < 24000; ++n) {                                      // 0.5 s: LEDs converge, then voices idle
+            e.updateWidth(true, 4);
+            if (e.controlDue()) e.applyControls(cs);                           // Re-evaluated every sample
+            e.render(in, 4, true, e.advanceControl(), 1.f / 48000.f, out);
+            if (n == 12000) gen = e.quantPlanGen;
+        }
+        assert(e.quantPlanGen == gen);                                         // No config change, no relatch
+        for (int c = 0; c < 4; ++c) assert(e.voices.settled[c] && e.voices.latchedInit[c]);
+    }
+
+    // --- Engine_ProcessBlock (block render == per-sample render, incl. a width change) ---
+    for (int div : {4, 1}) {                                                   // Ramped blocks; controls applied once
+        const uint8_t major[12] = {1,0,1,0,1,1,0,1,0,1,0,1};
+        hi::dsp::PolyQuantaEngine a, b;
+        for (hi::dsp::PolyQuantaEngine* e : {&a, &b}) {
+            e->customMaskGeneric.assign(major, major + 12);
+            for (int c = 0; c < 16; ++c) e->qzEnabled[c] = true;
+            e->polyFadeSec = 0.0005f; e->controlRateDiv = div;
+        }
+        hi::dsp::ControlSnapshot cs;
+        for (int c = 0; c < 16; ++c) { cs.off[c] = 0.05f * (float)c; cs.slSec[c] = 0.001f; }
+        const float dt = 1.f / 48000.f;
+        const int kFrames = 64, S = hi::dsp::PolyQuantaEngine::kFrameStride;
+        float in[kFrames * 16], outA[kFrames * 16], outB[kFrames * 16];
+        int chB[kFrames];
+        for (int blk = 0; blk < 4; ++blk) {
+            const int ch = (blk < 2) ? 4 : 8;
+            for (int f = 0; f < kFrames; ++f)
+                for (int c = 0; c < 16; ++c) in[f * S + c] = 0.3f * std::sin(0.01f * (float)(blk * kFrames + f) + (float)c);
+            for (int f = 0; f < kFrames; ++f) {
+                a.updateWidth(true, ch);
+                if (a.controlDue()) a.applyControls(cs);
+                const float w = a.advanceControl();
+                const int n = a.render(in + f * S, ch, true, w, dt, outA + f * S);
+                for (int c = n; c < 16; ++c) outA[f * S + c] = 0.f;
+            }
+            const int lastN = b.processBlock(in, outB, kFrames, ch, dt, cs, chB);
+            assert(lastN == a.polyTrans.curOutN && chB[kFrames - 1] == lastN);
+            for (int i = 0; i < kFrames * 16; ++i) assert(outA[i] == outB[i]);
+        }
+        assert(b.polyTrans.curProcN == 8);
+        hi::dsp::blockio::Fifo fifo;
+        fifo.configure(32, 3);                                                 // Not a menu size: bypassed
+        assert(fifo.latency == 0);
+        fifo.configure(16, 3);
+        assert(fifo.latency == 16 && fifo.pos == 0 && fifo.outCh[15] == 3 && fifo.out[0] == 0.f);
+    }
+
+    // --- Strum_Scheduler (holds expire on their sample; retrigger re-keys without rescanning) ---
+    {
+        using hi::dsp::strum::Scheduler; using hi::dsp::strum::delaySamples;
+        assert(delaySamples(0.f, 1.f / 48000.f) == 0 && delaySamples(0.001f, 1.f / 48000.f) == 48);
+        assert(delaySamples(0.015f, 1.f / 48000.f) == 720 && delaySamples(0.5f / 48000.f, 1.f / 48000.f) == 1);
+        Scheduler s;
+        assert(s.idle() && !s.held(0));
+        for (int c = 0; c < 16; ++c) s.schedule(c, (uint32_t)(16 - c) * 3);   // Down strum: ch15 first
+        assert(s.size == 16 && s.held(15));
+        s.schedule(15, 10);                                                    // Retrigger later
+        s.schedule(0, 1);                                                      // Retrigger earlier
+        s.cancel(7);
+        int8_t woken[16];
+        assert(s.advance(woken) == 1 && woken[0] == 0 && !s.held(0));
+        int order[16], nOrder = 0;
+        while (!s.idle()) {
+            const int n = s.advance(woken);
+            for (int i = 0; i < n; ++i) { assert(s.fireAt[woken[i]] == s.now); order[nOrder++] = woken[i]; }
+        }
+        assert(nOrder == 14 && order[0] == 14 && order[1] == 13 && order[2] == 15 && order[13] == 1);
+        for (int c = 0; c < 16; ++c) assert(!s.held(c));
+        s.schedule(3, 5); s.clear();
+        assert(s.idle() && !s.held(3));
+    }
+
+    // --- Rng_Xoroshiro (lanes match scalar xoroshiro128+; state round-trips; seeded strum) ---
+    {
+        hi::dsp::rng::Xoroshiro r(12345);
+        uint64_t st[hi::dsp::rng::kStateWords];
+        r.getState(st);
+        uint64_t a = st[2], b = st[6];                                         // Lane 2, scalar reference
+        auto rotl = [](uint64_t x, int k) { return (x << k) | (x >> (64 - k)); };
+        float u[16];
+        r.fillUniform(u, 16);
+        for (int step = 0; step < 4; ++step) {
+            const uint64_t out = a + b;
+            b ^= a; a = rotl(a, 24) ^ b ^ (b << 16); b = rotl(b, 37);
+            assert(u[step * 4 + 2] == (float)(out >> 40) * (1.f / 16777216.f));
+        }
+        for (float x : u) assert(x >= 0.f && x < 1.f);
+        hi::dsp::rng::Xoroshiro s1(1), s2(2);
+        r.getState(st);
+        assert(s1.setState(st));
+        float v1[7], v2[7];
+        r.fillSymmetric(v1, 7, 2.f); s1.fillSymmetric(v2, 7, 2.f);
+        for (int i = 0; i < 7; ++i) assert(v1[i] == v2[i] && std::fabs(v1[i]) <= 2.f);
+        const uint64_t zero[hi::dsp::rng::kStateWords] = {0};
+        assert(!s2.setState(zero));
+        float d1[16], d2[16];
+        hi::dsp::rng::Xoroshiro g1(77), g2(77);
+        hi::dsp::strum::assign(10.f, 16, hi::dsp::strum::Mode::Random, d1, g1);
+        hi::dsp::strum::assign(10.f, 16, hi::dsp::strum::Mode::Random, d2, g2);
+        bool spread = false;
+        for (int c = 0; c < 16; ++c) { assert(d1[c] == d2[c] && d1[c] >= 0.f && d1[c] < 0.01f); spread |= d1[c] != d1[0]; }
+        assert(spread);
+        hi::dsp::strum::assign(10.f, 4, hi::dsp::strum::Mode::Up, d1, g1);
+        assert(d1[0] == 0.f && std::fabs(d1[3] - 0.03f) < 1e-7f);
+    }
+
+    // --- Morph_Bank (linear glide, staggered writes, hand-moved knob releases its slot) ---
+    {
+        hi::dsp::morph::Bank b;
+        float param[hi::dsp::morph::Bank::kSlots] = {0.f};
+        int writes[hi::dsp::morph::Bank::kSlots] = {0};
+        auto read = [&](int k) { return param[k]; };
+        auto write = [&](int k, float v) { param[k] = v; ++writes[k]; };
+        b.start(0, 0.f, 1.f, 8, 4, 1);                                       // Every 4 samples at phase 1
+        b.start(1, 0.f, -2.f, 8);                                            // Every sample
+        b.start(2, 0.f, 5.f, 100);
+        assert(b.nActive == 3 && !b.idle());
+        for (int n = 0; n < 3; ++n) b.tick(read, write);
+        assert(writes[0] == 1 && param[0] == 3.f / 8.f && writes[1] == 3 && param[1] == -0.75f);
+        param[2] = 4.f;                                                      // User grabs the knob
+        for (int n = 0; n < 5; ++n) b.tick(read, write);
+        assert(param[0] == 1.f && writes[0] == 3 && param[1] == -2.f && writes[1] == 8);
+        assert(param[2] == 4.f && writes[2] == 3 && b.idle());
+        b.start(5, 1.f, 2.f, 0);                                             // Zero length: lands next sample
+        b.tick(read, write);
+        assert(param[5] == 0.f && b.idle());                                 // ...unless the param moved first
+        param[5] = 1.f; b.start(5, 1.f, 2.f, 0); b.tick(read, write);
+        assert(param[5] == 2.f && b.idle());
+        assert(hi::dsp::morph::isValidTime(0.05f) && !hi::dsp::morph::isValidTime(0.3f));
+    }
+
+    // --- Telemetry_Seqlock (nothing before the first publish, latest frame wins, version bumps) ---
+    {
+        hi::dsp::telemetry::Channel tc;
+        hi::dsp::telemetry::Frame f;
+        assert(!tc.read(f) && tc.version() == 0);
+        for (int n = 1; n <= 5; ++n) {
+            hi::dsp::telemetry::Frame w;
+            w.activeN = n;
+            for (int c = 0; c < 16; ++c) { w.volts[c] = n + c * 0.01f; w.step[c] = n * 100 + c; }
+            for (int i = 0; i < 32; ++i) w.led[i] = n * 0.1f;
+            tc.publish(w);
+            assert(tc.version() == (uint32_t)n);
+            assert(tc.read(f) && f.activeN == n && f.step[15] == n * 100 + 15);
+            assert(f.volts[3] == w.volts[3] && f.led[31] == w.led[31]);
+        }
+    }
+
+    // --- Diag_Counters (counts only with -DHI_DIAGNOSTICS; always zero otherwise) ---
+    {
+        namespace dg = hi::dsp::diag;
+        hi::dsp::PolyQuantaEngine e;
+        for (int c = 0; c < 16; ++c) e.qzEnabled[c] = true;
+        e.quantRoundMode = 1; e.polyFadeSec = 0.f;
+        const float dt = 1.f / 48000.f;
+        float in[16] = {0.f}, out[16];
+        e.applyControls(hi::dsp::ControlSnapshot{});
+        e.updateWidth(true, 1);
+        for (int n = 0; n < 3; ++n) { in[0] = (float)(2 * n) / 12.f; dg::Scope sc(e.diag); e.render(in, 1, true, 1.f, dt, out); }
+        const uint64_t relatch0 = e.diag.get(dg::Relatches);
+        e.rootNote = 3; e.refreshQuantPlan();
+        e.updateWidth(true, 4);
+        if (dg::kEnabled) {
+            assert(e.diag.get(dg::ProcessCalls) == 3 && e.diag.get(dg::Snaps) >= 2);
+            assert(e.diag.get(dg::Relatches) == relatch0 + 1 && e.diag.get(dg::PolyTransitions) >= 1);
+        } else {
+            for (int k = 0; k < dg::kCount; ++k) assert(e.diag.get((dg::Counter)k) == 0);
+        }
+        e.diag.reset();
+        assert(e.diag.get(dg::ProcessCalls) == (dg::kEnabled ? 3u : 0u)); // Applied by the next process() only
+        { dg::Scope sc(e.diag); }
+        assert(e.diag.get(dg::ProcessCalls) == (dg::kEnabled ? 1u : 0u) && e.diag.get(dg::Snaps) == 0);
+        char rep[512];
+        const int len = dg::formatReport(e.diag, 48000.f, rep, sizeof(rep));
+        assert(len > 0 && len < (int)sizeof(rep) && std::strstr(rep, "snaps") && std::strstr(rep, "ticks_per_process"));
+        assert(dg::formatReport(e.diag, 48000.f, rep, 16) == 15 && std::strlen(rep) == 15); // Truncates, stays terminated
+    }
+
+    // --- MOS_Memo (bitset memo == generateCycle/isMOS/patternLS/findBestGeneratorRef) ---
+    {
+        namespace mos = hi::music::mos;
+        for (int N = 2; N <= 48; ++N) {
+            for (int m = 2; m <= N; ++m) {
+                const mos::memo::Entry* e = mos::memo::get(N, m);
+                assert(e && e == mos::memo::get(N, m) && e->N == N && e->m == m); // Filled once
+                assert(e->best == mos::findBestGeneratorRef(N, m) && mos::findBestGenerator(N, m) == e->best);
+                for (int g = 1; g < N; ++g) {
+                    const std::vector<int> cyc = mos::generateCycle(N, g, m);
+                    assert(e->pcs(g) == cyc && (int)e->size[g] == (int)cyc.size());
+                    assert(e->mos[(size_t)g] == mos::isMOS(cyc, N) && e->pattern(g) == mos::patternLS(cyc, N));
+                }
+            }
+        }
+        assert(mos::memo::get(12, 7)->pattern(7) == "LLLSLLS" && mos::memo::get(12, 7)->best == 7);
+        assert(!mos::memo::get(12, 1) && !mos::memo::get(12, 13) && !mos::memo::get(200, 7));
+        assert(mos::findBestGenerator(200, 7) == mos::findBestGeneratorRef(200, 7));  // Falls back past kMaxN
+    }
+
+    // --- MOS_MaskState (O(1) toggles == full rebuild; shape == isMOS; cycles never exceed 3 steps) ---
+    {
+        namespace mos = hi::music::mos;
+        uint32_t lcg = 12345u;
+        for (int N : {2, 7, 12, 31, 64, 65, 120, 128}) {
+            std::vector<uint8_t> mask((size_t)N, 0);
+            mos::MaskState inc, full;
+            assert(inc.assign(mask.data(), N, N) && inc.count == 0 && inc.hash == 0);
+            for (int n = 0; n < 400; ++n) {
+                lcg = lcg * 1664525u + 1013904223u;
+                const int p = (int)((lcg >> 8) % (uint32_t)N);
+                mask[(size_t)p] ^= 1;
+                inc.toggle(p);
+                full.assign(mask.data(), N, N);
+                assert(inc.hash == full.hash && inc.count == full.count && inc.distinct == full.distinct);
+                assert(std::memcmp(inc.stepHist, full.stepHist, sizeof(inc.stepHist)) == 0 && inc.bits() == full.bits());
+                std::vector<int> pcs;
+                for (int q = 0; q < N; ++q) if (mask[(size_t)q]) pcs.push_back(q);
+                assert(inc.isMOS() == mos::isMOS(pcs, N));
+            }
+        }
+        for (int N = 2; N <= 40; ++N)
+            for (int g = 1; g < N; ++g) {
+                const mos::memo::Entry* e = mos::memo::get(N, std::min(N, 9));
+                std::vector<uint8_t> mask((size_t)N, 0);
+                for (int q : e->pcs(g)) mask[(size_t)q] = 1;
+                mos::MaskState ms; ms.assign(mask.data(), N, N);
+                assert(ms.distinct <= 3 && ms.bits() == e->cycle[g]);
+            }
+        mos::MaskState big;
+        assert(!big.assign(nullptr, 0, mos::memo::kMaxN + 1) && big.N == 0);
+    }
+
+    // --- Tuning_RCU (snapshot publish/acquire, field edits invisible until published, reclamation) ---
+    {
+        hi::dsp::PolyQuantaEngine e;
+        const uint8_t major[12] = {1,0,1,0,1,1,0,1,0,1,0,1};
+        e.customMaskGeneric.assign(major, major + 12);
+        e.refreshQuantPlan();                                                // Nothing published: fields directly
+        assert(e.plan == &e.quantPlan && !e.tuning && !e.plan->isAllowed(1));
+        assert(e.publishTuning() && !e.publishTuning());                     // Unchanged fields: no new snapshot
+        e.refreshQuantPlan();
+        const hi::dsp::tuning::Snapshot* s1 = e.tuning;
+        assert(s1 && e.plan == s1->plan.get() && s1->version == 1 && s1->N == 12 && !e.plan->isAllowed(1));
+        e.customMaskGeneric[1] = 1; e.rootNote = 2;                          // UI edit in progress
+        e.refreshQuantPlan();
+        assert(e.tuning == s1 && !e.plan->isAllowed(1) && e.plan->root == 0);
+        assert(e.publishTuning());
+        e.refreshQuantPlan();
+        assert(e.tuning != s1 && e.plan->root == 2 && e.plan->isAllowed(3));  // Degree 1 above root 2
+        for (int n = 0; n < 4; ++n) { e.rootNote = 3 + n; assert(e.publishTuning()); } // Audio thread idle
+        assert(e.tuningX.retiredCount() >= 4);                               // Still behind: nothing freed
+        e.refreshQuantPlan();                                                // Acknowledge the newest
+        e.rootNote = 0; e.publishTuning();
+        assert(e.tuningX.retiredCount() == 1 && e.plan->root == 6);          // Only the in-use snapshot kept
+        e.tuningMode = 1; e.tetSteps = 0; e.tetPeriodOct = 0.f; e.publishTuning(); e.refreshQuantPlan();
+        assert(e.tuning->N == 9 && std::fabs(e.tuning->period - std::log2(1.5f)) < 1e-6f); // Engine fallbacks
+    }
+
+    // --- Tuning_Republish (an identical snapshot keeps latches and settled voices) ---
+    {
+        hi::dsp::PolyQuantaEngine e;
+        const uint8_t major[12] = {1,0,1,0,1,1,0,1,0,1,0,1};
+        e.customMaskGeneric.assign(major, major + 12);
+        for (int c = 0; c < 16; ++c) e.qzEnabled[c] = true;
+        e.polyFadeSec = 0.001f; e.stickinessCents = 10.f;
+        float in[16], out[16];
+        for (int c = 0; c < 16; ++c) in[c] = 0.045f + 0.05f * (float)c;         // Near step edges: stickiness matters
+        const hi::dsp::ControlSnapshot cs;
+        auto run = [&](int n) {
+            for (int i = 0; i < n; ++i) {
+                e.updateWidth(true, 4);
+                if (e.controlDue()) e.applyControls(cs);
+                e.render(in, 4, true, e.advanceControl(), 1.f / 48000.f, out);
+            }
+        };
+        e.publishTuning();
+        run(24000);
+        const uint32_t gen = e.quantPlanGen;
+        int steps[4];
+        for (int c = 0; c < 4; ++c) { assert(e.voices.settled[c]); steps[c] = e.voices.latchedStep[c]; }
+        for (int c = 0; c < 4; ++c) in[c] += 0.03f;                            // Inside the hysteresis band
+        run(1);
+        for (int c = 0; c < 4; ++c) assert(e.voices.latchedStep[c] == steps[c]);
+        hi::dsp::tuning::Snapshot* again = new hi::dsp::tuning::Snapshot();    // Same fields, new version
+        again->build(e.tuningMode, e.edo, e.tetSteps, e.tetPeriodOct, e.useCustomScale, e.customMaskGeneric,
+                     e.rootNote, e.scaleIndex);
+        const hi::dsp::tuning::Snapshot* before = e.tuning;
+        e.tuningX.publish(again);
+        run(1);
+        assert(e.tuning == again && e.tuning != before && e.quantPlanGen == gen);
+        for (int c = 0; c < 4; ++c) assert(e.voices.latchedInit[c] && e.voices.latchedStep[c] == steps[c]);
+    }
+
+    // --- Tuning_PlanPool (equal tunings share one plan; released with the last holder) ---
+    {
+        const size_t live0 = hi::dsp::tuning::pool::liveCount();
+        const hi::dsp::QuantPlan* shared = nullptr;
+        {
+            hi::dsp::PolyQuantaEngine a, b, c;
+            const uint8_t dorian[12] = {1,0,1,1,0,1,0,1,0,1,1,0};
+            for (hi::dsp::PolyQuantaEngine* e : {&a, &b, &c}) {
+                e->customMaskGeneric.assign(dorian, dorian + 12); e->rootNote = 5;
+            }
+            c.rootNote = 7;
+            a.publishTuning(); b.publishTuning(); c.publishTuning();
+            a.refreshQuantPlan(); b.refreshQuantPlan(); c.refreshQuantPlan();
+            assert(a.plan == b.plan && a.plan != c.plan && a.plan->root == 5 && c.plan->root == 7);
+            assert(hi::dsp::tuning::pool::liveCount() == live0 + 2);
+            shared = a.plan;
+            b.rootNote = 7; b.publishTuning(); b.refreshQuantPlan();    // Joins c's plan
+            assert(b.plan == c.plan && a.plan == shared && hi::dsp::tuning::pool::liveCount() == live0 + 2);
+            hi::dsp::QuantPlan ref; ref.build(12, 1.f, 5, dorian, 12);
+            for (int st = -30; st <= 30; ++st) assert(a.plan->isAllowed(st) == ref.isAllowed(st));
+        }
+        assert(hi::dsp::tuning::pool::liveCount() == live0);            // Last snapshot gone: plans freed
+        {
+            hi::dsp::PolyQuantaEngine e;                                // Root sweep: each tuning visited once
+            for (int r = 0; r < 48; ++r) { e.rootNote = r % 12; e.edo = 12 + r / 12; e.publishTuning(); e.refreshQuantPlan(); }
+            assert(hi::dsp::tuning::pool::slotCount() <= live0 + 3);    // Released plans leave no slots behind
+        }
+    }
+
+    // --- QuantPlan_StepTable (step→volts table, snapStep/nudgeStep match snap/snapBounded) ---
+    {
+        const uint8_t major[12] = {1,0,1,0,1,1,0,1,0,1,0,1};
+        const uint8_t mask19[19] = {1,0,1,0,1,1,0,1,0,1,0,1,0,1,1,0,1,0,1};
+        struct Cfg { int n; float period; int root; const uint8_t* m; int len; };
+        const Cfg cfgs[] = {{12, 1.f, 3, major, 12}, {19, 1.f, 5, mask19, 19}, {13, 1.58496f, 0, nullptr, 0}};
+        for (const Cfg& cf : cfgs) {
+            hi::dsp::QuantPlan qp; qp.build(cf.n, cf.period, cf.root, cf.m, cf.len);
+            const hi::dsp::QuantBound qb = qp.bound(5.f);
+            assert(qp.stepVoltsSpan >= (int)(10.f * qp.stepsPerVolt));
+            for (int st = -qp.stepVoltsSpan - 3; st <= qp.stepVoltsSpan + 3; ++st) {
+                _assertClose(qp.volts(st), (float)st / qp.stepsPerVolt, 1e-5f, "step table == division");
+                const float v = ((float)st / (float)qp.N) * qp.periodOct;
+                const int q = qp.snapStep(st);
+                _assertClose(qp.volts(q), qp.snap(v), 1e-5f, "snapStep parity");
+                const float nv = 0.51f * qp.periodOct / (float)qp.N;
+                _assertClose(qp.volts(qp.nudgeStep(q, +1, qb)), qp.snapBounded(qp.volts(q) + nv, qb), 1e-5f, "nudgeStep up parity");
+                _assertClose(qp.volts(qp.nudgeStep(q, -1, qb)), qp.snapBounded(qp.volts(q) - nv, qb), 1e-5f, "nudgeStep down parity");
+            }
+        }
+    }
+
+    // --- Chain_Expander (frame flags/mono expansion; same-plan steps adopted in one sample) ---
+    {
+        int32_t sent[16] = {0}, latched[16] = {0};
+        float v[16] = {0.f};
+        latched[3] = 5;
+        hi::dsp::chain::Frame f;
+        assert(!hi::dsp::chain::valid(&f));
+        hi::dsp::chain::fill(f, v, 4, latched, sent, nullptr);
+        assert(hi::dsp::chain::valid(&f) && f.channels == 4 && f.stepChanged == (1u << 3) && sent[3] == 5);
+        hi::dsp::chain::fill(f, v, 4, latched, sent, nullptr);
+        assert(f.stepChanged == 0);
+        latched[0] = 9;
+        hi::dsp::chain::fill(f, v, 1, latched, sent, nullptr);
+        int32_t ex[16];
+        hi::dsp::chain::expandSteps(f, ex);
+        for (int c = 0; c < 16; ++c) assert(ex[c] == 9);
+
+        // A 7-step jump: an unchained Directional Snap climbs one step per sample,
+        // a receiver on the same plan takes the upstream step at once
+        hi::dsp::PolyQuantaEngine up, down, alone;
+        for (hi::dsp::PolyQuantaEngine* e : {&up, &down, &alone}) {
+            const uint8_t chrom[12] = {1,1,1,1,1,1,1,1,1,1,1,1};
+            e->customMaskGeneric.assign(chrom, chrom + 12);
+            for (int c = 0; c < 16; ++c) e->qzEnabled[c] = true;
+            e->quantRoundMode = 0;
+            e->publishTuning(); e->refreshQuantPlan();
+            e->applyControls(hi::dsp::ControlSnapshot{});
+            e->updateWidth(true, 1);
+        }
+        assert(up.plan == down.plan && up.plan == alone.plan);
+        const float dt = 1.f / 48000.f;
+        float in[16] = {0.f}, out[16];
+        for (int n = 0; n < 4; ++n)
+            for (hi::dsp::PolyQuantaEngine* e : {&up, &down, &alone}) e->render(in, 1, true, 1.f, dt, out);
+        in[0] = 7.f / 12.f;
+        int32_t steps[16];
+        for (int c = 0; c < 16; ++c) steps[c] = 7;
+        down.chainStep = steps; down.chainPlan = up.plan;
+        down.render(in, 1, true, 1.f, dt, out);
+        assert(down.voices.latchedStep[0] == 7 && std::fabs(out[0] - 7.f / 12.f) < 1e-5f);
+        alone.render(in, 1, true, 1.f, dt, out);
+        assert(alone.voices.latchedStep[0] < 7);
+        const uint8_t chrom[12] = {1,1,1,1,1,1,1,1,1,1,1,1};
+        hi::dsp::QuantPlan other; other.build(12, 1.f, 0, chrom, 12);   // Equal tables, not the interned plan
+        up.chainStep = steps; up.chainPlan = &other;                    // Different plan: normal latch
+        up.render(in, 1, true, 1.f, dt, out);
+        assert(up.voices.latchedStep[0] == alone.voices.latchedStep[0]);
+    }
+
+    // --- Scala_Tuning (.scl/.kbm parse, warped plan == exact JI pitches, engine quantizes to them) ---
+    {
+        namespace sc = hi::music::scala;
+        const char* scl =
+            "! ji12.scl\n!\n5-limit chromatic\n 12\n!\n16/15\n9/8\n5/4\n6/5\n4/3\n45/32\n"
+            "3/2 fifth\n8/5\n5/3\n2217.596\n15/8\n2/1\n";                  // 9/5 written a period up
+        sc::Scale sl; std::string err;
+        assert(sc::parseScl(scl, sl, &err) && sl.description == "5-limit chromatic" && sl.cents.size() == 12);
+        assert(!sc::parseScl("x\n3\n3/2\n", sl, &err) && !err.empty());   // Fewer pitches than announced
+        sc::Tuning t;
+        assert(sc::toTuning(sl, nullptr, t) && t.degrees.size() == 12 && t.period == 1.f && t.tonic == 0.f);
+        for (size_t i = 1; i < t.degrees.size(); ++i) assert(t.degrees[i] > t.degrees[i - 1]);
+        assert(std::fabs(t.degrees[10] - 1017.596f / 1200.f) < 1e-6f);        // Reduced into the period
+
+        hi::dsp::QuantPlan qp;
+        qp.build(12, t.period, 0, nullptr, 0, t.degrees.data(), t.tonic);
+        assert(qp.warped());
+        const float fifth = (float)std::log2(1.5);
+        assert(std::fabs(qp.volts(7) - fifth) < 1e-6f && std::fabs(qp.volts(-5) - (fifth - 1.f)) < 1e-6f);
+        assert(std::fabs(qp.volts(19) - (1.f + fifth)) < 1e-6f);
+        for (int st = -40; st <= 40; ++st) {
+            assert(std::fabs(qp.stepPos(qp.volts(st)) - (double)st) < 1e-4);
+            assert(qp.volts(qp.nearest(qp.toSteps(qp.volts(st) + 0.004f))) == qp.volts(st));
+        }
+        hi::dsp::rng::Xoroshiro r; r.seed(7);                                   // Bucket index == linear scan
+        for (int k = 0; k < 2000; ++k) {
+            const float v = -3.f + 6.f * r.uniform();
+            int lo = -100;
+            while (qp.volts(lo + 1) <= v) ++lo;
+            const double want = lo + (v - qp.volts(lo)) / (qp.volts(lo + 1) - qp.volts(lo));
+            assert(std::fabs(qp.stepPos(v) - want) < 1e-4);
+        }
+        const hi::dsp::QuantBound qb = qp.bound(1.f);
+        assert(qp.snapBounded(5.f, qb) <= 1.f && qp.snapBounded(-5.f, qb) >= -1.f);
+
+        // Keymap: degree 0 on middle C, A (degree 9 = 5/3) at 440 Hz, black keys unmapped
+        const char* kbm = "! white.kbm\n12\n0\n127\n60\n69\n440.0\n12\n0\nx\n2\nx\n4\n5\nx\n7\nx\n9\nx\n11\n";
+        sc::Keymap km;
+        assert(sc::parseKbm(kbm, km, &err) && km.map.size() == 12 && km.map[1] == -1);
+        assert(sc::toTuning(sl, &km, t));
+        const uint8_t white[12] = {1,0,1,0,1,1,0,1,0,1,0,1};
+        for (int i = 0; i < 12; ++i) assert(t.mapped[(size_t)i] == white[i]);
+        const float wantTonic = (float)(std::log2(440.0 / 261.6255653005986) - std::log2(5.0 / 3.0));
+        assert(std::fabs(t.tonic - wantTonic) < 1e-6f);
+        // Hostile headers/entries are rejected before anything is sized from them
+        err.clear();
+        assert(!sc::parseKbm("! big.kbm\n2000000000\n0\n127\n60\n69\n440\n12\n", km, &err) && err == "bad map size");
+        assert(!sc::parseKbm("12\n0\n127\n-5\n69\n440\n12\n", km, &err));                  // Middle off the keyboard
+        assert(!sc::parseKbm("1\n0\n127\n60\n69\n440\n1\n99999\n", km, &err) && err == "bad mapping entry");
+        sc::Scale dup;                                                          // 4/1 reduces onto 1/1
+        assert(sc::parseScl("dup\n3\n3/2\n4/1\n2/1\n", dup, &err) && sc::toTuning(dup, nullptr, t) && t.degrees.size() == 2);
+        assert(!sc::toTuning(dup, &km, t));                                     // Would shift keymap indices
+        assert(sc::parseKbm(kbm, km, &err) && sc::toTuning(sl, &km, t));
+
+        // Engine in tuningMode 2 (TET fields carry N/period) through the published, interned plan
+        hi::dsp::PolyQuantaEngine e;
+        e.tuningMode = 2; e.tetSteps = 12; e.tetPeriodOct = t.period;
+        e.scalaDegrees = t.degrees; e.scalaTonic = 0.f;
+        e.customMaskGeneric.assign(white, white + 12);
+        for (int c = 0; c < 16; ++c) e.qzEnabled[c] = true;
+        e.quantRoundMode = 1;
+        e.publishTuning(); e.refreshQuantPlan();
+        assert(e.plan->warped());
+        e.applyControls(hi::dsp::ControlSnapshot{});
+        e.updateWidth(true, 2);
+        float in[16] = {0.6f, 0.3f}, out[16];                                   // Near the fifth / the major third
+        e.render(in, 2, true, 1.f, 1.f / 48000.f, out);
+        assert(std::fabs(out[0] - fifth) < 1e-6f && std::fabs(out[1] - (float)std::log2(1.25)) < 1e-6f);
+    }
+
+    // --- ScalePack_RoundTrip (write -> open yields the same names/masks; corrupt packs rejected) ---
+    {
+        namespace sp = hi::music::scalepack;
+        std::vector<sp::Source> src(3);
+        src[0].name = "Major";  src[0].mask = {1,0,1,0,1,1,0,1,0,1,0,1};
+        src[1].name = "";       src[1].mask = {1,1,0,1,0};                      // Unnamed entry is legal
+        src[2].name = "Sparse 100"; src[2].mask.assign(100, 0);                 // Crosses a word boundary
+        src[2].mask[0] = src[2].mask[63] = src[2].mask[64] = src[2].mask[99] = 1;
+        std::vector<uint8_t> bytes; std::string err;
+        assert(sp::write(src, bytes, &err) && bytes.size() % 8 == 0);
+        std::vector<uint64_t> buf((bytes.size() + 7) / 8);
+        std::memcpy(buf.data(), bytes.data(), bytes.size());
+        sp::View v;
+        assert(sp::open(buf.data(), bytes.size(), v, &err) && v.count() == 3);
+        for (uint32_t i = 0; i < v.count(); ++i) {
+            hi::music::ScaleBits b = v.at(i);
+            assert(src[i].name == b.name && b.edo == (int)src[i].mask.size());
+            for (int d = 0; d < b.edo; ++d) assert(b.test(d) == (src[i].mask[(size_t)d] != 0));
+        }
+        std::vector<sp::Source> bad(1); bad[0].name = "Too wide"; bad[0].mask.assign(hi::music::MAX_SCALE_EDO + 1, 1);
+        std::vector<uint8_t> untouched;
+        assert(!sp::write(bad, untouched, &err) && untouched.empty() && !err.empty());
+
+        std::vector<uint64_t> t(buf);
+        reinterpret_cast<sp::Header*>(t.data())->magic ^= 1u;
+        assert(!sp::open(t.data(), bytes.size(), v, &err) && v.count() == 0);    // Bad magic
+        t = buf; reinterpret_cast<sp::Header*>(t.data())->version = sp::kVersion + 1;
+        assert(!sp::open(t.data(), bytes.size(), v, &err));                     // Future version
+        assert(!sp::open(buf.data(), bytes.size() - 8, v, &err));               // Truncated names
+        assert(!sp::open(buf.data(), sizeof(sp::Header) - 1, v, &err));         // Truncated header
+        t = buf; reinterpret_cast<sp::Entry*>(reinterpret_cast<uint8_t*>(t.data()) + sizeof(sp::Header))[2].wordOffset += 2;
+        assert(!sp::open(t.data(), bytes.size(), v, &err));                     // Mask past the pool
+        std::vector<uint8_t> empty;
+        assert(sp::write(std::vector<sp::Source>(), empty) && empty.size() % 8 == 0);
+        std::vector<uint64_t> eb(empty.size() / 8); std::memcpy(eb.data(), empty.data(), empty.size());
+        assert(sp::open(eb.data(), empty.size(), v) && v.count() == 0);
+    }
+
+    // --- MenuLabels (root/degree label text, page splits, cache rebuilt only on key change) ---
+    {
+        namespace lb = hi::ui::labels;
+        assert(lb::rootLabel(7, 12, 1.f, true) == "7 (G)");
+        assert(lb::rootLabel(2, 24, 1.f, true) == "2 (C#)" && lb::rootLabel(1, 24, 1.f, true) == "1");
+        assert(lb::rootLabel(18, 31, 1.f, true) == "18 (≈G -3¢)");             // 18 steps of 31-EDO = 696.8¢
+        assert(lb::degreeLabel(0, 12, 0) == "1 (C)" && lb::degreeLabel(5, 19, 4) == "5");
+        assert(lb::degreeLabel(18, 31, 0) == "1 (G -3¢)");
+        lb::Pages p = lb::split(36);
+        assert(p.count == 1 && p.lo[0] == 0 && p.hi[0] == 35);
+        p = lb::split(37);
+        assert(p.count == 2 && p.hi[0] == 18 && p.lo[1] == 19 && p.hi[1] == 36);
+        p = lb::split(121);
+        assert(p.count == 3 && p.hi[0] == 40 && p.lo[1] == 41 && p.hi[1] == 80 && p.lo[2] == 81 && p.hi[2] == 120);
+        lb::Cache c;
+        const std::vector<std::string>* r = &c.roots(0, 12, 1.f);
+        const std::string* first = r->data();
+        assert(r->size() == 12 && (*r)[7] == "7 (G)");
+        assert(c.roots(0, 12, 1.f).data() == first);                            // Same key: no rebuild
+        assert(c.roots(0, 19, 1.f).size() == 19);
+        const std::vector<std::string>& d = c.degrees(120, 10);
+        assert(d.size() == 120 && d[10] == "11 (C)" && d[40] == lb::degreeLabel(30, 120, 0));  // Page 2 restarts at 1
+        assert(c.degrees(12, 3)[3] == "4 (C)" && c.degrees(12, 0)[3] == "4 (D#)");
+    }
+
+    // --- Analysis_Worker (coalesced queries, results match the synchronous helpers) ---
+    {
+        namespace an = hi::music::analysis;
+        an::Worker w(false);                                                    // No thread: runOne() drives it
+        auto a = w.connect(), b = w.connect();
+        an::Result r;
+        assert(!a->result.read(r) && !w.runOne());
+        an::Query lyd; lyd.N = 12; lyd.useCustom = true; lyd.mask = {1,0,1,0,1,0,1,1,0,1,0,1};  // Lydian
+        an::Query chrom = lyd; chrom.mask.assign(12, 1);
+        w.submit(a, chrom);
+        w.submit(a, lyd);                                                       // Replaces the pending query
+        w.submit(b, lyd);
+        w.submit(b, lyd);                                                       // Repeat of the last key: dropped
+        assert(w.queued() == 2);
+        assert(w.runOne() && w.runOne() && !w.runOne());
+        assert(a->result.read(r) && r.key == an::key(lyd) && r.key != an::key(chrom));
+        assert(r.mos && r.mosM == 7 && r.mosG == 7);                            // Seven fifths up from the root
+        assert(r.bestGen == hi::music::mos::findBestGenerator(12, 7));
+        assert(r.scaleIndex == hi::music::findScaleIndex(lyd.mask, 12) && r.scaleIndex >= 0);
+        w.submit(a, lyd);
+        assert(w.queued() == 0);                                                // Already analyzed
+        an::Query off = lyd; off.useCustom = false;
+        const an::Result ro = an::analyze(off);
+        assert(!ro.mos && ro.scaleIndex == -1 && ro.key != r.key);
+        an::Query big; big.N = 53; big.useCustom = true; big.mask.assign(53, 0); big.mask[0] = big.mask[31] = 1;
+        const an::Result rb = an::analyze(big);
+        assert(!rb.mos && rb.bestGen == hi::music::mos::findBestGenerator(53, 7));  // MOS detection stops at N = 24
+    }
+
+    // --- PatchCodec (base64 mask bitsets, packed channel flags) ---
+    {
+        namespace pc = hi::util::patch;
+        std::vector<uint8_t> m, back;
+        assert(pc::encodeBits(m).empty() && pc::decodeBits("", 0, back) && back.empty());
+        m = {1,0,1,0,1,1,0,1,0,1,0,1};                                          // Major: bytes 0xB5 0x0A
+        assert(pc::encodeBits(m) == "tQo=");
+        assert(pc::decodeBits("tQo=", 12, back) && back == m);
+        for (int n : {1, 7, 8, 9, 16, 17, 24, 53, 120}) {                       // Every padding case
+            m.assign((size_t)n, 0);
+            for (int d = 0; d < n; d += 3) m[(size_t)d] = 1;
+            const std::string t = pc::encodeBits(m);
+            assert(t.size() == ((size_t)(n + 7) / 8 + 2) / 3 * 4);
+            back.clear();
+            assert(pc::decodeBits(t.c_str(), n, back) && back == m);
+        }
+        assert(pc::encodeBits(std::vector<uint8_t>(120, 1)).size() == 20);
+        back = {7};
+        assert(!pc::decodeBits("tQo=", 24, back) && back.size() == 1);          // Length mismatch: untouched
+        assert(!pc::decodeBits("tQ=o", 12, back) && !pc::decodeBits("tQo!", 12, back) && !pc::decodeBits(nullptr, 12, back));
+        bool f[16] = {false}, g[16];
+        f[0] = f[5] = f[15] = true;
+        const uint32_t bits = pc::packFlags(f, 16);
+        assert(bits == 0x8021u);
+        pc::unpackFlags(bits, g, 16);
+        for (int i = 0; i < 16; ++i) assert(g[i] == f[i]);
+    }
+
+    // --- SvgStream_Parity (chunked strip == whole-file strip for every chunk size) ---
+    {
+        namespace sv = hi::ui::svg;
+        const char* docs[] = {
+            "<?xml version=\"1.0\"?>\n<svg width=\"10mm\"><g><path d=\"M0 0\"/></g></svg>\n",
+            "<svg a=\"1\"><svg id=\"inner\"><rect/></svg><circle/></svg>  \n<!-- tail -->",
+            "<svg><g/>",                                                        // No close: everything after the tag
+            "<svg</svg><g/>",                                                   // Close inside the tag only
+            "<svg no-gt",                                                       // Unterminated tag: whole input
+            "plain text, no svg at all",
+            "",
+        };
+        for (const char* d : docs) {
+            const std::string src(d), want = sv::stripOuter(src);
+            for (size_t chunk = 1; chunk <= src.size() + 1; ++chunk) {
+                std::ostringstream os;
+                sv::InnerStreamer st(os);
+                for (size_t i = 0; i < src.size(); i += chunk) st.feed(src.data() + i, std::min(chunk, src.size() - i));
+                st.finish();
+                assert(os.str() == want);
+            }
+        }
+        assert(sv::stripOuter(docs[1]) == "<svg id=\"inner\"><rect/></svg><circle/>");
+        std::ostringstream none;
+        assert(!sv::copyInner("/nonexistent/panel.svg", none) && none.str().empty());
+    }
+
     printf("All core tests passed.\n");
     return 0; // All assertions passed.
 }
@@ -8,6 +8,7 @@
 #include <map>
 #include <unordered_set>
 #include <set>
+#include <bitset>
 
 // Phase 3D: JSON bridge (verbatim relocation of quantization field packing/unpacking)
 // Provide json_t without forcing Rack dependency when building headless tests.
@@ -52,6 +53,23 @@ struct ShapeParams { float k = 0.f; float c = 1.f; bool negative = false; };
 ShapeParams makeShape(float shape, float kPos = 6.f, float kNeg = 8.f);
 // u in [0,1] normalized progress → multiplier (≥ eps) shaping rise/fall curvature.
 float shapeMul(float u, const ShapeParams& p, float eps = 1e-6f);
+// ShapeLUT: shapeMul(u, makeShape(shape), eps) sampled at kSize+1 points of u ∈ [0,1].
+// Rebuilt only when the shape knob moves; the u = 1 entry (the Equal-time glide's
+// steady state) is exact, interior points interpolate linearly.
+struct ShapeLUT {
+	static constexpr int kSize = 32;
+	float shape = 0.f; float eps = 0.f; bool valid = false;
+	ShapeParams params;                      // makeShape(shape) (kept for scalar reference paths)
+	float tbl[kSize + 1] = {0};
+	// Rebuild when shape/eps changed; returns true when the table was rebuilt.
+	bool update(float shape, float eps);
+	float at(float u) const {
+		u = u < 0.f ? 0.f : (u > 1.f ? 1.f : u);
+		const float x = u * (float)kSize; const int i = (int)x;
+		if (i >= kSize) return tbl[kSize];
+		return tbl[i] + (tbl[i + 1] - tbl[i]) * (x - (float)i);
+	}
+};
 }}} // namespace hi::dsp::glide
 
 namespace hi { namespace dsp { namespace range {
@@ -75,12 +93,23 @@ HystThresholds computeHysteresis(float centerVolts, const HystSpec& h) noexcept;
 // baseStep: integer snapped center step; posWithinStep: raw fractional offset relative to that step (-0.5..+0.5 range semantics)
 // slopeDir: -1 descending, +1 ascending, 0 neutral; returns 0 adjust (center) or +/-1 step bias request.
 int pickRoundingTarget(int baseStep, float posWithinStep, int slopeDir, RoundPolicy pol) noexcept;
+// QuantBound: snapEDO(boundToLimit) step window for one ±limit, precomputed so bounded
+// snaps clamp in O(1) instead of scanning the whole range for an allowed step.
+struct QuantBound {
+	float limit = -1.f;                                  // Limit these steps were computed for
+	int minStep = 0, maxStep = 0;                         // ∓floor(limit * stepsPerVolt)
+	int loStep = 0, hiStep = 0;                           // Lowest/highest allowed step inside the window (or the window edge)
+};
+
 // Quantization config and snapper supporting arbitrary period sizes (EDO/TET)
 struct QuantConfig {
 	int edo = 12; float periodOct = 1.f; int root = 0; bool useCustom = false; bool customFollowsRoot = true;
 	int scaleIndex = 0;
 	const uint8_t* customMaskGeneric = nullptr; int customMaskLen = 0;
+	const QuantBound* boundCache = nullptr; // Optional computeQuantBound() result; used when its limit matches
 };
+// Step window for snapEDO(*, qc, limit, true): O(edo) once per config instead of per snap.
+QuantBound computeQuantBound(const QuantConfig& qc, float limit);
 // Snap a voltage to the nearest allowed EDO/TET degree per QuantConfig.
 float snapEDO(float volts, const QuantConfig& qc, float boundLimit = 10.f, bool boundToLimit = false, int shiftSteps = 0);
 // Helper predicates (exposed because PolyQuanta.cpp logic references them for hysteresis/latched decisions)
@@ -90,6 +119,88 @@ int nearestAllowedStep(int sGuess, float fs, const QuantConfig& qc);
 // FIX: Stateful tie-breaking version for boundary stability
 int nearestAllowedStepWithHistory(int sGuess, float fs, const QuantConfig& qc, int prevStep);
 
+// QuantPlan: precompiled quantizer tables shared by all channels. Built only when
+// the tuning/root/mask changes; per-sample queries are O(1) lookups (no ring scans)
+// and return exactly what isAllowedStep/nextAllowedStep/nearestAllowedStep/snapEDO
+// (unbounded) return for the equivalent QuantConfig.
+// Warped plans (Scala tunings, degrees != nullptr in build()) keep the same
+// integer step space but place step s at tonic + period·floor(s/N) + degree[s mod N];
+// stepPos() maps volts back to fractional steps (linear between degrees) through a
+// uniform bucket index, so masks, latches and nudges work unchanged.
+struct QuantPlan {
+	int N = 12; float periodOct = 1.f; int root = 0;      // Effective tuning (N > 0)
+	float stepsPerVolt = 12.f;                           // N / periodOct (same float math as snapEDO)
+	bool chromatic = true;                               // No usable mask ⇒ every step allowed
+	bool anyAllowed = true;                              // False when the mask has no active degree
+	std::vector<uint8_t> mask;                           // Root-relative mask copy (change detection + config())
+	std::vector<uint8_t> allowed;                        // Root-rotated: allowed[pc] for absolute pitch class pc
+	std::vector<int> upDist, dnDist;                     // Distance 1..N to next allowed degree above/below pc (0 = none)
+	std::vector<float> stepVolts;                        // (float)s / stepsPerVolt for s in [-stepVoltsSpan, +stepVoltsSpan]
+	int stepVoltsSpan = 0;                               // Covers ±kStepVoltsRange V (capped at kMaxStepVoltsSpan)
+	static constexpr float kStepVoltsRange = 10.f;
+	static constexpr int kMaxStepVoltsSpan = 8192;
+	std::vector<float> degree;                           // Warped: N+1 ascending offsets (octaves), [0] = 0, [N] = period; empty = equal steps
+	float tonic = 0.f;                                   // Warped: volts of step 0
+	std::vector<int> bucketLo;                           // Warped: last degree at or below each 1/(4N) of the period
+	// Rebuild tables; mask is used only when len == N (matches the module's QuantConfig wiring).
+	// degrees: N offsets in octaves (ascending, [0] = 0, all < period) for a warped grid.
+	void build(int edo, float period, int rootStep, const uint8_t* maskData, int maskLen,
+	           const float* degrees = nullptr, float tonicVolts = 0.f);
+	// True when build() with these arguments would produce the current tables.
+	bool matches(int edo, float period, int rootStep, const uint8_t* maskData, int maskLen,
+	             const float* degrees = nullptr, float tonicVolts = 0.f) const;
+	// Equivalent QuantConfig (points into this plan's mask; valid until the next build()).
+	// QuantConfig has no warped form: for warped plans it describes the equal-step grid.
+	QuantConfig config() const;
+	bool warped() const { return !degree.empty(); }
+	// Warped: fractional step position of a voltage (linear between adjacent degrees).
+	double stepPos(float volts) const;
+	// Fractional steps of a voltage on this grid.
+	float toSteps(float volts) const { return warped() ? (float)stepPos(volts) : volts * stepsPerVolt; }
+	// Grid voltage of step s as the hysteresis math sees it ((s / N) · period on equal grids).
+	float center(int s) const { return warped() ? volts(s) : (s / (float)N) * periodOct; }
+	bool isAllowed(int s) const { return chromatic || allowed[(size_t)pcOf(s)] != 0; }
+	// nextAllowedStep(): first allowed step strictly above/below s, or s if none.
+	int next(int s, int dir) const {
+		if (dir == 0) return s;
+		if (chromatic) return s + (dir > 0 ? 1 : -1);
+		const int k = (dir > 0 ? upDist : dnDist)[(size_t)pcOf(s)];
+		return k ? s + (dir > 0 ? k : -k) : s;
+	}
+	// nearestAllowedStep(): nearest allowed step to fs; ties keep the upward candidate.
+	int nearest(float fs) const;
+	// Output voltage of step s: table lookup inside the ±10 V span, the same division outside.
+	float volts(int s) const {
+		const int i = s + stepVoltsSpan;
+		if ((unsigned)i < (unsigned)stepVolts.size()) return stepVolts[(size_t)i];
+		if (!warped()) return (float)s / stepsPerVolt;
+		const int pc = pcOf(s);
+		return tonic + (float)((s - pc) / N) * periodOct + degree[(size_t)pc];
+	}
+	// Step snap() lands on for the voltage of step s: s itself when allowed (the fast path).
+	int snapStep(int s) const {
+		if (isAllowed(s)) return s;
+		return nearest(warped() ? (float)s : ((float)s / (float)N) * periodOct * stepsPerVolt);
+	}
+	// Step snapBounded() lands on for step s nudged by ±0.51 steps (dir = +1/-1).
+	int nudgeStep(int s, int dir, const QuantBound& b) const {
+		int t = nearest((float)s + (dir > 0 ? 0.51f : -0.51f));
+		if (t > b.maxStep) t = b.hiStep; else if (t < b.minStep) t = b.loStep;
+		return t;
+	}
+	// snapEDO(volts, config(), *, false, 0): snap to the nearest allowed degree in volts.
+	float snap(float volts) const;
+	// Step window for snapEDO(volts, config(), limit, true, 0).
+	QuantBound bound(float limit) const;
+	// snapEDO(volts, config(), b.limit, true, 0): nearest allowed degree, pulled back inside ±limit.
+	float snapBounded(float volts, const QuantBound& b) const {
+		int s = nearest(toSteps(volts));
+		if (s > b.maxStep) s = b.hiStep; else if (s < b.minStep) s = b.loStep;
+		return this->volts(s);
+	}
+	int pcOf(int s) const { int r = s % N; return (r < 0) ? r + N : r; }
+};
+
 // -----------------------------------------------------------------------------
 // Phase 3D: CoreState captures ONLY quantization/tuning/scale/mask/rounding/
 // hysteresis/root-alignment fields exactly as previously serialized in
@@ -116,8 +227,11 @@ struct CoreState {
 };
 
 // Write EXACT existing keys/values (no renames, order preserved as much as possible).
-void coreToJson(json_t* root, const CoreState& s) noexcept;
-// Read SAME keys; apply defaults for missing ones. NO behavior change.
+// compact (hi::util::patch schema 2): the mask as "customMaskBits" (base64), channel enables
+// as "qzEnabledBits", shifts as a "postOctShiftCh" array, and fields at their CoreState
+// default left out.
+void coreToJson(json_t* root, const CoreState& s, bool compact = false) noexcept;
+// Read SAME keys; apply defaults for missing ones. Packed keys win over legacy ones when present.
 void coreFromJson(const json_t* root, CoreState& s) noexcept;
 }} // namespace hi::dsp
 
@@ -132,8 +246,58 @@ extern const std::map<int, std::vector<int>> curated; // relocated
 int gcdInt(int a, int b);                              // relocated
 std::vector<int> generateCycle(int N, int g, int m);   // relocated
 bool isMOS(const std::vector<int>& pcs, int N);        // relocated
-int findBestGenerator(int N, int m);                   // relocated
+int findBestGenerator(int N, int m);                   // relocated (memoized via memo::get for N <= kMaxN)
+int findBestGeneratorRef(int N, int m);                // node-container reference of findBestGenerator
 std::string patternLS(const std::vector<int>& pcs, int N); // relocated
+
+// Process-wide MOS memo: per (N, m), the cycle / MOS flag / L-S pattern for every generator
+// plus the best generator, as fixed-size bitsets. Filled lazily on first use and immutable
+// afterwards, so any number of instances (and threads) share one table.
+namespace memo {
+static constexpr int kMaxN = 128;                      // Largest division memoized (EDO/TET go to 120)
+using Bits = std::bitset<kMaxN>;
+struct Entry {
+    int N = 0, m = 0;
+    int best = 1;                                      // findBestGenerator(N, m)
+    Bits cycle[kMaxN];                                 // generateCycle(N, g, m) as a pitch-class set
+    Bits large[kMaxN];                                 // patternLS of that cycle: bit i = step i is 'L'
+    uint8_t size[kMaxN] = {0};                         // Cycle length (< m when gcd(g, N) > 1)
+    Bits mos;                                          // Bit g: isMOS(cycle[g], N)
+    std::string pattern(int g) const;                  // == patternLS(generateCycle(N, g, m), N)
+    std::vector<int> pcs(int g) const;                 // == generateCycle(N, g, m)
+};
+// nullptr unless 2 <= m <= N <= kMaxN.
+const Entry* get(int N, int m);
+}
+
+// Packed custom-mask mirror for MOS detection: Zobrist hash, pitch-class count and a histogram of
+// the cyclic step sizes, all updated in O(1) per toggled degree (only the two steps adjacent to
+// the degree change). assign() is the O(N) rebuild used after bulk edits.
+struct MaskState {
+    static constexpr int kWords = (memo::kMaxN + 63) / 64;
+    uint64_t words[kWords] = {0};        // Bit p = pitch class p (root-relative) is in the mask
+    int N = 0;                           // Division count (0 = not built)
+    int count = 0;                       // Pitch classes set
+    int distinct = 0;                    // Distinct step sizes
+    uint64_t hash = 0;                   // XOR of zobrist(p) over set pitch classes
+    uint8_t stepHist[memo::kMaxN + 1] = {0}; // Steps of each size between cyclic neighbours
+    // False when N is outside [1, kMaxN] (callers fall back to a full scan).
+    bool assign(const uint8_t* mask, int len, int N);
+    void toggle(int p);
+    bool test(int p) const { return (words[p >> 6] >> (p & 63)) & 1u; }
+    bool isMOS() const { return count >= 2 && distinct <= 2; }   // == isMOS(set pitch classes, N)
+    memo::Bits bits() const;
+    static uint64_t zobrist(int p);
+private:
+    void step(int size, int delta);
+    int prevSet(int p) const;            // Nearest set pitch class cyclically before p (p if alone)
+    int nextSet(int p) const;            // Nearest set pitch class cyclically after p
+};
+
+// MOS size and generator of a root-relative mask: the cycle of the first coprime generator
+// that reproduces it (status-line rule: 2 <= N <= 24, 2..24 pitch classes). Thread-safe
+// (reads the shared memo only); false when ms is not an N-step MOS.
+bool detect(const MaskState& ms, int N, int& mOut, int& gOut);
 }}} // namespace hi::music::mos
 
 namespace hi { namespace dsp { namespace poly {
@@ -0,0 +1,836 @@
+#include "PolyQuantaEngine.hpp"
+#include <algorithm>
+#include <cmath>
+#include "Strum.hpp"
+/*
+ * PolyQuantaEngine.cpp — Per-sample PolyQuanta signal chain, moved verbatim
+ * from PolyQuanta::process(). Rack calls (ports, lights, rack::clamp) are
+ * replaced by plain arrays and std::min/std::max; the stage order,
+ * latch/hysteresis logic and settle bookkeeping are unchanged.
+ */
+namespace hi { namespace dsp {
+using namespace hi::dsp::polytrans;
+namespace hconst = hi::consts;
+
+static inline float _clampf(float x, float lo, float hi) { return std::max(lo, std::min(x, hi)); }
+
+PolyQuantaEngine::PolyQuantaEngine() {
+    for (int i = 0; i < 16; ++i) {
+        voices.latchedInit[i] = false;                              // No quantizer step latched yet
+        voices.latchedStep[i] = 0;                                  // Default to step 0 when latching begins
+        preScale[i] = 1.f;                                          // No scaling by default (1.0x multiplier)
+        preOffset[i] = 0.f;                                         // No pre-offset by default (0V addition)
+        voices.stepNorm[i] = 10.f;                                  // Initialize step normalization to safe default
+        voices.stepSign[i] = 0;                                     // Initialize step direction to neutral
+        voices.slews.invalidateRates(i);                            // Mark rise/fall rates as uninitialized
+    }
+}
+
+void PolyQuantaEngine::reset() {
+    for (int i = 0; i < 16; ++i) {
+        voices.stepNorm[i] = 10.f;                                  // Reset step normalization to safe default
+        voices.stepSign[i] = 0;                                     // Reset step direction to neutral
+        voices.slews.invalidateRates(i);                            // Mark rise/fall rates as uninitialized
+        voices.lastOut[i] = 0.f;                                    // Clear last output value
+        voices.ledBright[2*i + 0] = voices.ledBright[2*i + 1] = 0.f; // Turn off both channel LEDs
+        voices.strumDelayAssigned[i] = 0.f;                         // Clear assigned strum delay
+        voices.strumPrevTarget[i] = 0.f;                            // Reset last processed target snapshot
+        voices.strumPrevInit[i] = false;                            // Mark strum target history as uninitialized
+        voices.latchedInit[i] = false;                              // Reset initialization latch
+        preScale[i] = 1.f;                                          // Reset pre-range scaling to unity
+        preOffset[i] = 0.f;                                         // Reset pre-range offset to zero
+        voices.latchedStep[i] = 0;                                  // Reset step latch counter
+        voices.prevYRel[i] = 0.f;                                   // Reset previous relative position
+    }
+    voices.strumSched.clear();                                      // Release every start-delay hold
+    ctl.phase = 0; ctl.valid = false;                               // Re-evaluate controls without ramping
+    wakeAllVoices();                                                // Cleared state: rerun every voice
+}
+
+void PolyQuantaEngine::applyControls(const ControlSnapshot& cs) {
+    ctl.beginEval();
+    voices.slews.setShapes(cs.riseShape, cs.fallShape);
+    ctl.clipLimit = cs.clipLimit;
+    ctl.useAttv = cs.useAttv;
+    ctl.gsecAdd = cs.gsecAdd;
+    ctl.gGain[1] = cs.gain;
+    ctl.rangeOffset[1] = cs.rangeOffset;
+    ctl.globalOffset[1] = cs.globalOffset;
+    for (int c = 0; c < 16; ++c) {
+        ctl.off[1][c] = cs.off[c];
+        ctl.slSec[c] = cs.slSec[c];
+    }
+    refreshQuantPlan();
+    ctl.quantBound = plan->bound(ctl.clipLimit);
+    ctl.endEval();
+}
+
+float PolyQuantaEngine::advanceControl() {
+    const int div = ctlrate::isValidDiv(controlRateDiv) ? controlRateDiv : 1;
+    // A phase left over from a larger divisor ends the block at full weight, then wraps
+    const float w = (controlRateSmooth && div > 1) ? std::min((float)(ctl.phase + 1) / (float)div, 1.f) : 1.f;
+    if (++ctl.phase >= div) ctl.phase = 0;
+    return w;
+}
+
+void PolyQuantaEngine::refreshQuantPlan() {
+    int N, root, mode, tet, scale; float period; bool custom;
+    if (const hi::dsp::tuning::Snapshot* ts = tuningX.acquire()) {
+        // Published tuning: whole snapshot or nothing (no half-edited mask, no allocation)
+        if (ts != tuning) {                                         // Snapshot holds the pool reference
+            if (ts->plan.get() != plan) ++quantPlanGen;             // Identical republish: same interned plan, nothing to wake
+            tuning = ts; plan = ts->plan.get();
+        }
+        N = ts->N; period = ts->period; root = ts->rootNote; mode = ts->tuningMode;
+        tet = ts->tetSteps; scale = ts->scaleIndex; custom = ts->useCustomScale;
+    } else {
+        if (tuningMode == 0) {
+            N = (edo <= 0) ? 12 : edo;
+            period = 1.f;
+        } else {
+            N = tetSteps > 0 ? tetSteps : 9;
+            period = (tetPeriodOct > 0.f) ? tetPeriodOct : std::log2(3.f/2.f);
+        }
+        const bool maskOk = useCustomScale && (int)customMaskGeneric.size() == N;
+        const uint8_t* mask = maskOk ? customMaskGeneric.data() : nullptr;
+        const int maskLen = maskOk ? N : 0;
+        const float* deg = (tuningMode == 2 && (int)scalaDegrees.size() == N) ? scalaDegrees.data() : nullptr;
+        if (!quantPlan.matches(N, period, rootNote, mask, maskLen, deg, scalaTonic)) {
+            quantPlan.build(N, period, rootNote, mask, maskLen, deg, scalaTonic); // Config change only: O(N) table build
+            ++quantPlanGen;
+        }
+        plan = &quantPlan;
+        root = rootNote; mode = tuningMode; tet = tetSteps; scale = scaleIndex; custom = useCustomScale;
+    }
+
+    // Detect quantizer configuration changes and reset latched state
+    bool cfgChanged = (prevRootNote != root || prevScaleIndex != scale ||
+                      prevEdo != N || prevTetSteps != tet ||
+                      prevTetPeriodOct != period || prevTuningMode != mode ||
+                      prevUseCustomScale != custom);
+    if (cfgChanged) {
+        for (int k = 0; k < 16; ++k) voices.latchedInit[k] = false; // Reset all channels
+        diag.add(hi::dsp::diag::Relatches);
+        ++quantPlanGen;
+        prevRootNote = root; prevScaleIndex = scale; prevEdo = N;
+        prevTetSteps = tet; prevTetPeriodOct = period; prevTuningMode = mode;
+        prevUseCustomScale = custom;
+    }
+}
+
+bool PolyQuantaEngine::publishTuning() {
+    const hi::dsp::tuning::Snapshot* last = tuningX.latest();
+    if (last && last->sameSource(tuningMode, edo, tetSteps, tetPeriodOct, useCustomScale,
+                                 customMaskGeneric, rootNote, scaleIndex, scalaDegrees, scalaTonic)) return false;
+    hi::dsp::tuning::Snapshot* s = new hi::dsp::tuning::Snapshot();
+    s->build(tuningMode, edo, tetSteps, tetPeriodOct, useCustomScale, customMaskGeneric, rootNote, scaleIndex,
+             scalaDegrees, scalaTonic);
+    tuningX.publish(s);
+    return true;
+}
+
+int PolyQuantaEngine::updateWidth(bool inConn, int inCh) {
+    int desiredProcN, desiredOutN;
+    desiredWidth(inConn, inCh, desiredProcN, desiredOutN);
+    return beginWidth(desiredProcN, desiredOutN);
+}
+
+void PolyQuantaEngine::desiredWidth(bool inConn, int inCh, int& procN, int& outN) const {
+    // Calculate desired processing and output channel counts
+    if (forcedChannels > 0)
+        procN = std::max(1, std::min(forcedChannels, 16));          // User-forced channel count
+    else
+        procN = hi::dsp::poly::processWidth(false, inConn, inCh, 16); // Auto-detect from input
+    outN = sumToMonoOut ? 1 : procN;                                // Mono sum or match processing width
+}
+
+int PolyQuantaEngine::beginWidth(int desiredProcN, int desiredOutN) {
+    // Initialize current counts on the first sample
+    if (polyTrans.curProcN <= 0 && polyTrans.curOutN <= 0) {
+        polyTrans.curProcN = desiredProcN;                          // Set initial processing channel count
+        polyTrans.curOutN = desiredOutN;                            // Set initial output channel count
+        polyTrans.transPhase = TRANS_STABLE;                        // Mark as stable (no transition)
+        polyTrans.polyRamp = 1.f;                                   // Full volume (no fade)
+    }
+
+    // Detect a change in desired channel counts and initiate transition
+    bool widthChange = (desiredProcN != polyTrans.curProcN) || (desiredOutN != polyTrans.curOutN);
+    if (widthChange && polyTrans.transPhase == TRANS_STABLE) {
+        diag.add(hi::dsp::diag::PolyTransitions);
+        polyTrans.pendingProcN = desiredProcN;                      // Store pending processing count
+        polyTrans.pendingOutN = desiredOutN;                        // Store pending output count
+
+        // Start fade out if time > 0, otherwise immediate switch
+        if (polyFadeSec > 0.f) {
+            polyTrans.transPhase = TRANS_FADE_OUT;                  // Begin fade-out transition
+        } else {
+            // Immediate switch (no fade time configured)
+            polyTrans.curProcN = polyTrans.pendingProcN;           // Apply new processing count immediately
+            polyTrans.curOutN = polyTrans.pendingOutN;             // Apply new output count immediately
+            polyTrans.initToTargetsOnSwitch = true;                // Flag for target initialization
+            polyTrans.transPhase = TRANS_STABLE;                   // Return to stable state
+            polyTrans.polyRamp = 1.f;                              // Full volume (no fade needed)
+        }
+    }
+    // Output channel count for this sample (current, not desired, during transitions)
+    return polyTrans.curOutN;
+}
+
+int PolyQuantaEngine::render(const float* in, int inCh, bool inConn, float ctlW, float dt, float* out) {
+    // ═══════════════════════════════════════════════════════════════════════════
+    // GLOBAL PARAMETER PREPARATION - Block-rate values from evalControls()
+    // ═══════════════════════════════════════════════════════════════════════════
+    const float clipLimit = ctl.clipLimit;                          // Current range limit setting
+    const float gsecAdd = ctl.gsecAdd;                              // Additional slew time in seconds
+    const bool useAttv = ctl.useAttv;                               // Attenuverter mode active
+    const float gGain = ctl.at(ctl.gGain, ctlW);                    // Attenuverter gain multiplier
+    const float rangeOffset = ctl.at(ctl.rangeOffset, ctlW);        // Applied AFTER range, BEFORE quantizer
+    const float globalOffset = ctl.at(ctl.globalOffset, ctlW);      // Applied with per-channel offsets
+
+    // Pre-range limiter/scaler mode: operates around 0V only; offset is applied after this
+    const hi::dsp::range::Mode preRangeMode = rangeMode == 0 ? hi::dsp::range::Mode::Clip : hi::dsp::range::Mode::Scale;
+    namespace ln = hi::dsp::lanes;                                 // SoA lane stages (vector or *Ref per ln::kVector)
+
+    // ═══════════════════════════════════════════════════════════════════════════
+    // MAIN DSP PROCESSING - Two-Pass Algorithm for Slew and Quantization
+    // ═══════════════════════════════════════════════════════════════════════════
+
+    bool modeChanged = (pitchSafeGlide != prevPitchSafeGlide);     // Detect pitch-safe mode changes
+    float outVals[16] = {0};                                       // Final output values per channel
+
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    // Pass 1: Compute Target Values and Detect Step Changes for Strum Timing
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    float targetArr[16] = {0};                                     // Target values after processing
+    float aerrVArr[16] = {0};                                      // Absolute step error in volts (reused by pass 2)
+    float aerrNArr[16] = {0};                                      // Normalized step error for strum
+    int32_t signArr[16] = {0};                                     // Step direction for strum ordering
+    bool targetChangedArr[16] = {false};                           // Tracks raw target changes for strum detection
+
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    // Input/Offset Gather: Input Voltages and Knob Values Into 16-Lane SoA Arrays
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    float inArr[16] = {0};                                         // Channels beyond input count remain at 0V
+    float offArr[16] = {0};                                        // Per-channel offset knobs
+    int32_t snapArr[16] = {0};                                     // Offset quantization mode per channel
+    for (int c = 0; c < polyTrans.curProcN; ++c) {
+        if (inConn) {
+            if (inCh <= 1)
+                inArr[c] = in[0];                                  // Mono input to all channels
+            else if (c < inCh)
+                inArr[c] = in[c];                                  // Polyphonic input per channel
+        }
+        offArr[c] = ctl.offAt(c, ctlW);                            // Block-rate knob (ramped when smoothing)
+        snapArr[c] = snapOffsetModeCh[c];
+    }
+
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    // Lane Stages: Attenuverter → Offset (+Snap) → Pre-Range Transform → Step Error
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    ln::TargetParams tp;
+    tp.useGain = useAttv; tp.gain = gGain; tp.globalOffset = globalOffset;
+    tp.stepsPerVolt = plan->stepsPerVolt;                          // Offset snap grid: steps per period / period size
+    (ln::kVector ? ln::computeTargets : ln::computeTargetsRef)(inArr, offArr, snapArr, preScale, preOffset, tp, polyTrans.curProcN, targetArr);
+    // lastOut is not written until the end of pass 2, so pass 2 reuses these errors as-is
+    (ln::kVector ? ln::stepError : ln::stepErrorRef)(targetArr, voices.lastOut, pitchSafeGlide, polyTrans.curProcN, aerrVArr, aerrNArr, signArr);
+
+    for (int c = 0; c < polyTrans.curProcN; ++c) {
+        // Detect actual target changes for strum handling (skip noise-level moves)
+        bool targetChanged = false;
+        if (voices.strumPrevInit[c]) {
+            targetChanged = std::fabs(targetArr[c] - voices.strumPrevTarget[c]) > STRUM_TARGET_TOL;
+        }
+        voices.strumPrevTarget[c] = targetArr[c];                  // Update history for next block
+        voices.strumPrevInit[c] = true;                            // Mark history initialized
+        targetChangedArr[c] = targetChanged;                       // Remember change flag for assignment
+    }
+
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    // Strum Delay Assignment: Calculate Per-Channel Timing Offsets for Chord Articulation
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    // Trigger strum delay assignment when step changes are detected
+    if (strumEnabled && strumMs > 0.f && polyTrans.curProcN > 1) {
+        float tmp[16] = {0};                                       // Delays for the current width and mode
+        bool tmpReady = false;                                     // Computed on the first retrigger only
+        for (int c = 0; c < polyTrans.curProcN; ++c) {
+            // Assign new delays when: mode changed, target changed, direction flipped, or step jumped
+            if (!(modeChanged || targetChangedArr[c] || signArr[c] != voices.stepSign[c] || aerrNArr[c] > voices.stepNorm[c]))
+                continue;
+            if (!tmpReady) {
+                // Convert strum mode to DSP enum
+                hi::dsp::strum::Mode mode = (strumMode == 0 ? hi::dsp::strum::Mode::Up :
+                                            (strumMode == 1 ? hi::dsp::strum::Mode::Down :
+                                             hi::dsp::strum::Mode::Random));
+                hi::dsp::strum::assign(strumMs, polyTrans.curProcN, mode, tmp, rng); // Calculate strum delays
+                tmpReady = true;
+            }
+            voices.strumDelayAssigned[c] = tmp[c];                 // Store assigned delay
+            voices.strumSched.schedule(c, hi::dsp::strum::delaySamples(tmp[c], dt)); // (Re)queue the hold
+            diag.add(hi::dsp::diag::StrumAssigns);
+        }
+    }
+
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    // Pass 2: Apply Slew, Range Processing, and Quantization with Strum Timing
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    // Idle-Voice Fast Path: Wake Settled Voices on Drift or Configuration Change
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    hi::dsp::settle::Sig sig;
+    sig.quantizerPos = (int)quantizerPos; sig.quantRoundMode = quantRoundMode; sig.rangeMode = rangeMode;
+    sig.strumMode = strumMode; sig.strumType = strumType; sig.curProcN = polyTrans.curProcN;
+    sig.softClipOut = softClipOut; sig.pitchSafeGlide = pitchSafeGlide; sig.strumEnabled = strumEnabled;
+    sig.quantStrength = quantStrength; sig.stickinessCents = stickinessCents; sig.clipLimit = clipLimit;
+    sig.rangeOffset = rangeOffset; sig.gsecAdd = gsecAdd; sig.strumMs = strumMs;
+    sig.riseShape = voices.slews.riseLut.shape; sig.fallShape = voices.slews.fallLut.shape; sig.dt = dt;
+    sig.planGen = quantPlanGen;
+    const bool sigSame = (sig == settleSig) && !modeChanged;
+    settleSig = sig;
+    hi::dsp::settle::VoiceKey keyNow[16];
+    hi::dsp::settle::VoiceState stateBefore[16];
+    bool allSettled = true;
+    for (int c = 0; c < polyTrans.curProcN; ++c) {
+        keyNow[c].target = targetArr[c]; keyNow[c].slSec = ctl.slSec[c]; keyNow[c].postOctShift = postOctShift[c];
+        keyNow[c].qzEnabled = qzEnabled[c]; keyNow[c].slewEnabled = slewEnabled[c];
+        if (voices.settled[c]) {
+            // Stay idle only while the target sits within tolerance of the settle-time target
+            bool keep = sigSame && keyNow[c].sameConfig(voices.settleKey[c]) && !targetChangedArr[c] &&
+                        std::fabs(targetArr[c] - voices.settleKey[c].target) <= STRUM_TARGET_TOL && !voices.strumSched.held(c);
+            if (!keep) voices.settled[c] = false;                  // Wake (frozen key blocks re-settling on stale history)
+        }
+        if (!voices.settled[c]) { stateBefore[c] = captureVoice(c); allSettled = false; }
+    }
+    const int passN = allSettled ? 0 : polyTrans.curProcN;          // All idle: every pass-2 stage is a no-op
+
+    // Per-channel values carried between the scalar (slew/quantizer) and lane stages
+    float secArr[16] = {0};                                        // Effective slew time
+    bool noSlewArr[16] = {false};                                  // Slew bypass per channel
+    int32_t holdArr[16] = {0};                                     // Start-delay hold (lane mask source)
+    int32_t slewArr[16] = {0};                                     // Lanes the slew bank advances this sample
+    float slewRemArr[16] = {0};                                    // Pre mode: |yMix - lastOut| per lane
+    float yMixArr[16] = {0};                                       // Pre mode: strength blend fed to the slew bank
+    float yRawArr[16] = {0};                                       // Post-slew (Post mode) or target (Pre mode)
+    float yPreArr[16] = {0};                                       // After pre-quant range limiting
+    float yFinalArr[16] = {0};                                     // Quantizer/slew result before output clip
+
+    for (int c = 0; c < passN; ++c) {
+        if (voices.settled[c]) { yRawArr[c] = voices.lastOut[c]; noSlewArr[c] = true; continue; } // Idle voice: no slew/step update
+        float target = targetArr[c];                               // Get pre-computed target value
+
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        // Step Analysis: Error and Direction From Pass 1 (lastOut unchanged since)
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        float aerrN = aerrNArr[c];                                 // Normalized error
+        int sign = signArr[c];                                     // Step direction
+
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        // Slew Rate Calculation: Combine Per-Channel, Global, and Strum Timing
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        float sec = ctl.slSec[c];                                  // Per-channel slew time (block rate)
+        float gsec = gsecAdd;                                      // Global slew addition from dual-mode
+        float assignedDelay = (strumEnabled && passN > 1) ? voices.strumDelayAssigned[c] : 0.f;
+
+        if (strumEnabled && strumType == 0) {
+            // Time-stretch mode: add assigned delay to effective glide time
+            sec += gsec + assignedDelay;
+        } else {
+            // Start-delay mode: no time-stretch addition; delay handled separately below
+            sec += gsec;
+        }
+
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        // Slew Processing Gate: Check Time Threshold and Per-Channel Enable State
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        bool chSlewDisabled = !slewEnabled[c];                    // Per-channel slew disable flag
+        bool noSlew = (sec <= hconst::MIN_SEC) || chSlewDisabled;  // Skip slew if time too short or disabled
+
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        // Step Change Detection: Update Tracking State When New Steps Are Detected
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        if (modeChanged || sign != voices.stepSign[c] || aerrN > voices.stepNorm[c]) {
+            voices.stepSign[c] = sign;                             // Update step direction
+            voices.stepNorm[c] = std::max(aerrN, hconst::EPS_ERR); // Update step magnitude (with minimum)
+        }
+
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        // Start Delay Processing: Handle Strum Timing in Start-Delay Mode
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        float yRaw = target;                                       // Initialize with target value
+        bool inStartDelay = (strumEnabled && strumType == 1 && voices.strumSched.held(c));
+        secArr[c] = sec; noSlewArr[c] = noSlew; holdArr[c] = inStartDelay; yRawArr[c] = yRaw;
+        // Slew BEFORE the quantizer (Post mode) only when the voice is not being held by start-delay
+        slewArr[c] = (!inStartDelay && !noSlew && quantizerPos == QuantizerPos::Post);
+    }
+    // Post mode: shape-aware Equal-time slew toward target; remaining distance is the pass-1 error
+    if (quantizerPos == QuantizerPos::Post) {
+        if (ln::kVector) voices.slews.process(targetArr, aerrVArr, secArr, slewArr, dt, passN, yRawArr);
+        else voices.slews.processRef(targetArr, aerrVArr, secArr, slewArr, dt, passN, yRawArr);
+    }
+
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    // Pre-Quantization Processing: Range Limiting (Lanes) and Octave Shifting
+    // ───────────────────────────────────────────────────────────────────────────────────────────────
+    (ln::kVector ? ln::preRange : ln::preRangeRef)(yRawArr, preRangeMode, clipLimit, softClipOut, passN, yPreArr);
+
+    for (int c = 0; c < passN; ++c) {
+        if (voices.settled[c]) { yFinalArr[c] = voices.lastOut[c]; continue; } // Idle voice: skip quantizer
+        const bool noSlew = noSlewArr[c];
+        const bool inStartDelay = holdArr[c] != 0;
+        float yPre = yPreArr[c];
+        // Apply range offset and octave shift before quantizer to shift whole quantization window
+        float yBasePre = yPre + rangeOffset + (float)postOctShift[c] * 1.f;
+
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        // Quantizer Position Logic: Pre (Q→S) vs Post (S→Q) Processing Order
+        // ───────────────────────────────────────────────────────────────────────────────────────────
+        float yFinal = 0.f;
+        if (quantizerPos == QuantizerPos::Pre) {
+            // ───────────────────────────────────────────────────────────────────────────────────────
+            // Pre-Quantization Mode: Legacy Q→S Order (Quantize → Mix Strength → Slew)
+            // ───────────────────────────────────────────────────────────────────────────────────────
+            float yPreForQ = yBasePre;                             // Input includes range offset & octave shift
+            float yRel = yPreForQ - rangeOffset;                   // Remove range offset for quantizer
+            float yQRel = yRel;                                    // Will hold quantized relative volts
+
+            if (qzEnabled[c]) {
+                // ───────────────────────────────────────────────────────────────────────────────────
+                // Core Quantizer Configuration: Setup Scale and Tuning Parameters
+                // ───────────────────────────────────────────────────────────────────────────────────
+                // Shared precompiled tables (rebuilt only on config change by refreshQuantPlan())
+                const hi::dsp::QuantPlan& qp = *plan;
+                const hi::dsp::QuantBound& qb = ctl.quantBound;    // ±clipLimit step window for nudges
+
+                // ───────────────────────────────────────────────────────────────────────────────────
+                // Step Calculation and Latched State Initialization
+                // ───────────────────────────────────────────────────────────────────────────────────
+                int N = qp.N;
+                float period = qp.periodOct;
+                double fs = qp.warped() ? qp.stepPos(yRel)        // Scala grid: position between degrees
+                                        : (double)yRel * (double)N / (double)period; // Convert voltage to fractional steps
+
+                if (!voices.latchedInit[c]) {
+                    voices.latchedStep[c] = qp.nearest((float)fs);
+                    voices.lastFs[c] = fs;                         // Seed direction state with current fs
+                    voices.lastDir[c] = 0;                         // Start neutral so peaks don't mis-set direction
+                    voices.latchedInit[c] = true;
+                }
+                // Chained input that still sits on the step upstream latched with this same plan
+                const bool preSnapped = chainStep && chainPlan == plan && qp.isAllowed(chainStep[c])
+                                        && std::fabs(fs - (double)chainStep[c]) < 1e-3;
+
+                // ───────────────────────────────────────────────────────────────────────────────────
+                // Directional Snap: Hysteresis-Based Quantization with Direction Memory
+                // ───────────────────────────────────────────────────────────────────────────────────
+                int baseStep = (int)std::round(fs);                // Default for non-directional modes
+                int dir = 0;                                       // Direction state for Directional Snap
+
+                if (quantRoundMode == 0) {                         // Directional Snap mode
+                    float Hc = _clampf(stickinessCents, 0.f, 20.f); // Hysteresis in cents
+                    const float maxAllowed = 0.4f * 1200.f * (period / (float)N); // Maximum reasonable hysteresis
+                    if (Hc > maxAllowed) Hc = maxAllowed;          // Clamp to reasonable range
+                    float Hs = (Hc * (float)N) / 1200.0f;         // Convert cents to steps
+                    float Hd = std::max(0.75f * Hs, 0.02f);       // Widen direction hysteresis slightly
+                    double d = fs - voices.lastFs[c];              // Calculate step delta
+                    dir = voices.lastDir[c];                       // Get previous direction
+                    if (d > +Hd) dir = +1;                        // Moving up beyond hysteresis
+                    else if (d < -Hd) dir = -1;                   // Moving down beyond hysteresis
+                    // else: stay in current direction (hysteresis)
+
+                    if (dir > 0)      baseStep = (int)std::ceil(fs);  // Round up when moving up
+                    else if (dir < 0) baseStep = (int)std::floor(fs); // Round down when moving down
+                    else              baseStep = voices.latchedStep[c]; // Hold candidate at peak/valley
+                    voices.lastDir[c] = dir;                       // Update direction state
+                    voices.lastFs[c] = fs;                         // Update position state
+                }
+
+                // Ensure latched step is valid in current scale
+                if (!qp.isAllowed(voices.latchedStep[c])) {
+                    voices.latchedStep[c] = qp.nearest((float)fs);
+                }
+
+                // ───────────────────────────────────────────────────────────────────────────────────
+                // Target Step Selection: Directional vs Standard Quantization
+                // ───────────────────────────────────────────────────────────────────────────────────
+                int targetStep;
+                if (quantRoundMode == 0) {                         // Directional Snap mode
+                    int candidate = voices.latchedStep[c];         // Start with current latched step
+                    if (dir > 0)
+                        candidate = qp.next(voices.latchedStep[c], +1); // Move to next higher allowed step
+                    else if (dir < 0)
+                        candidate = qp.next(voices.latchedStep[c], -1); // Move to next lower allowed step
+                    // dir == 0: hold candidate at current latched step
+                    targetStep = candidate;
+                } else {
+                    // Standard quantization modes: nearest, up, down
+                    targetStep = qp.nearest((float)fs);
+                    (void)baseStep;                                // nearestAllowedStep never read its guess (s0 = round(fs))
+                }
+                // ───────────────────────────────────────────────────────────────────────────────────
+                // Schmitt Latch Logic: Center-Anchored Hysteresis for Stable Quantization
+                // ───────────────────────────────────────────────────────────────────────────────────
+                float Hc = _clampf(stickinessCents, 0.f, 20.f);        // Hysteresis in cents
+                float stepCents = 1200.f * (period / (float)N);        // Cents per step in current tuning
+                const float maxAllowed = 0.4f * stepCents;             // Maximum reasonable hysteresis (40% of step)
+                if (Hc > maxAllowed) Hc = maxAllowed;                  // Clamp to prevent excessive hysteresis
+                float Hs = (Hc * (float)N) / 1200.0f;                 // Convert cents to steps
+                float d = (float)(fs - (double)voices.latchedStep[c]); // Distance from latched center (in steps)
+                float upThresh = +0.5f + Hs;                           // Upper switching threshold
+                float downThresh = -0.5f - Hs;                         // Lower switching threshold
+
+                // Switch latched step only when crossing thresholds and only by ±1 step
+                if (targetStep > voices.latchedStep[c] && d > upThresh)
+                    voices.latchedStep[c] = voices.latchedStep[c] + 1; // Move up one step
+                else if (targetStep < voices.latchedStep[c] && d < downThresh)
+                    voices.latchedStep[c] = voices.latchedStep[c] - 1; // Move down one step
+                // else: hold at latchedStep[c] (within hysteresis zone)
+
+                if (preSnapped) voices.latchedStep[c] = chainStep[c]; // Upstream's latch already ran on this signal
+
+                // Output step: the latched step, or the allowed step snap() would pick for it
+                int qStep = qp.snapStep(voices.latchedStep[c]);
+                yQRel = qp.volts(qStep);
+
+                // ───────────────────────────────────────────────────────────────────────────────────
+                // Advanced Rounding Mode Processing: Directional Nudging and Scale-Aware Selection
+                // ───────────────────────────────────────────────────────────────────────────────────
+                if (quantRoundMode != 1 && !preSnapped) {
+                    // Step-aware rounding: derive the active tuning's volts-per-step so nudges follow the scale grid
+                    const float rawStepVolts = (N > 0 && period > 0.f)
+                                                 ? (period / static_cast<float>(N))
+                                                 : 0.f;
+                    const float voltsPerStep = (rawStepVolts > 0.f) ? rawStepVolts : (1.f / 12.f);
+                    const float stepTolVolts = std::max(1e-5f, voltsPerStep * 1e-3f); // ~0.1% of a step for hysteresis
+                    const float stepTolSteps = stepTolVolts / voltsPerStep;
+                    const float diffVolts = yRel - yQRel;
+                    const float diffSteps = diffVolts / voltsPerStep;
+                    float prev = voices.prevYRel[c];
+                    float dir = (yRel > prev + 1e-6f) ? 1.f : (yRel < prev - 1e-6f ? -1.f : 0.f);
+                    int slopeDir = (dir > 0.f) ? +1 : (dir < 0.f ? -1 : 0);
+
+                    // Map quantization mode to DSP rounding mode
+                    hi::dsp::RoundMode rm = (quantRoundMode == 0 ? hi::dsp::RoundMode::Directional :
+                                            (quantRoundMode == 2 ? hi::dsp::RoundMode::Ceil :
+                                            (quantRoundMode == 3 ? hi::dsp::RoundMode::Floor : hi::dsp::RoundMode::Nearest)));
+                    hi::dsp::RoundPolicy rp{rm};
+                    (void)hi::dsp::pickRoundingTarget(0, diffSteps, (int)slopeDir, rp);
+
+                    // Apply directional nudging based on rounding mode (step thresholds follow tuning scale)
+                    // Nudges work on steps: a 51% step bias re-snapped inside the ±clipLimit window
+                    int nudge = 0;
+                    if (rm == hi::dsp::RoundMode::Directional) {
+                        if (slopeDir > 0 && diffSteps > 0.f) nudge = +1;
+                        else if (slopeDir < 0 && diffSteps < 0.f) nudge = -1;
+                    } else if (rm == hi::dsp::RoundMode::Ceil) {
+                        if (diffSteps > stepTolSteps) nudge = +1;
+                    } else if (rm == hi::dsp::RoundMode::Floor) {
+                        if (diffSteps < -stepTolSteps) nudge = -1;
+                    }
+                    if (nudge) {
+                        const int t = qp.nudgeStep(qStep, nudge, qb);
+                        if ((t - qStep) * nudge > 0) { yQRel = qp.volts(t); diag.add(hi::dsp::diag::Nudges); }
+                    }
+                    voices.prevYRel[c] = yRel;                         // Update previous value for direction tracking
+                } else {
+                    voices.prevYRel[c] = yRel;                         // Update previous value even when not processing
+                }
+            } else {
+                voices.prevYRel[c] = yRel;                             // Update previous value when quantizer disabled
+            }
+
+            // ───────────────────────────────────────────────────────────────────────────────────────
+            // Quantization Strength Blending: Mix Raw and Quantized Signals
+            // ───────────────────────────────────────────────────────────────────────────────────────
+            float yQAbs = yQRel + rangeOffset;                         // Add range offset back to quantized signal
+            float t = _clampf(quantStrength, 0.f, 1.f);                // Quantization strength (0=raw, 1=quantized)
+            float yMix = yPreForQ + (yQAbs - yPreForQ) * t;            // Blend raw (yPreForQ) and quantized signals
+
+            // ───────────────────────────────────────────────────────────────────────────────────────
+            // Post-Quantization Slew Processing (Pre Mode): Apply Slew AFTER Quantization
+            // ───────────────────────────────────────────────────────────────────────────────────────
+            // Slew targets the quantized blend; the slew bank runs after this loop
+            float yPost = yMix;                                        // Initialize with blended value
+            yMixArr[c] = yMix;
+            slewRemArr[c] = std::fabs(yMix - voices.lastOut[c]);       // Distance to blended target
+            slewArr[c] = (!noSlew && !inStartDelay);
+            yFinal = yPost;                                            // Set final output for Pre mode (slewed lanes overwritten below)
+        } else {
+            // ───────────────────────────────────────────────────────────────────────────────────────
+            // Post-Quantization Mode: S→Q Order (Slew → Quantize for Pitch Stability)
+            // ───────────────────────────────────────────────────────────────────────────────────────
+            float ySlewed = yPre + rangeOffset + (float)postOctShift[c] * 1.f; // Apply range offset and octave shift
+            float yRel = (ySlewed - rangeOffset);                      // Remove range offset for quantizer input
+            float yOutQuant = ySlewed;                                 // Will hold final blended result
+
+            if (qzEnabled[c]) {
+                // ───────────────────────────────────────────────────────────────────────────────────
+                // Post-Mode Quantizer Logic: Operating on Already-Slewed Signal
+                // ───────────────────────────────────────────────────────────────────────────────────
+                // Shared precompiled tables (rebuilt only on config change by refreshQuantPlan())
+                const hi::dsp::QuantPlan& qp = *plan;
+                int N = qp.N;
+                float period = qp.periodOct;
+
+                // Step calculation and latched state initialization
+                float fs = qp.warped() ? (float)qp.stepPos(yRel)       // Scala grid: position between degrees
+                                       : yRel * (float)N / period;     // Convert voltage to fractional steps
+                if (!voices.latchedInit[c]) {
+                    voices.latchedStep[c] = qp.nearest(fs);
+                    voices.latchedInit[c] = true;
+                }
+                if (!qp.isAllowed(voices.latchedStep[c])) {
+                    voices.latchedStep[c] = qp.nearest(fs);
+                }
+                const bool preSnapped = chainStep && chainPlan == plan && qp.isAllowed(chainStep[c])
+                                        && std::fabs(fs - (float)chainStep[c]) < 1e-3f;
+                // Hysteresis-based Schmitt latch for stable quantization
+                float dV = period / (float)N;                          // Voltage per step
+                float stepCents = 1200.f * dV;                         // Cents per step
+                float Hc = _clampf(stickinessCents, 0.f, 20.f);        // Clamp hysteresis to reasonable range
+                float maxAllowed = 0.4f * stepCents;                   // Maximum hysteresis (40% of step size)
+                if (Hc > maxAllowed) Hc = maxAllowed;                  // Prevent excessive hysteresis
+                float H_V = Hc / 1200.f;                               // Convert cents to voltage
+
+                // Calculate adjacent allowed steps for hysteresis boundaries
+                int upStep = qp.next(voices.latchedStep[c], +1);
+                int dnStep = qp.next(voices.latchedStep[c], -1);
+                float center = qp.center(voices.latchedStep[c]);       // Current step voltage
+                float vUp = qp.center(upStep);                         // Next step up voltage
+
+                // Compute hysteresis thresholds around current step
+                hi::dsp::HystSpec hs{ (vUp - center) * 2.f, H_V };
+                auto th = hi::dsp::computeHysteresis(center, hs);
+                float T_up = th.up;                                    // Upper threshold
+                float T_down = th.down;                                // Lower threshold
+
+                // Apply Schmitt latch logic for step transitions
+                if (yRel >= T_up && upStep != voices.latchedStep[c])
+                    voices.latchedStep[c] = upStep;
+                else if (yRel <= T_down && dnStep != voices.latchedStep[c])
+                    voices.latchedStep[c] = dnStep;
+
+                if (preSnapped) voices.latchedStep[c] = chainStep[c]; // Same plan upstream: adopt its step
+
+                // Output step: the latched step, or the allowed step snap() would pick for it
+                float yqRel = qp.volts(qp.snapStep(voices.latchedStep[c]));
+                // Advanced rounding modes for fine-tuned quantization behavior
+                if (quantRoundMode != 1 && !preSnapped) {
+                    float rawSemi = yRel * 12.f;                           // Raw signal in semitones
+                    float snappedSemi = yqRel * 12.f;                      // Quantized signal in semitones
+                    float diff = rawSemi - snappedSemi;                    // Difference for rounding decisions
+                    float prev = voices.prevYRel[c];                       // Previous voltage for direction detection
+                    float dir = (yRel > prev + 1e-6f) ? 1.f : (yRel < prev - 1e-6f ? -1.f : 0.f);
+                    int slopeDir = (dir > 0.f) ? +1 : (dir < 0.f ? -1 : 0); // Direction: +1=up, -1=down, 0=static
+
+                    // Map quantRoundMode to DSP rounding mode
+                    hi::dsp::RoundMode rm = (quantRoundMode == 0 ? hi::dsp::RoundMode::Directional :
+                                           (quantRoundMode == 2 ? hi::dsp::RoundMode::Ceil :
+                                           (quantRoundMode == 3 ? hi::dsp::RoundMode::Floor :
+                                                                 hi::dsp::RoundMode::Nearest)));
+                    hi::dsp::RoundPolicy rp{rm};
+                    float posWithin = diff;
+                    (void)hi::dsp::pickRoundingTarget(0, posWithin, slopeDir, rp);
+
+                    // Scale-aware directional selection (replaces chromatic nudging)
+                    if (rm == hi::dsp::RoundMode::Directional && std::fabs(diff) > 1e-5f) {
+                        int targetStep = (slopeDir > 0) ? qp.next(voices.latchedStep[c], +1) :
+                                                         qp.next(voices.latchedStep[c], -1);
+                        if (targetStep != voices.latchedStep[c]) {
+                            yqRel = qp.volts(targetStep);
+                            diag.add(hi::dsp::diag::Nudges);
+                        }
+                    } else if (rm == hi::dsp::RoundMode::Ceil && diff > 1e-5f) {
+                        int targetStep = qp.next(voices.latchedStep[c], +1);
+                        if (targetStep != voices.latchedStep[c]) {
+                            yqRel = qp.volts(targetStep);
+                            diag.add(hi::dsp::diag::Nudges);
+                        }
+                    } else if (rm == hi::dsp::RoundMode::Floor && diff < -1e-5f) {
+                        int targetStep = qp.next(voices.latchedStep[c], -1);
+                        if (targetStep != voices.latchedStep[c]) {
+                            yqRel = qp.volts(targetStep);
+                            diag.add(hi::dsp::diag::Nudges);
+                        }
+                    }
+                    voices.prevYRel[c] = (ySlewed - rangeOffset);          // Track pre-quant slew for direction
+                } else {
+                    voices.prevYRel[c] = (ySlewed - rangeOffset);          // Standard nearest mode tracking
+                }
+                // Quantization strength blending (Post mode)
+                float yq = yqRel + rangeOffset;                        // Add range offset back to quantized signal
+                float t = _clampf(quantStrength, 0.f, 1.f);            // Clamp blend factor to valid range
+                yOutQuant = ySlewed + (yq - ySlewed) * t;              // Blend: raw slewed + (quantized - raw) * strength
+                // Note: In Post mode, raw signal is ySlewed (already processed through slew)
+            } else {
+                voices.prevYRel[c] = (ySlewed - rangeOffset);          // Track voltage for next frame
+            }
+            float yPost = yOutQuant;                               // Final quantized output (already slewed)
+            yFinal = yPost;                                        // Set as final channel output
+        }
+
+        // ───────────────────────────────────────────────────────────────────────────────────────
+        // Final Output Processing and Channel State Updates
+        // ───────────────────────────────────────────────────────────────────────────────────────
+        // Note: Strength crossfade raw source varies by mode:
+        // - Pre mode uses yPre (yPreForQ) as raw signal for blending
+        // - Post mode uses ySlewed as raw signal for blending
+
+        yFinalArr[c] = yFinal;
+    }
+    // Pre mode: shape-aware slew AFTER quantization over all slewing lanes
+    if (quantizerPos == QuantizerPos::Pre) {
+        if (ln::kVector) voices.slews.process(yMixArr, slewRemArr, secArr, slewArr, dt, passN, yFinalArr);
+        else voices.slews.processRef(yMixArr, slewRemArr, secArr, slewArr, dt, passN, yFinalArr);
+    }
+
+    // Apply output voltage limiting with soft or hard clipping (lanes)
+    // Hold the previously latched output while start-delay counts down so the quantizer
+    // can still track the incoming gesture (prevents Directional Snap from chasing late).
+    (ln::kVector ? ln::finishOutputs : ln::finishOutputsRef)(yFinalArr, voices.lastOut, holdArr, softClipOut, hconst::MAX_VOLT_CLAMP, passN, outVals);
+    for (int c = 0; c < passN; ++c) {
+        if (voices.settled[c]) { outVals[c] = voices.lastOut[c]; diag.add(hi::dsp::diag::Settled); continue; } // Idle voice: re-emit (LED already converged)
+        if (voices.latchedStep[c] != stateBefore[c].latchedStep) diag.add(hi::dsp::diag::Snaps);
+        voices.lastOut[c] = outVals[c];                            // Update last output for next frame
+        hi::dsp::led::setBipolar(voices.ledBright[2*c + 0], voices.ledBright[2*c + 1], outVals[c], dt);
+        // Fixed point: same inputs/config and a full run left the state untouched ⇒ settle
+        bool idle = sigSame && keyNow[c] == voices.settleKey[c] && holdArr[c] == 0 && !voices.strumSched.held(c) &&
+                    captureVoice(c) == stateBefore[c] &&
+                    hi::dsp::led::bipolarSettled(voices.ledBright[2*c + 0], voices.ledBright[2*c + 1], voices.lastOut[c]);
+        voices.settleKey[c] = keyNow[c];                           // Settle-time key is the reference while idle
+        voices.settled[c] = idle;
+    }
+    if (allSettled) {
+        for (int c = 0; c < polyTrans.curProcN; ++c) outVals[c] = voices.lastOut[c]; // Every voice idle: pass 2 skipped
+        diag.add(hi::dsp::diag::Settled, (uint64_t)polyTrans.curProcN);
+    }
+
+    // Advance the strum clock; only channels whose hold expires this sample are touched
+    voices.strumSched.advance();
+
+    // ───────────────────────────────────────────────────────────────────────────────────────
+    // Polyphonic Output Processing with Fade Management
+    // ───────────────────────────────────────────────────────────────────────────────────────
+    // Apply polyphony transition ramp for pop-free fade during channel count changes
+    float ramp = _clampf(polyTrans.polyRamp, 0.f, 1.f);             // Get current fade ramp (0=silent, 1=full)
+    int outN = 0;
+
+    if (sumToMonoOut) {
+        // Sum all active channels to single mono output
+        float sum = 0.f;
+        for (int c = 0; c < polyTrans.curProcN; ++c)
+            sum += outVals[c];                                     // Accumulate all channel outputs
+        if (avgWhenSumming && polyTrans.curProcN > 0)
+            sum /= (float)polyTrans.curProcN;                      // Average instead of sum if enabled
+        out[0] = _clampf(sum * ramp, -hconst::MAX_VOLT_CLAMP, hconst::MAX_VOLT_CLAMP);
+        outN = 1;
+    } else {
+        // Standard polyphonic output - each channel gets its own output
+        (ln::kVector ? ln::scale : ln::scaleRef)(outVals, ramp, polyTrans.curProcN, out); // Apply fade ramp to each channel
+        outN = polyTrans.curProcN;
+    }
+
+    // Clear LEDs for inactive channels to prevent visual artifacts
+    for (int c = polyTrans.curProcN; c < 16; ++c) {
+        voices.ledBright[2*c + 0] = 0.f;                           // Clear positive LED
+        voices.ledBright[2*c + 1] = 0.f;                           // Clear negative LED
+    }
+
+    // ───────────────────────────────────────────────────────────────────────────────────────
+    // Polyphony Transition State Machine
+    // ───────────────────────────────────────────────────────────────────────────────────────
+    // Handle fade phase progression at the end of processing block
+    if (polyTrans.transPhase == TRANS_FADE_OUT) {
+        if (polyFadeSec <= 0.f) {                                 // Instant fade (no time specified)
+            polyTrans.polyRamp = 0.f;                             // Set ramp to silent immediately
+        } else {
+            // Gradual fade-out over specified time period
+            polyTrans.polyRamp = std::max(0.f, polyTrans.polyRamp - dt / polyFadeSec);
+        }
+        if (polyTrans.polyRamp <= 0.f + 1e-6f) {
+            // Fade-out complete - switch to new channel configuration while silent
+            polyTrans.curProcN = polyTrans.pendingProcN;          // Update processing channel count
+            polyTrans.curOutN  = polyTrans.pendingOutN;           // Update output channel count (caller resizes the port)
+            polyTrans.initToTargetsOnSwitch = true;               // Flag for target reinitialization
+            polyTrans.transPhase = TRANS_FADE_IN;                 // Begin fade-in phase
+        }
+    } else if (polyTrans.transPhase == TRANS_FADE_IN) {
+        // Fade-in phase: reinitialize targets and gradually increase volume
+        if (polyTrans.initToTargetsOnSwitch) {
+            // Recompute targets for the new width with the pass-1 target stage (current block values)
+            // so the fade starts from where the chain is heading instead of the old voices' outputs
+            float reIn[16] = {0}, reOff[16] = {0}, reTarget[16] = {0};
+            int32_t reSnap[16] = {0};
+            for (int c = 0; c < polyTrans.curProcN; ++c) {
+                if (inConn) {
+                    if (inCh <= 1) reIn[c] = in[0];                // Mono input
+                    else if (c < inCh) reIn[c] = in[c];            // Polyphonic input
+                }
+                reOff[c] = ctl.off[1][c];
+                reSnap[c] = snapOffsetModeCh[c];
+            }
+            ln::TargetParams rp;
+            rp.useGain = ctl.useAttv; rp.gain = ctl.gGain[1]; rp.globalOffset = ctl.globalOffset[1];
+            rp.stepsPerVolt = plan->stepsPerVolt;
+            ln::computeTargetsRef(reIn, reOff, reSnap, preScale, preOffset, rp, polyTrans.curProcN, reTarget);
+            for (int c = 0; c < polyTrans.curProcN; ++c) {
+                // Initialize slew processors and output states to current targets
+                voices.lastOut[c] = reTarget[c];                   // Set last output to target
+                voices.settled[c] = false;                         // State reseeded: leave the idle fast path
+                voices.slews.reset(c);                             // Reset slew processor state
+                voices.strumPrevTarget[c] = reTarget[c];           // Seed strum change detector with current target
+                voices.strumPrevInit[c] = true;                    // Mark detector initialized after poly switch
+            }
+            polyTrans.initToTargetsOnSwitch = false;               // Clear reinitialization flag
+            polyTrans.polyRamp = 0.f;                              // Start from silence
+        }
+
+        // ───────────────────────────────────────────────────────────────────────────────────────
+        // Fade-In Progression
+        // ───────────────────────────────────────────────────────────────────────────────────────
+        if (polyFadeSec <= 0.f) {                                 // Instant fade-in
+            polyTrans.polyRamp = 1.f;                             // Set ramp to full volume
+        } else {
+            // Gradual fade-in over specified time period
+            polyTrans.polyRamp = std::min(1.f, polyTrans.polyRamp + dt / polyFadeSec);
+        }
+        if (polyTrans.polyRamp >= 1.f - 1e-6f) {
+            polyTrans.polyRamp = 1.f;                              // Ensure exact 1.0 when complete
+            polyTrans.transPhase = TRANS_STABLE;                   // Transition to stable state
+        }
+    } else {
+        // Stable State - No Polyphony Transition Active
+        polyTrans.polyRamp = 1.f;                                 // Keep ramp at full volume
+    }
+
+    prevPitchSafeGlide = pitchSafeGlide;                          // Remember mode for next frame
+    return outN;
+}
+int PolyQuantaEngine::processBlock(const float* in, float* out, int frames, int channels, float dt,
+                                   const ControlSnapshot& cs, int* outCh) {
+    const bool inConn = channels > 0;
+    const int inCh = inConn ? std::min(channels, 16) : 0;
+    // One input width per call: the desired width is resolved once for every frame
+    int wantProcN, wantOutN;
+    desiredWidth(inConn, inCh, wantProcN, wantOutN);
+    // One snapshot per call: the first due frame applies it (quantizer plan, bound); later
+    // control blocks only roll the ramp history, which is all a re-apply of cs would change
+    const int div = ctlrate::isValidDiv(controlRateDiv) ? controlRateDiv : 1;
+    bool applied = false;
+    for (int f = 0; f < frames; ++f) {
+        float* o = out + f * kFrameStride;
+        if (polyTrans.transPhase == TRANS_STABLE) beginWidth(wantProcN, wantOutN); // Running fades advance in render()
+        float w = 1.f;                                             // Every-sample controls, already applied
+        if (!(applied && div == 1)) {
+            if (controlDue()) {
+                if (!applied) applyControls(cs);
+                else ctl.beginEval();
+                applied = true;
+            }
+            w = advanceControl();
+        }
+        const int n = render(in + f * kFrameStride, inCh, inConn, w, dt, o);
+        for (int c = n; c < kFrameStride; ++c) o[c] = 0.f;
+        if (outCh) outCh[f] = polyTrans.curOutN;
+    }
+    return polyTrans.curOutN;
+}
+}} // namespace hi::dsp
@@ -0,0 +1,349 @@
+#pragma once
+/*
+ * PolyQuantaEngine.hpp — Rack-independent PolyQuanta signal chain.
+ * Holds the menu/JSON settings the chain reads, the tuning configuration, all
+ * per-voice DSP state (latches, slew bank, strum timers, idle-voice cache, LED
+ * brightness) and the per-sample pass structure formerly inlined in
+ * PolyQuanta::process(): poly-width transitions, target assembly, strum
+ * assignment, slew, range, quantizer (Pre/Post), output clip and poly fade.
+ *
+ * Hosts drive it per sample with plain data: updateWidth(), a ControlSnapshot at
+ * each control block (applyControls), then render() over input/output float
+ * arrays. The Rack module derives from PolyQuantaEngine and only adapts ports,
+ * params and lights, so settings keep their names for menus, JSON and widgets;
+ * other FUNmodules modules can embed it the same way. The headless replay
+ * harness (tests/replay.cpp) drives the same code under UNIT_TESTS.
+ */
+#include <cstdint>
+#include <vector>
+#include <cmath>
+#include "PolyQuantaCore.hpp"
+#include "Lanes.hpp"
+#include "Strum.hpp"
+#include "Diagnostics.hpp"
+#include "TuningSnapshot.hpp"
+
+// Polyphony transition utilities for smooth channel count changes
+namespace hi { namespace dsp { namespace polytrans {
+// Enumeration for polyphony transition phases
+enum Phase {
+    TRANS_STABLE = 0,   // Normal operation, no transition in progress
+    TRANS_FADE_OUT,     // Fading out before changing channel count
+    TRANS_FADE_IN       // Fading in after changing channel count
+};
+
+// State structure for managing polyphony transitions
+struct State {
+    int curProcN = 0;           // Current number of processing channels
+    int curOutN = 0;            // Current number of output channels
+    int pendingProcN = 0;       // Target number of processing channels
+    int pendingOutN = 0;        // Target number of output channels
+    float polyRamp = 1.f;       // Fade multiplier (0.0 = silent, 1.0 = full volume)
+    Phase transPhase = TRANS_STABLE;  // Current transition phase
+    bool initToTargetsOnSwitch = false;  // Flag to reinitialize on channel switch
+};
+}}} // namespace hi::dsp::polytrans
+
+// Control-rate decimation: parameter-derived values evaluated once per block of
+// `div` samples (div = 1 evaluates every sample, the legacy behavior).
+namespace hi { namespace dsp { namespace ctlrate {
+static constexpr int kDivs[] = {1, 4, 16, 32};  // Menu choices: every N samples
+static inline bool isValidDiv(int d) { for (int k : kDivs) if (k == d) return true; return false; }
+// Cached control values; ramped fields keep [0] = previous block, [1] = current block.
+struct Block {
+    int phase = 0;                 // Samples since the last evaluation (0 = evaluate now)
+    bool valid = false;            // False until the first evaluation (no ramp from stale values)
+    float gGain[2] = {1.f, 1.f};   // Attenuverter gain (ramped)
+    float globalOffset[2] = {0.f, 0.f}; // Global offset (ramped)
+    float rangeOffset[2] = {0.f, 0.f};  // Range offset (ramped)
+    float off[2][16] = {{0.f}};    // Per-channel offset knobs (ramped)
+    bool useAttv = false;          // Attenuverter active
+    float gsecAdd = 0.f;           // Global slew time addition (s)
+    float slSec[16] = {0.f};       // Per-channel knob slew time (s)
+    float clipLimit = 10.f;        // Pre-quant range half-limit (V)
+    hi::dsp::QuantBound quantBound; // Allowed-step window for ±clipLimit (nudge bound)
+    float rndTimeRaw = 0.5f;       // Auto-randomize time knob
+    float rndIntervalSec = 1.f;    // Free-running auto-randomize interval (s)
+    // Shift current → previous before writing a new block; first evaluation has no history.
+    void beginEval() {
+        if (!valid) return;
+        gGain[0] = gGain[1]; globalOffset[0] = globalOffset[1]; rangeOffset[0] = rangeOffset[1];
+        for (int c = 0; c < 16; ++c) off[0][c] = off[1][c];
+    }
+    void endEval() {
+        if (valid) return;
+        gGain[0] = gGain[1]; globalOffset[0] = globalOffset[1]; rangeOffset[0] = rangeOffset[1];
+        for (int c = 0; c < 16; ++c) off[0][c] = off[1][c];
+        valid = true;
+    }
+    // w in (0,1]: fraction of the block elapsed; w = 1 returns the current value exactly.
+    static float at(const float* v, float w) { return (w >= 1.f) ? v[1] : v[0] + (v[1] - v[0]) * w; }
+    float offAt(int c, float w) const { return (w >= 1.f) ? off[1][c] : off[0][c] + (off[1][c] - off[0][c]) * w; }
+};
+}}} // namespace hi::dsp::ctlrate
+
+// Idle-voice fast path: a voice whose pass-2 state is a fixed point (the same target and
+// configuration reproduce the same output and state) is "settled" and re-emits lastOut
+// until its target drifts beyond tolerance or any configuration input changes.
+namespace hi { namespace dsp { namespace settle {
+// Module-wide pass-2 inputs besides the per-voice target (compared sample to sample).
+struct Sig {
+    int quantizerPos = -1, quantRoundMode = 0, rangeMode = 0, strumMode = 0, strumType = 0, curProcN = 0;
+    bool softClipOut = false, pitchSafeGlide = false, strumEnabled = false;
+    float quantStrength = 0.f, stickinessCents = 0.f, clipLimit = 0.f, rangeOffset = 0.f, gsecAdd = 0.f;
+    float strumMs = 0.f, riseShape = 0.f, fallShape = 0.f, dt = 0.f;
+    uint32_t planGen = 0;                // Bumped on every quantizer table rebuild / latch reset
+    bool operator==(const Sig& o) const {
+        return quantizerPos == o.quantizerPos && quantRoundMode == o.quantRoundMode && rangeMode == o.rangeMode &&
+               strumMode == o.strumMode && strumType == o.strumType && curProcN == o.curProcN &&
+               softClipOut == o.softClipOut && pitchSafeGlide == o.pitchSafeGlide && strumEnabled == o.strumEnabled &&
+               quantStrength == o.quantStrength && stickinessCents == o.stickinessCents && clipLimit == o.clipLimit &&
+               rangeOffset == o.rangeOffset && gsecAdd == o.gsecAdd && strumMs == o.strumMs &&
+               riseShape == o.riseShape && fallShape == o.fallShape && dt == o.dt && planGen == o.planGen;
+    }
+};
+// Per-voice pass-2 inputs: the target plus per-channel settings.
+struct VoiceKey {
+    float target = 0.f, slSec = 0.f; int postOctShift = 0; bool qzEnabled = false, slewEnabled = false;
+    bool sameConfig(const VoiceKey& o) const {
+        return slSec == o.slSec && postOctShift == o.postOctShift && qzEnabled == o.qzEnabled && slewEnabled == o.slewEnabled;
+    }
+    bool operator==(const VoiceKey& o) const { return target == o.target && sameConfig(o); }
+};
+// Per-voice pass-2 state; unchanged across one full run ⇒ fixed point.
+struct VoiceState {
+    float lastOut = 0.f, slewOut = 0.f, rise = 0.f, fall = 0.f, prevYRel = 0.f, stepNorm = 0.f;
+    double lastFs = 0.0; int latchedStep = 0, lastDir = 0, stepSign = 0; bool latchedInit = false;
+    bool operator==(const VoiceState& o) const {
+        return lastOut == o.lastOut && slewOut == o.slewOut && rise == o.rise && fall == o.fall &&
+               prevYRel == o.prevYRel && stepNorm == o.stepNorm && lastFs == o.lastFs &&
+               latchedStep == o.latchedStep && lastDir == o.lastDir && stepSign == o.stepSign && latchedInit == o.latchedInit;
+    }
+};
+}}} // namespace hi::dsp::settle
+
+// Bipolar (green/red) channel LED brightness, Rack-free.
+namespace hi { namespace dsp { namespace led {
+// rack::engine::Light::setBrightnessSmooth(): immediate rise, exponential fall.
+inline void smooth(float& b, float target, float dt, float lambda = 30.f) {
+    if (target < b) b += (target - b) * lambda * dt; else b = target;
+}
+// Positive voltages light the green LED (g), negative voltages the red LED (r).
+inline void setBipolar(float& g, float& r, float val, float dt) {
+    float gs = std::min(std::max( val / hi::consts::LED_SCALE_V, 0.f), 1.f);
+    float rs = std::min(std::max(-val / hi::consts::LED_SCALE_V, 0.f), 1.f);
+    smooth(g, gs, dt);
+    smooth(r, rs, dt);
+}
+// True when both LEDs already sit (within tol) where setBipolar() converges for val.
+inline bool bipolarSettled(float g, float r, float val, float tol = 1e-3f) {
+    float gs = std::min(std::max( val / hi::consts::LED_SCALE_V, 0.f), 1.f);
+    float rs = std::min(std::max(-val / hi::consts::LED_SCALE_V, 0.f), 1.f);
+    return std::fabs(g - gs) <= tol && std::fabs(r - rs) <= tol;
+}
+}}} // namespace hi::dsp::led
+
+// Block-latency FIFO for hosts that call once per sample (Rack): frames are collected until
+// `latency` are queued, rendered together with PolyQuantaEngine::processBlock(), and played
+// back `latency` samples late. latency 0 = no FIFO (render every sample directly).
+namespace hi { namespace dsp { namespace blockio {
+static constexpr int kLatencies[] = {0, 16, 64};   // Menu choices (samples)
+static constexpr int kMaxFrames = 64;
+static inline bool isValidLatency(int l) { for (int k : kLatencies) if (k == l) return true; return false; }
+struct Fifo {
+    int latency = 0;                     // Active block size; 0 = bypassed
+    int pos = 0;                         // Next frame slot (0..latency-1)
+    float in[kMaxFrames * 16] = {0.f};   // Queued input frames (stride 16)
+    int inCh[kMaxFrames] = {0};          // Input width per queued frame (0 = unpatched)
+    float out[kMaxFrames * 16] = {0.f};  // Rendered frames being played back (stride 16)
+    int outCh[kMaxFrames] = {0};         // Output width per rendered frame
+    // Switch block size; playback restarts from silence at outN channels.
+    void configure(int lat, int outN) {
+        latency = isValidLatency(lat) ? lat : 0; pos = 0;
+        for (float& v : out) v = 0.f;
+        for (int& n : outCh) n = outN;
+    }
+};
+}}} // namespace hi::dsp::blockio
+
+namespace hi { namespace dsp {
+// Every per-voice runtime array of the chain in one cache-line-aligned block, 16 lanes each
+// (SoA, so the 4-lane stages load straight out of it). The PolySlew bank sits last: its
+// out/rise/fall lanes follow the voice arrays and its shape tables close the block.
+struct alignas(64) VoiceBank {
+    float lastOut[16] = {0.f};               // Last output voltage per channel for continuity
+    float stepNorm[16] = {0.f};              // Current step magnitude (engine ctor seeds 10 V)
+    int   stepSign[16] = {0};                // Direction of current voltage change (+1=rising, -1=falling, 0=stable)
+    float prevYRel[16] = {0.f};              // Previous relative voltage for directional snap
+    double lastFs[16] = {0.0};               // Last fractional step position (high precision)
+    int   lastDir[16] = {0};                 // Last movement direction: -1=down, 0=hold, +1=up
+    int   latchedStep[16] = {0};             // Current latched step index (0..N-1)
+    float strumDelayAssigned[16] = {0.f};    // Initial delay assigned to each channel (s)
+    float strumPrevTarget[16] = {0.f};       // Last processed target per channel for strum change detection
+    float ledBright[32] = {0.f};             // Channel LEDs: [2c] green (+V), [2c+1] red (−V)
+    hi::dsp::settle::VoiceKey settleKey[16]; // Previous-sample key (frozen at settle time while settled)
+    bool  latchedInit[16] = {false};         // Quantizer latch seeded for this channel
+    bool  strumPrevInit[16] = {false};       // Tracks whether strumPrevTarget has been primed
+    bool  settled[16] = {false};             // Voice re-emits lastOut without running pass 2
+    hi::dsp::strum::Scheduler strumSched;    // Start-delay holds (queued channel = held)
+    hi::dsp::glide::PolySlew slews;          // Slew bank (SoA state + rise/fall shape tables)
+};
+
+// Knob-derived values for one control block, filled by the host (the Rack module reads
+// params and resolves the dual-mode banks) and handed to applyControls().
+struct ControlSnapshot {
+    float off[16] = {0.f};                   // Per-channel offset knobs (V)
+    float slSec[16] = {0.f};                 // Per-channel slew times (s)
+    float riseShape = 0.f, fallShape = 0.f;  // Glide curve shapes (-1 log .. +1 exp)
+    bool  useAttv = false;                   // Attenuverter active
+    float gain = 1.f;                        // Attenuverter gain (-10..+10)
+    float gsecAdd = 0.f;                     // Global slew time addition (s)
+    float globalOffset = 0.f;                // Added to every per-channel offset (V)
+    float rangeOffset = 0.f;                 // Applied after range, before the quantizer (V)
+    float clipLimit = 10.f;                  // Pre-quant range half-limit (V)
+};
+
+struct PolyQuantaEngine {
+    PolyQuantaEngine();
+
+    // ═══════════════════════════════════════════════════════════════════════════
+    // SETTINGS - Menu/JSON options read by the signal chain
+    // ═══════════════════════════════════════════════════════════════════════════
+    int forcedChannels = 0;        // Channel count: 0=Auto (match input), 1-16=force specific count
+    bool sumToMonoOut = false;     // Output mode: false=polyphonic, true=sum all channels to mono
+    bool avgWhenSumming = false;   // Summing behavior: false=add voltages, true=average voltages
+    bool pitchSafeGlide = false;   // Slew scaling: false=voltage-based, true=semitone-based (1V/oct)
+    bool softClipOut = false;      // Clipping type: false=hard clamp, true=soft saturation curve
+    int rangeMode = 0;             // 0=Clip (hard limit), 1=Scale (compress to fit)
+    int snapOffsetModeCh[16] = {0}; // Per-channel: 0=Voltage, 1=Semitones, 2=Cents
+    float polyFadeSec = 0.1f;      // Poly width change fade time in seconds (0.1s = 100ms default)
+
+    // Strum: per-channel timing offsets for chord articulation
+    bool strumEnabled = false;     // Master enable for strum timing (default: disabled)
+    int strumMode = 0;             // Pattern: 0=Up (1→16), 1=Down (16→1), 2=Random order
+    int strumType = 1;             // Timing behavior: 0=Time-stretch, 1=Start-delay (default)
+    float strumMs = 0.f;           // Inter-channel delay in milliseconds (0=simultaneous)
+    static constexpr float STRUM_TARGET_TOL = 1e-4f; // Strum target change hysteresis (volts)
+
+    // Quantizer position, strength and rounding
+    enum QuantizerPos { Pre = 0, Post = 1 };
+    int quantizerPos = QuantizerPos::Post;   // Default: Slew→Quantize (pitch-accurate)
+    float quantStrength = 1.f;              // Range: 0.0 (bypass) to 1.0 (full quantization)
+    int quantRoundMode = 0;                  // Default: Directional Snap for musical expression
+    float stickinessCents = 5.f;            // User range: 0-20 cents (auto-clamped to 40% of step size)
+
+    // Per-channel options
+    bool qzEnabled[16] = {false};            // Enable quantization for each channel
+    float preScale[16]  = {0};               // Scaling factor: -10.0 to +10.0 (default: 1.0)
+    float preOffset[16] = {0};               // Offset voltage: -10.0V to +10.0V (default: 0.0V)
+    int postOctShift[16] = {0};              // Octave shift per channel: -5 to +5 octaves (0 default)
+    bool slewEnabled[16] = {true, true, true, true, true, true, true, true,
+                            true, true, true, true, true, true, true, true};
+
+    // Control-rate decimation (see hi::dsp::ctlrate)
+    int controlRateDiv = 1;                 // Evaluate controls every N samples (1/4/16/32; 1 = every sample)
+    bool controlRateSmooth = true;          // Ramp offsets/gain across each block (avoids zipper steps)
+
+    // ═══════════════════════════════════════════════════════════════════════════
+    // TUNING - EDO/TET system, root and scale mask
+    // ═══════════════════════════════════════════════════════════════════════════
+    int tuningMode = 0;                      // 0 = EDO (octave-based), 1 = TET (non-octave), 2 = Scala
+    int edo = 12;                            // Default: 12-EDO (standard Western tuning)
+    int   tetSteps = 9;                      // Default: Carlos Alpha (9 divisions of perfect fifth)
+    float tetPeriodOct = std::log2(3.f/2.f); // Period size in octaves (log2 of frequency ratio)
+    // Scala mode (tuningMode 2, see hi::music::scala): tetSteps/tetPeriodOct hold the scale's N and
+    // period, these the warped degree grid. Ignored (equal steps) unless scalaDegrees.size() == N.
+    std::vector<float> scalaDegrees;         // Degree offsets in octaves, ascending, [0] = 0
+    float scalaTonic = 0.f;                  // Volts of degree 0 (from the .kbm reference)
+    bool useCustomScale = true;              // Always true - unified scale selection system
+    std::vector<uint8_t> customMaskGeneric; // Dynamic array: 0/1 flag per scale degree
+    int rootNote = 0;                        // Index: 0..(edo-1). For 12-EDO: 0=C, 1=C#, ..., 11=B
+    int scaleIndex = 0;                      // Index into scales table (ignored when useCustomScale=true)
+    // Previous values for latch-reset change detection (refreshQuantPlan)
+    int prevRootNote = -999;                 // Previous root note setting
+    int prevScaleIndex = -999;               // Previous scale selection index
+    int prevEdo = -999;                      // Previous EDO division count
+    int prevTetSteps = -999;                 // Previous TET step count
+    float prevTetPeriodOct = -999.f;         // Previous TET period size
+    int prevTuningMode = -999;               // Previous tuning system mode
+    bool prevUseCustomScale = false;         // Previous custom scale usage flag
+
+    // ═══════════════════════════════════════════════════════════════════════════
+    // PER-VOICE STATE (see hi::dsp::VoiceBank)
+    // ═══════════════════════════════════════════════════════════════════════════
+    VoiceBank voices;
+    bool prevPitchSafeGlide = false;         // Track pitch-safe glide mode changes for step recalc
+
+    hi::dsp::QuantPlan quantPlan;            // Quantizer tables built from the fields (no snapshot published)
+    const hi::dsp::QuantPlan* plan = &quantPlan; // Tables render() uses: quantPlan or the acquired snapshot's
+    hi::dsp::tuning::Exchange tuningX;      // UI → audio tuning snapshots (see publishTuning)
+    const hi::dsp::tuning::Snapshot* tuning = nullptr; // Audio thread: snapshot behind `plan`, if any
+    // Expander chaining (see hi::dsp::chain): per-voice steps a left PolyQuanta latched for this
+    // sample's input and the plan they index. Set by the host around render(); nullptr = unchained.
+    const int32_t* chainStep = nullptr;
+    const hi::dsp::QuantPlan* chainPlan = nullptr;
+    hi::dsp::polytrans::State polyTrans;    // Handles fade phases and channel count management
+    hi::dsp::ctlrate::Block ctl;            // Cached control values for the current block
+    hi::dsp::rng::Xoroshiro rng;            // Per-instance random source (strum Random order; host randomizer)
+    hi::dsp::diag::Counters diag;           // Hot-path counters (no-ops unless built with -DHI_DIAGNOSTICS)
+
+    // Idle-voice fast path (see hi::dsp::settle)
+    hi::dsp::settle::Sig settleSig;         // Module-wide config at the previous sample
+    uint32_t quantPlanGen = 0;              // Quantizer config generation (wakes settled voices)
+    void wakeAllVoices() { for (int c = 0; c < 16; ++c) voices.settled[c] = false; }
+    hi::dsp::settle::VoiceState captureVoice(int c) const {
+        hi::dsp::settle::VoiceState v;
+        v.lastOut = voices.lastOut[c]; v.slewOut = voices.slews.out[c]; v.rise = voices.slews.rise[c]; v.fall = voices.slews.fall[c];
+        v.prevYRel = voices.prevYRel[c]; v.stepNorm = voices.stepNorm[c]; v.lastFs = voices.lastFs[c];
+        v.latchedStep = voices.latchedStep[c]; v.lastDir = voices.lastDir[c]; v.stepSign = voices.stepSign[c];
+        v.latchedInit = voices.latchedInit[c];
+        return v;
+    }
+
+    // ═══════════════════════════════════════════════════════════════════════════
+    // SIGNAL CHAIN
+    // ═══════════════════════════════════════════════════════════════════════════
+    // Clear per-voice runtime state and pre-range transforms (Module::onReset); settings are kept.
+    void reset();
+    // Control-rate scheduling: when controlDue(), the host fills a ControlSnapshot and calls
+    // applyControls() (dual-bank resolution and param I/O stay host-side). advanceControl()
+    // then returns the ramp weight render() takes for this sample.
+    bool controlDue() const { return ctl.phase == 0; }
+    void applyControls(const ControlSnapshot& cs);
+    float advanceControl();
+    // Once-per-control-block quantizer setup: rebuild the shared QuantPlan only when tuning,
+    // root or mask contents differ from the cached tables, then run the latch-reset
+    // change detection that both quantizer branches previously repeated per channel.
+    // Once a snapshot has been published, the tables, root and tuning come from the newest
+    // one instead (the audio thread then never reads the UI-side tuning fields).
+    void refreshQuantPlan();
+    // UI thread: publish the tuning fields (mode, EDO/TET, period, root, scale, mask) as an
+    // immutable snapshot with prebuilt tables, unless they equal the latest snapshot.
+    // Returns true when a new snapshot was published.
+    bool publishTuning();
+    // Start of a sample: resolve the desired processing/output widths from the input
+    // connection and start (or, with no fade time, apply) a width transition.
+    // Returns the output channel count for this sample.
+    int updateWidth(bool inConn, int inCh);
+    // The two halves of updateWidth(): desired widths for an input (forced count, auto-detect,
+    // mono sum), and starting a transition towards them (no-op while one is running).
+    void desiredWidth(bool inConn, int inCh, int& procN, int& outN) const;
+    int beginWidth(int procN, int outN);
+    // One sample of the chain after control evaluation. in[]: input voltages for inCh
+    // channels (mono inputs feed every voice); ctlW: control-block ramp weight (see
+    // ctlrate::Block::at); dt: sample time. Writes the output voltages to out[] and
+    // returns how many were written (1 when summing to mono, else curProcN). The poly
+    // fade state machine runs at the end, so polyTrans.curOutN may change afterwards.
+    int render(const float* in, int inCh, bool inConn, float ctlW, float dt, float* out);
+    // Render `frames` samples in one call. The desired width is resolved once and cs is applied
+    // (quantizer plan, bound) once; later control-block boundaries only roll the ramp history,
+    // and a transition is started only while the width is stable. render() runs per frame. in/out are
+    // frame-major with kFrameStride floats per frame (Rack's Port::voltages layout); output
+    // lanes past the frame's width are zeroed. channels <= 0 means the input is unpatched.
+    // outCh, if given, receives each frame's output width (polyTrans.curOutN after render).
+    // Returns the output width after the last frame.
+    static constexpr int kFrameStride = 16;
+    int processBlock(const float* in, float* out, int frames, int channels, float dt,
+                     const ControlSnapshot& cs, int* outCh = nullptr);
+};
+}} // namespace hi::dsp
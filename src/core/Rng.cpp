@@ -0,0 +1,45 @@
+#include "Rng.hpp"
+/*
+ * Rng.cpp — xoroshiro128+ (Blackman/Vigna, a=24 b=16 c=37) over four lanes.
+ * The float conversion keeps the top 24 bits, which are the strongest bits of
+ * the '+' scrambler and exactly fill a float mantissa.
+ */
+namespace hi { namespace dsp { namespace rng {
+
+static inline uint64_t _splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void Xoroshiro::seed(uint64_t seed) {
+    uint64_t x = seed;
+    for (int i = 0; i < 4; ++i) { s0[i] = _splitmix64(x); s1[i] = _splitmix64(x); }
+    for (int i = 0; i < 4; ++i) if ((s0[i] | s1[i]) == 0) s1[i] = 1;   // Zero is a fixed point
+}
+
+void Xoroshiro::fillUniform(float* out, int n) {
+    for (int i = 0; i < n; i += 4) {
+        u64x4 r;
+        next4(r);
+        r >>= 40;
+        for (int k = 0; k < 4 && i + k < n; ++k) out[i + k] = (float)r[k] * (1.f / 16777216.f);
+    }
+}
+
+void Xoroshiro::fillSymmetric(float* out, int n, float width) {
+    fillUniform(out, n);
+    for (int i = 0; i < n; ++i) out[i] = (2.f * out[i] - 1.f) * width;
+}
+
+void Xoroshiro::getState(uint64_t out[kStateWords]) const {
+    for (int i = 0; i < 4; ++i) { out[i] = s0[i]; out[4 + i] = s1[i]; }
+}
+
+bool Xoroshiro::setState(const uint64_t in[kStateWords]) {
+    for (int i = 0; i < 4; ++i) if ((in[i] | in[4 + i]) == 0) return false;
+    for (int i = 0; i < 4; ++i) { s0[i] = in[i]; s1[i] = in[4 + i]; }
+    return true;
+}
+}}} // namespace hi::dsp::rng
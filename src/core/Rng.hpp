@@ -0,0 +1,43 @@
+#pragma once
+/*
+ * Rng.hpp — Per-instance, seedable random source for PolyQuanta (strum Random
+ * order, doRandomize()). Replaces rack::random's shared global generator so
+ * renders are reproducible from a saved state and instances firing on the
+ * same clock edge share nothing.
+ *
+ * Four interleaved xoroshiro128+ streams advance together in one u64x4
+ * register (GCC/Clang vector extensions, like Lanes.hpp), so batch fills of
+ * 16 values take four steps. Each lane is an independent stream seeded by
+ * splitmix64; the whole state is eight words and round-trips through JSON.
+ */
+#include <cstdint>
+
+namespace hi { namespace dsp { namespace rng {
+typedef uint64_t u64x4 __attribute__((vector_size(32)));
+
+static constexpr int kStateWords = 8;        // s0[4] then s1[4]
+
+struct Xoroshiro {
+    u64x4 s0, s1;
+    explicit Xoroshiro(uint64_t seed = 0x9E3779B97F4A7C15ull) { this->seed(seed); }
+    // Derive all four streams from one 64-bit seed (splitmix64; never all-zero).
+    void seed(uint64_t seed);
+    // One step of every lane; r receives the four raw outputs (by reference: passing a
+    // 32-byte vector by value would change ABI with and without AVX).
+    void next4(u64x4& r) {
+        const u64x4 a = s0, b = s1 ^ a;
+        r = a + s1;
+        s0 = ((a << 24) | (a >> 40)) ^ b ^ (b << 16);          // rotl(a, 24) ^ b ^ (b << 16)
+        s1 = (b << 37) | (b >> 27);                             // rotl(b, 37)
+    }
+    // n uniforms in [0, 1) (24-bit mantissa), four per step; a partial last step drops
+    // its unused lanes so the four streams stay in lockstep.
+    void fillUniform(float* out, int n);
+    // n values in [-width, +width).
+    void fillSymmetric(float* out, int n, float width);
+    float uniform() { float u; fillUniform(&u, 1); return u; }
+    // Raw state for persistence (s0[0..3], s1[0..3]); setState rejects an all-zero state.
+    void getState(uint64_t out[kStateWords]) const;
+    bool setState(const uint64_t in[kStateWords]);
+};
+}}} // namespace hi::dsp::rng
@@ -0,0 +1,151 @@
+#include "Scala.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+/*
+ * Scala.cpp — .scl/.kbm parsing and the reduction to a sorted per-period
+ * degree table. Follows the Scala file format description: '!' lines are
+ * comments, values end at the first whitespace, a pitch containing '.' is in
+ * cents and anything else is a ratio or an integer.
+ */
+namespace hi { namespace music { namespace scala {
+namespace {
+static constexpr double kC4Hz = 261.6255653005986;  // 0 V in Rack's 1 V/oct convention
+
+// Next non-comment line (trailing CR stripped); false at end of text.
+bool nextLine(std::istringstream& in, std::string& line) {
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty() && line[0] == '!') continue;
+        return true;
+    }
+    return false;
+}
+
+std::string firstToken(const std::string& line) {
+    std::istringstream ls(line);
+    std::string tok;
+    ls >> tok;
+    return tok;
+}
+
+bool parsePitch(const std::string& tok, double& cents) {
+    if (tok.empty()) return false;
+    char* end = nullptr;
+    if (tok.find('.') != std::string::npos) {
+        cents = std::strtod(tok.c_str(), &end);
+        return end && *end == '\0';
+    }
+    const long num = std::strtol(tok.c_str(), &end, 10);
+    long den = 1;
+    if (*end == '/') {
+        const char* d = end + 1;
+        den = std::strtol(d, &end, 10);
+        if (end == d) return false;
+    }
+    if (*end != '\0' || num <= 0 || den <= 0) return false;
+    cents = 1200.0 * std::log2((double)num / (double)den);
+    return true;
+}
+
+bool parseInt(const std::string& line, int& v) {
+    const std::string tok = firstToken(line);
+    char* end = nullptr;
+    const long x = std::strtol(tok.c_str(), &end, 10);
+    if (tok.empty() || *end != '\0') return false;
+    v = (int)x;
+    return true;
+}
+
+bool fail(std::string* err, const char* why) { if (err) *err = why; return false; }
+
+int floorDiv(int a, int b) { return (a >= 0) ? a / b : -((-a + b - 1) / b); }
+} // namespace
+
+bool parseScl(const std::string& text, Scale& out, std::string* err) {
+    std::istringstream in(text);
+    std::string line;
+    Scale s;
+    if (!nextLine(in, line)) return fail(err, "missing description line");
+    s.description = line;
+    int count = 0;
+    if (!nextLine(in, line) || !parseInt(line, count) || count < 0) return fail(err, "bad note count");
+    for (int i = 0; i < count; ++i) {
+        double c = 0.0;
+        if (!nextLine(in, line)) return fail(err, "fewer pitches than the note count");
+        if (!parsePitch(firstToken(line), c)) return fail(err, "unreadable pitch");
+        s.cents.push_back(c);
+    }
+    out = std::move(s);
+    return true;
+}
+
+bool parseKbm(const std::string& text, Keymap& out, std::string* err) {
+    std::istringstream in(text);
+    std::string line;
+    Keymap k;
+    int* ints[] = {&k.size, &k.first, &k.last, &k.middle, &k.refNote};
+    for (int* p : ints)
+        if (!nextLine(in, line) || !parseInt(line, *p)) return fail(err, "bad keymap header");
+    if (k.size < 0 || k.size > kMaxDegrees) return fail(err, "bad map size");
+    for (int key : {k.first, k.last, k.middle, k.refNote})
+        if (key < 0 || key > 127) return fail(err, "bad keymap header");   // MIDI key range
+    if (!nextLine(in, line)) return fail(err, "missing reference frequency");
+    k.refFreq = std::strtod(firstToken(line).c_str(), nullptr);
+    if (!(k.refFreq > 0.0)) return fail(err, "bad reference frequency");
+    if (!nextLine(in, line) || !parseInt(line, k.octaveDegree) || k.octaveDegree < 0 || k.octaveDegree > kMaxDegrees)
+        return fail(err, "bad octave degree");
+    for (int i = 0; i < k.size; ++i) {
+        int d = -1;
+        if (!nextLine(in, line)) break;                         // Missing trailing entries are unmapped
+        const std::string tok = firstToken(line);
+        if (tok != "x" && tok != "X" && (!parseInt(line, d) || d < 0 || d > kMaxDegrees))
+            return fail(err, "bad mapping entry");
+        k.map.push_back(d);
+    }
+    k.map.resize((size_t)k.size, -1);
+    out = std::move(k);
+    return true;
+}
+
+bool toTuning(const Scale& s, const Keymap* kbm, Tuning& out) {
+    if (s.cents.empty()) return false;
+    const double periodC = s.cents.back();
+    if (!(periodC > 0.0)) return false;
+    // Reduce into [0, period), sort, drop duplicates (degree 0 is the implied 1/1)
+    std::vector<double> deg{0.0};
+    for (size_t i = 0; i + 1 < s.cents.size(); ++i) {
+        const double r = s.cents[i] - periodC * std::floor(s.cents[i] / periodC);
+        if (r < periodC) deg.push_back(r);
+    }
+    std::sort(deg.begin(), deg.end());
+    deg.erase(std::unique(deg.begin(), deg.end(), [](double a, double b) { return b - a < 1e-6; }), deg.end());
+    const int N = (int)deg.size();
+    if (N > kMaxDegrees) return false;
+    // Keymap entries index the degrees as listed; a collapsed duplicate would shift them
+    if (kbm && N != (int)s.cents.size()) return false;
+
+    Tuning t;
+    t.period = (float)(periodC / 1200.0);
+    for (double c : deg) t.degrees.push_back((float)(c / 1200.0));
+    t.mapped.assign((size_t)N, 1);
+    // Pitch (octaves above degree 0) of any degree, periods included
+    auto pitchOf = [&](int d) { const int k = floorDiv(d, N); return k * periodC / 1200.0 + deg[(size_t)(d - k * N)] / 1200.0; };
+    if (kbm) {
+        const int M = kbm->size;
+        const int octDeg = (kbm->octaveDegree > 0) ? kbm->octaveDegree : N;
+        int refDeg = kbm->refNote - kbm->middle;                // Linear mapping
+        if (M > 0) {
+            const int off = kbm->refNote - kbm->middle, k = floorDiv(off, M);
+            const int slot = kbm->map[(size_t)(off - k * M)];
+            refDeg = (slot >= 0) ? k * octDeg + slot : off;      // Unmapped reference: fall back to linear
+            t.mapped.assign((size_t)N, 0);
+            for (int d : kbm->map) if (d >= 0) t.mapped[(size_t)(d - floorDiv(d, N) * N)] = 1;
+        }
+        t.tonic = (float)(std::log2(kbm->refFreq / kC4Hz) - pitchOf(refDeg));
+    }
+    out = std::move(t);
+    return true;
+}
+}}} // namespace hi::music::scala
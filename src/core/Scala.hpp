@@ -0,0 +1,52 @@
+#pragma once
+/*
+ * Scala.hpp — Scala scale (.scl) and keyboard mapping (.kbm) files for the
+ * arbitrary-tuning quantizer mode (tuningMode 2).
+ *
+ * A .scl lists the pitches above the implied 1/1 as cents ("701.955") or
+ * ratios ("3/2", "2"); the last pitch is the period. toTuning() reduces the
+ * degrees into one period, sorts them and yields the per-degree offsets that
+ * QuantPlan::build() turns into a warped step grid. An optional .kbm anchors
+ * degree 0 (its middle note, tuned so the reference note sounds at the
+ * reference frequency; 0 V = C4 = MIDI 60) and masks out degrees no key maps
+ * to. Without a .kbm degree 0 sits at 0 V and every degree is allowed.
+ *
+ * Rack-free: parsing works on file text, so tests and headless hosts use the
+ * same code as the module's file dialogs.
+ */
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hi { namespace music { namespace scala {
+static constexpr int kMaxDegrees = 128;     // Same ceiling as the MOS tables (hi::music::mos::memo::kMaxN)
+
+struct Scale {
+    std::string description;
+    std::vector<double> cents;              // Pitches after 1/1, file order; back() is the period
+};
+
+struct Keymap {
+    int size = 0;                           // Mapping pattern length (0 = linear: key offset = degree)
+    int first = 0, last = 127;              // Mapped MIDI key range
+    int middle = 60;                        // Key where degree 0 sits
+    int refNote = 69;                       // Key tuned to refFreq
+    double refFreq = 440.0;
+    int octaveDegree = 0;                   // Degree that spans one pattern (0 = the scale size)
+    std::vector<int> map;                   // Degree per pattern slot, -1 for "x" (unmapped)
+};
+
+// Parse file text. On failure returns false and, when err is set, a one-line reason.
+bool parseScl(const std::string& text, Scale& out, std::string* err = nullptr);
+bool parseKbm(const std::string& text, Keymap& out, std::string* err = nullptr);
+
+struct Tuning {
+    std::vector<float> degrees;             // N ascending offsets in octaves, degrees[0] == 0, all < period
+    float period = 1.f;                     // Octaves
+    float tonic = 0.f;                      // Volts of degree 0
+    std::vector<uint8_t> mapped;            // N flags: degree reachable from the keymap (all 1 without one)
+};
+// Derive the quantizer tuning; false when the scale is empty, has a non-positive period,
+// more than kMaxDegrees distinct degrees, or (with a keymap) degrees that reduce onto each other.
+bool toTuning(const Scale& s, const Keymap* kbm, Tuning& out);
+}}} // namespace hi::music::scala
@@ -1,54 +1,59 @@
 #include "ScaleDefs.hpp"
+#include <mutex>
 /*
  * ScaleDefs.cpp — Defines the immutable 12-EDO and 24-EDO preset scale tables.
  * Index within each array == stable scale ID used throughout code & JSON.
  * Bit 0 corresponds to the root (0 semitones / 0 quarter-tones). For 12-EDO
  * masks, bits 0..11 = semitone degrees. For 24-EDO, bits 0..23 = quarter-tones.
  * Existing comments from original locations are preserved.
+ *
+ * The tables below are constexpr sources only: at compile time they are packed
+ * into one uint64_t bit pool (kPool) with an offset/EDO per scale, so plugin
+ * load runs no constructors and allocates nothing. Scale objects (with their
+ * std::vector masks) are materialized per EDO on the first scalesEDO() call.
  */
 namespace hi { namespace music {
 
+// Compile-time source entry: one byte per degree; degrees past the table's EDO must stay 0.
+struct ScaleSrc {
+    const char* name;
+    uint8_t bits[MAX_SCALE_EDO];
+};
+
 // scales for EDOs 1-120 (WIP)
 
 // 1-EDO scales
-const int NUM_SCALES_1EDO = 1;
-static const Scale SCALES_1EDO[] = {
-    {"1-EDO Chromatic", 1}
+static constexpr ScaleSrc SCALES_1EDO[] = {
+    {"1-EDO Chromatic", {1}}
 };
 
 // 2-EDO scales
-const int NUM_SCALES_2EDO = 1;
-static const Scale SCALES_2EDO[] = {
+static constexpr ScaleSrc SCALES_2EDO[] = {
     {"2-EDO Chromatic", {1,1}}
 };
 
 // 3-EDO scales
-const int NUM_SCALES_3EDO = 1;
-static const Scale SCALES_3EDO[] = {
+static constexpr ScaleSrc SCALES_3EDO[] = {
     {"3-EDO Chromatic", {1,1,1}}
 };
 
 // 4-EDO scales
-const int NUM_SCALES_4EDO = 1;
-static const Scale SCALES_4EDO[] = {
+static constexpr ScaleSrc SCALES_4EDO[] = {
     {"4-EDO Chromatic", {1,1,1,1}}
 };
 
 // 5-EDO scales
-const int NUM_SCALES_5EDO = 1;
-static const Scale SCALES_5EDO[] = {
+static constexpr ScaleSrc SCALES_5EDO[] = {
     {"5-EDO Chromatic", {1,1,1,1,1}}
 };
 
 // 6-EDO scales
-const int NUM_SCALES_6EDO = 1;
-static const Scale SCALES_6EDO[] = {
+static constexpr ScaleSrc SCALES_6EDO[] = {
     {"6-EDO Chromatic", {1,1,1,1,1,1}}
 };
 
 // 7-EDO scales
-const int NUM_SCALES_7EDO = 16;
-static const Scale SCALES_7EDO[] = {
+static constexpr ScaleSrc SCALES_7EDO[] = {
     {"7-EDO Chromatic", {1,1,1,1,1,1,1}},
     {"Scale: 7-EDO Pentatonic (omit 2,3)", {1,0,0,1,1,1,1}},
     {"Scale: 7-EDO Pentatonic (omit 2,4)", {1,0,1,0,1,1,1}},
@@ -71,32 +76,27 @@ static const Scale SCALES_7EDO[] = {
 };
 
 // 8-EDO scales
-const int NUM_SCALES_8EDO = 1;
-static const Scale SCALES_8EDO[] = {
+static constexpr ScaleSrc SCALES_8EDO[] = {
     {"8-EDO Chromatic", {1,1,1,1,1,1,1,1}}
 };
 
 // 9-EDO scales
-const int NUM_SCALES_9EDO = 1;
-static const Scale SCALES_9EDO[] = {
+static constexpr ScaleSrc SCALES_9EDO[] = {
     {"9-EDO Chromatic", {1,1,1,1,1,1,1,1,1}}
 };
 
 // 10-EDO scales
-const int NUM_SCALES_10EDO = 1;
-static const Scale SCALES_10EDO[] = {
+static constexpr ScaleSrc SCALES_10EDO[] = {
     {"10-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 11-EDO scales
-const int NUM_SCALES_11EDO = 1;
-static const Scale SCALES_11EDO[] = {
+static constexpr ScaleSrc SCALES_11EDO[] = {
     {"11-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 12-EDO scales (bit 0 = root degree)
-const int NUM_SCALES_12EDO = 54;
-static const Scale SCALES_12EDO[] = {
+static constexpr ScaleSrc SCALES_12EDO[] = {
     // Chords
     {"Chord: 7sus4",                           {1,0,0,0,0,1,0,1,0,0,1,0}},
     {"Chord: Augmented Major 7",               {1,0,0,0,1,0,0,0,1,0,0,1}},
@@ -156,74 +156,62 @@ static const Scale SCALES_12EDO[] = {
 };
 
 // 13-EDO scales
-const int NUM_SCALES_13EDO = 1;
-static const Scale SCALES_13EDO[] = {
+static constexpr ScaleSrc SCALES_13EDO[] = {
     {"13-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 14-EDO scales
-const int NUM_SCALES_14EDO = 1;
-static const Scale SCALES_14EDO[] = {
+static constexpr ScaleSrc SCALES_14EDO[] = {
     {"14-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 15-EDO scales
-const int NUM_SCALES_15EDO = 1;
-static const Scale SCALES_15EDO[] = {
+static constexpr ScaleSrc SCALES_15EDO[] = {
     {"15-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 16-EDO scales
-const int NUM_SCALES_16EDO = 1;
-static const Scale SCALES_16EDO[] = {
+static constexpr ScaleSrc SCALES_16EDO[] = {
     {"16-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 17-EDO scales
-const int NUM_SCALES_17EDO = 6;
-static const Scale SCALES_17EDO[] = {
+static constexpr ScaleSrc SCALES_17EDO[] = {
     {"17-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 18-EDO scales
-const int NUM_SCALES_18EDO = 1;
-static const Scale SCALES_18EDO[] = {
+static constexpr ScaleSrc SCALES_18EDO[] = {
     {"18-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 19-EDO scales
-const int NUM_SCALES_19EDO = 1;
-static const Scale SCALES_19EDO[] = {
+static constexpr ScaleSrc SCALES_19EDO[] = {
     {"19-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 20-EDO scales
-const int NUM_SCALES_20EDO = 1;
-static const Scale SCALES_20EDO[] = {
+static constexpr ScaleSrc SCALES_20EDO[] = {
     {"20-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 21-EDO scales
-const int NUM_SCALES_21EDO = 1;
-static const Scale SCALES_21EDO[] = {
+static constexpr ScaleSrc SCALES_21EDO[] = {
     {"21-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 22-EDO scales
-const int NUM_SCALES_22EDO = 1;
-static const Scale SCALES_22EDO[] = {
+static constexpr ScaleSrc SCALES_22EDO[] = {
     {"22-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 23-EDO scales
-const int NUM_SCALES_23EDO = 1;
-static const Scale SCALES_23EDO[] = {
+static constexpr ScaleSrc SCALES_23EDO[] = {
     {"23-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 24-EDO preset scales (bit 0 = root; masks are musical approximations)
-const int NUM_SCALES_24EDO = 21;
-static const Scale SCALES_24EDO[] = {
+static constexpr ScaleSrc SCALES_24EDO[] = {
     {"24-EDO Chromatic",             {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}},
     {"Neutral 3rd Pentatonic (Maj)", {1,0,0,0,1,0,0,1,0,0,0,0,0,0,1,0,0,0,1,0,0,0,0,0}},
     {"Neutral 3rd Pentatonic (Min)", {1,0,0,0,0,0,0,1,0,0,1,0,0,0,1,0,0,0,0,0,1,0,0,0}},
@@ -240,178 +228,149 @@ static const Scale SCALES_24EDO[] = {
 };
 
 // 25-EDO scales
-const int NUM_SCALES_25EDO = 1;
-static const Scale SCALES_25EDO[] = {
+static constexpr ScaleSrc SCALES_25EDO[] = {
     {"25-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 26-EDO scales
-const int NUM_SCALES_26EDO = 1;
-static const Scale SCALES_26EDO[] = {
+static constexpr ScaleSrc SCALES_26EDO[] = {
     {"26-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 27-EDO scales
-const int NUM_SCALES_27EDO = 1;
-static const Scale SCALES_27EDO[] = {
+static constexpr ScaleSrc SCALES_27EDO[] = {
     {"27-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 28-EDO scales
-const int NUM_SCALES_28EDO = 1;
-static const Scale SCALES_28EDO[] = {
+static constexpr ScaleSrc SCALES_28EDO[] = {
     {"28-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 29-EDO scales
-const int NUM_SCALES_29EDO = 1;
-static const Scale SCALES_29EDO[] = {
+static constexpr ScaleSrc SCALES_29EDO[] = {
     {"29-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 30-EDO scales
-const int NUM_SCALES_30EDO = 1;
-static const Scale SCALES_30EDO[] = {
+static constexpr ScaleSrc SCALES_30EDO[] = {
     {"30-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 31-EDO scales
-const int NUM_SCALES_31EDO = 3;
-static const Scale SCALES_31EDO[] = {
+static constexpr ScaleSrc SCALES_31EDO[] = {
     {"31-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}},
     {"Raga Yaman",       {1,0,1,0,1,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0}},
     {"Raga Bhairav",     {1,0,1,1,0,1,0,1,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1}}
 };
 
 // 32-EDO scales
-const int NUM_SCALES_32EDO = 1;
-static const Scale SCALES_32EDO[] = {
+static constexpr ScaleSrc SCALES_32EDO[] = {
     {"32-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 33-EDO scales
-const int NUM_SCALES_33EDO = 1;
-static const Scale SCALES_33EDO[] = {
+static constexpr ScaleSrc SCALES_33EDO[] = {
     {"33-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 34-EDO scales
-const int NUM_SCALES_34EDO = 1;
-static const Scale SCALES_34EDO[] = {
+static constexpr ScaleSrc SCALES_34EDO[] = {
     {"34-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 35-EDO scales
-const int NUM_SCALES_35EDO = 1;
-static const Scale SCALES_35EDO[] = {
+static constexpr ScaleSrc SCALES_35EDO[] = {
     {"35-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 36-EDO scales
-const int NUM_SCALES_36EDO = 1;
-static const Scale SCALES_36EDO[] = {
+static constexpr ScaleSrc SCALES_36EDO[] = {
     {"36-EDO Chromatic",          {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 37-EDO scales
-const int NUM_SCALES_37EDO = 1;
-static const Scale SCALES_37EDO[] = {
+static constexpr ScaleSrc SCALES_37EDO[] = {
     {"37-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 38-EDO scales
-const int NUM_SCALES_38EDO = 1;
-static const Scale SCALES_38EDO[] = {
+static constexpr ScaleSrc SCALES_38EDO[] = {
     {"38-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 39-EDO scales
-const int NUM_SCALES_39EDO = 1;
-static const Scale SCALES_39EDO[] = {
+static constexpr ScaleSrc SCALES_39EDO[] = {
     {"39-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 40-EDO scales
-const int NUM_SCALES_40EDO = 1;
-static const Scale SCALES_40EDO[] = {
+static constexpr ScaleSrc SCALES_40EDO[] = {
     {"40-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 41-EDO scales
-const int NUM_SCALES_41EDO = 1;
-static const Scale SCALES_41EDO[] = {
+static constexpr ScaleSrc SCALES_41EDO[] = {
     {"41-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 42-EDO scales
-const int NUM_SCALES_42EDO = 1;
-static const Scale SCALES_42EDO[] = {
+static constexpr ScaleSrc SCALES_42EDO[] = {
     {"42-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 43-EDO scales
-const int NUM_SCALES_43EDO = 1;
-static const Scale SCALES_43EDO[] = {
+static constexpr ScaleSrc SCALES_43EDO[] = {
     {"43-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 44-EDO scales
-const int NUM_SCALES_44EDO = 1;
-static const Scale SCALES_44EDO[] = {
+static constexpr ScaleSrc SCALES_44EDO[] = {
     {"44-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 45-EDO scales
-const int NUM_SCALES_45EDO = 1;
-static const Scale SCALES_45EDO[] = {
+static constexpr ScaleSrc SCALES_45EDO[] = {
     {"45-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 46-EDO scales
-const int NUM_SCALES_46EDO = 1;
-static const Scale SCALES_46EDO[] = {
+static constexpr ScaleSrc SCALES_46EDO[] = {
     {"46-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 47-EDO scales
-const int NUM_SCALES_47EDO = 1;
-static const Scale SCALES_47EDO[] = {
+static constexpr ScaleSrc SCALES_47EDO[] = {
     {"47-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 48-EDO scales
-const int NUM_SCALES_48EDO = 1;
-static const Scale SCALES_48EDO[] = {
+static constexpr ScaleSrc SCALES_48EDO[] = {
     {"48-EDO Chromatic",          {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 49-EDO scales
-const int NUM_SCALES_49EDO = 1;
-static const Scale SCALES_49EDO[] = {
+static constexpr ScaleSrc SCALES_49EDO[] = {
     {"49-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 50-EDO scales
-const int NUM_SCALES_50EDO = 1;
-static const Scale SCALES_50EDO[] = {
+static constexpr ScaleSrc SCALES_50EDO[] = {
     {"50-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 51-EDO scales
-const int NUM_SCALES_51EDO = 1;
-static const Scale SCALES_51EDO[] = {
+static constexpr ScaleSrc SCALES_51EDO[] = {
     {"51-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 52-EDO scales
-const int NUM_SCALES_52EDO = 1;
-static const Scale SCALES_52EDO[] = {
+static constexpr ScaleSrc SCALES_52EDO[] = {
     {"52-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 53-EDO scales (Just Intonation approximation)
-const int NUM_SCALES_53EDO = 26;
-static const Scale SCALES_53EDO[] = {
+static constexpr ScaleSrc SCALES_53EDO[] = {
     {"53-EDO Chromatic",  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}},
     {"5-limit Major",     {1,0,1,0,1,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0}},
     {"5-limit Minor",     {1,0,1,1,0,1,0,1,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1}},
@@ -443,116 +402,97 @@ static const Scale SCALES_53EDO[] = {
 };
 
 // 54-EDO scales
-const int NUM_SCALES_54EDO = 1;
-static const Scale SCALES_54EDO[] = {
+static constexpr ScaleSrc SCALES_54EDO[] = {
     {"54-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 55-EDO scales
-const int NUM_SCALES_55EDO = 1;
-static const Scale SCALES_55EDO[] = {
+static constexpr ScaleSrc SCALES_55EDO[] = {
     {"55-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 56-EDO scales
-const int NUM_SCALES_56EDO = 1;
-static const Scale SCALES_56EDO[] = {
+static constexpr ScaleSrc SCALES_56EDO[] = {
     {"56-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 57-EDO scales
-const int NUM_SCALES_57EDO = 1;
-static const Scale SCALES_57EDO[] = {
+static constexpr ScaleSrc SCALES_57EDO[] = {
     {"57-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 58-EDO scales
-const int NUM_SCALES_58EDO = 1;
-static const Scale SCALES_58EDO[] = {
+static constexpr ScaleSrc SCALES_58EDO[] = {
     {"58-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 59-EDO scales
-const int NUM_SCALES_59EDO = 1;
-static const Scale SCALES_59EDO[] = {
+static constexpr ScaleSrc SCALES_59EDO[] = {
     {"59-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 60-EDO scales
-const int NUM_SCALES_60EDO = 1;
-static const Scale SCALES_60EDO[] = {
+static constexpr ScaleSrc SCALES_60EDO[] = {
     {"60-EDO Chromatic",          {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 61-EDO scales
-const int NUM_SCALES_61EDO = 1;
-static const Scale SCALES_61EDO[] = {
+static constexpr ScaleSrc SCALES_61EDO[] = {
     {"61-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 62-EDO scales
-const int NUM_SCALES_62EDO = 1;
-static const Scale SCALES_62EDO[] = {
+static constexpr ScaleSrc SCALES_62EDO[] = {
     {"62-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 63-EDO scales
-const int NUM_SCALES_63EDO = 1;
-static const Scale SCALES_63EDO[] = {
+static constexpr ScaleSrc SCALES_63EDO[] = {
     {"63-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 64-EDO scales
-const int NUM_SCALES_64EDO = 1;
-static const Scale SCALES_64EDO[] = {
+static constexpr ScaleSrc SCALES_64EDO[] = {
     {"64-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 65-EDO scales
-const int NUM_SCALES_65EDO = 1;
-static const Scale SCALES_65EDO[] = {
+static constexpr ScaleSrc SCALES_65EDO[] = {
     {"65-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 66-EDO scales
-const int NUM_SCALES_66EDO = 1;
-static const Scale SCALES_66EDO[] = {
+static constexpr ScaleSrc SCALES_66EDO[] = {
     {"66-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 67-EDO scales
-const int NUM_SCALES_67EDO = 1;
-static const Scale SCALES_67EDO[] = {
+static constexpr ScaleSrc SCALES_67EDO[] = {
     {"67-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 68-EDO scales
-const int NUM_SCALES_68EDO = 1;
-static const Scale SCALES_68EDO[] = {
+static constexpr ScaleSrc SCALES_68EDO[] = {
     {"68-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 69-EDO scales
-const int NUM_SCALES_69EDO = 1;
-static const Scale SCALES_69EDO[] = {
+static constexpr ScaleSrc SCALES_69EDO[] = {
     {"69-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 70-EDO scales
-const int NUM_SCALES_70EDO = 1;
-static const Scale SCALES_70EDO[] = {
+static constexpr ScaleSrc SCALES_70EDO[] = {
     {"70-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 71-EDO scales
-const int NUM_SCALES_71EDO = 1;
-static const Scale SCALES_71EDO[] = {
+static constexpr ScaleSrc SCALES_71EDO[] = {
     {"71-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 72-EDO scales
-const int NUM_SCALES_72EDO = 9;
-static const Scale SCALES_72EDO[] = {
+static constexpr ScaleSrc SCALES_72EDO[] = {
     {"72-EDO Chromatic",          {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}},
     // Arabic maqam system
     {"Maqām: Rast", {1,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0}},
@@ -566,502 +506,678 @@ static const Scale SCALES_72EDO[] = {
 };
 
 // 73-EDO scales
-const int NUM_SCALES_73EDO = 1;
-static const Scale SCALES_73EDO[] = {
+static constexpr ScaleSrc SCALES_73EDO[] = {
     {"73-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 74-EDO scales
-const int NUM_SCALES_74EDO = 1;
-static const Scale SCALES_74EDO[] = {
+static constexpr ScaleSrc SCALES_74EDO[] = {
     {"74-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 75-EDO scales
-const int NUM_SCALES_75EDO = 1;
-static const Scale SCALES_75EDO[] = {
+static constexpr ScaleSrc SCALES_75EDO[] = {
     {"75-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 76-EDO scales
-const int NUM_SCALES_76EDO = 1;
-static const Scale SCALES_76EDO[] = {
+static constexpr ScaleSrc SCALES_76EDO[] = {
     {"76-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 77-EDO scales
-const int NUM_SCALES_77EDO = 1;
-static const Scale SCALES_77EDO[] = {
+static constexpr ScaleSrc SCALES_77EDO[] = {
     {"77-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 78-EDO scales
-const int NUM_SCALES_78EDO = 1;
-static const Scale SCALES_78EDO[] = {
+static constexpr ScaleSrc SCALES_78EDO[] = {
     {"78-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 79-EDO scales
-const int NUM_SCALES_79EDO = 1;
-static const Scale SCALES_79EDO[] = {
+static constexpr ScaleSrc SCALES_79EDO[] = {
     {"79-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 80-EDO scales
-const int NUM_SCALES_80EDO = 1;
-static const Scale SCALES_80EDO[] = {
+static constexpr ScaleSrc SCALES_80EDO[] = {
     {"80-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 81-EDO scales
-const int NUM_SCALES_81EDO = 1;
-static const Scale SCALES_81EDO[] = {
+static constexpr ScaleSrc SCALES_81EDO[] = {
     {"81-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 82-EDO scales
-const int NUM_SCALES_82EDO = 1;
-static const Scale SCALES_82EDO[] = {
+static constexpr ScaleSrc SCALES_82EDO[] = {
     {"82-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 83-EDO scales
-const int NUM_SCALES_83EDO = 1;
-static const Scale SCALES_83EDO[] = {
+static constexpr ScaleSrc SCALES_83EDO[] = {
     {"83-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 84-EDO scales
-const int NUM_SCALES_84EDO = 1;
-static const Scale SCALES_84EDO[] = {
+static constexpr ScaleSrc SCALES_84EDO[] = {
     {"84-EDO Chromatic",          {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 85-EDO scales
-const int NUM_SCALES_85EDO = 1;
-static const Scale SCALES_85EDO[] = {
+static constexpr ScaleSrc SCALES_85EDO[] = {
     {"85-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 86-EDO scales
-const int NUM_SCALES_86EDO = 1;
-static const Scale SCALES_86EDO[] = {
+static constexpr ScaleSrc SCALES_86EDO[] = {
     {"86-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 87-EDO scales
-const int NUM_SCALES_87EDO = 1;
-static const Scale SCALES_87EDO[] = {
+static constexpr ScaleSrc SCALES_87EDO[] = {
     {"87-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 88-EDO scales
-const int NUM_SCALES_88EDO = 1;
-static const Scale SCALES_88EDO[] = {
+static constexpr ScaleSrc SCALES_88EDO[] = {
     {"88-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 89-EDO scales
-const int NUM_SCALES_89EDO = 1;
-static const Scale SCALES_89EDO[] = {
+static constexpr ScaleSrc SCALES_89EDO[] = {
     {"89-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 90-EDO scales
-const int NUM_SCALES_90EDO = 1;
-static const Scale SCALES_90EDO[] = {
+static constexpr ScaleSrc SCALES_90EDO[] = {
     {"90-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 91-EDO scales
-const int NUM_SCALES_91EDO = 1;
-static const Scale SCALES_91EDO[] = {
+static constexpr ScaleSrc SCALES_91EDO[] = {
     {"91-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 92-EDO scales
-const int NUM_SCALES_92EDO = 1;
-static const Scale SCALES_92EDO[] = {
+static constexpr ScaleSrc SCALES_92EDO[] = {
     {"92-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 93-EDO scales
-const int NUM_SCALES_93EDO = 1;
-static const Scale SCALES_93EDO[] = {
+static constexpr ScaleSrc SCALES_93EDO[] = {
     {"93-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 94-EDO scales
-const int NUM_SCALES_94EDO = 1;
-static const Scale SCALES_94EDO[] = {
+static constexpr ScaleSrc SCALES_94EDO[] = {
     {"94-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 95-EDO scales
-const int NUM_SCALES_95EDO = 1;
-static const Scale SCALES_95EDO[] = {
+static constexpr ScaleSrc SCALES_95EDO[] = {
     {"95-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 96-EDO scales
-const int NUM_SCALES_96EDO = 1;
-static const Scale SCALES_96EDO[] = {
+static constexpr ScaleSrc SCALES_96EDO[] = {
     {"96-EDO Chromatic",          {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 97-EDO scales
-const int NUM_SCALES_97EDO = 1;
-static const Scale SCALES_97EDO[] = {
+static constexpr ScaleSrc SCALES_97EDO[] = {
     {"97-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 98-EDO scales
-const int NUM_SCALES_98EDO = 1;
-static const Scale SCALES_98EDO[] = {
+static constexpr ScaleSrc SCALES_98EDO[] = {
     {"98-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 99-EDO scales
-const int NUM_SCALES_99EDO = 1;
-static const Scale SCALES_99EDO[] = {
+static constexpr ScaleSrc SCALES_99EDO[] = {
     {"99-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 100-EDO scales
-const int NUM_SCALES_100EDO = 1;
-static const Scale SCALES_100EDO[] = {
+static constexpr ScaleSrc SCALES_100EDO[] = {
     {"100-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 101-EDO scales
-const int NUM_SCALES_101EDO = 1;
-static const Scale SCALES_101EDO[] = {
+static constexpr ScaleSrc SCALES_101EDO[] = {
     {"101-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 102-EDO scales
-const int NUM_SCALES_102EDO = 1;
-static const Scale SCALES_102EDO[] = {
+static constexpr ScaleSrc SCALES_102EDO[] = {
     {"102-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 103-EDO scales
-const int NUM_SCALES_103EDO = 1;
-static const Scale SCALES_103EDO[] = {
+static constexpr ScaleSrc SCALES_103EDO[] = {
     {"103-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 104-EDO scales
-const int NUM_SCALES_104EDO = 1;
-static const Scale SCALES_104EDO[] = {
+static constexpr ScaleSrc SCALES_104EDO[] = {
     {"104-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 105-EDO scales
-const int NUM_SCALES_105EDO = 1;
-static const Scale SCALES_105EDO[] = {
+static constexpr ScaleSrc SCALES_105EDO[] = {
     {"105-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 106-EDO scales
-const int NUM_SCALES_106EDO = 1;
-static const Scale SCALES_106EDO[] = {
+static constexpr ScaleSrc SCALES_106EDO[] = {
     {"106-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 107-EDO scales
-const int NUM_SCALES_107EDO = 1;
-static const Scale SCALES_107EDO[] = {
+static constexpr ScaleSrc SCALES_107EDO[] = {
     {"107-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 108-EDO scales
-const int NUM_SCALES_108EDO = 1;
-static const Scale SCALES_108EDO[] = {
+static constexpr ScaleSrc SCALES_108EDO[] = {
     {"108-EDO Chromatic",         {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 109-EDO scales
-const int NUM_SCALES_109EDO = 1;
-static const Scale SCALES_109EDO[] = {
+static constexpr ScaleSrc SCALES_109EDO[] = {
     {"109-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 110-EDO scales
-const int NUM_SCALES_110EDO = 1;
-static const Scale SCALES_110EDO[] = {
+static constexpr ScaleSrc SCALES_110EDO[] = {
     {"110-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 111-EDO scales
-const int NUM_SCALES_111EDO = 1;
-static const Scale SCALES_111EDO[] = {
+static constexpr ScaleSrc SCALES_111EDO[] = {
     {"111-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 112-EDO scales
-const int NUM_SCALES_112EDO = 1;
-static const Scale SCALES_112EDO[] = {
+static constexpr ScaleSrc SCALES_112EDO[] = {
     {"112-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 113-EDO scales
-const int NUM_SCALES_113EDO = 1;
-static const Scale SCALES_113EDO[] = {
+static constexpr ScaleSrc SCALES_113EDO[] = {
     {"113-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 114-EDO scales
-const int NUM_SCALES_114EDO = 1;
-static const Scale SCALES_114EDO[] = {
+static constexpr ScaleSrc SCALES_114EDO[] = {
     {"114-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 115-EDO scales
-const int NUM_SCALES_115EDO = 1;
-static const Scale SCALES_115EDO[] = {
+static constexpr ScaleSrc SCALES_115EDO[] = {
     {"115-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 116-EDO scales
-const int NUM_SCALES_116EDO = 1;
-static const Scale SCALES_116EDO[] = {
+static constexpr ScaleSrc SCALES_116EDO[] = {
     {"116-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 117-EDO scales
-const int NUM_SCALES_117EDO = 1;
-static const Scale SCALES_117EDO[] = {
+static constexpr ScaleSrc SCALES_117EDO[] = {
     {"117-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 118-EDO scales
-const int NUM_SCALES_118EDO = 1;
-static const Scale SCALES_118EDO[] = {
+static constexpr ScaleSrc SCALES_118EDO[] = {
     {"118-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 119-EDO scales
-const int NUM_SCALES_119EDO = 1;
-static const Scale SCALES_119EDO[] = {
+static constexpr ScaleSrc SCALES_119EDO[] = {
     {"119-EDO Chromatic", {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
 // 120-EDO scales
-const int NUM_SCALES_120EDO = 1;
-static const Scale SCALES_120EDO[] = {
+static constexpr ScaleSrc SCALES_120EDO[] = {
     {"120-EDO Chromatic",         {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}}
 };
 
-// Array of function pointers to get scale counts for each EDO (index 0 = 1-EDO, index 119 = 120-EDO)
-static int (*const EDO_SCALE_COUNT_FUNCS[120])() = {
-    []() { return NUM_SCALES_1EDO; },   []() { return NUM_SCALES_2EDO; },   []() { return NUM_SCALES_3EDO; },   []() { return NUM_SCALES_4EDO; },
-    []() { return NUM_SCALES_5EDO; },   []() { return NUM_SCALES_6EDO; },   []() { return NUM_SCALES_7EDO; },   []() { return NUM_SCALES_8EDO; },
-    []() { return NUM_SCALES_9EDO; },   []() { return NUM_SCALES_10EDO; },  []() { return NUM_SCALES_11EDO; },  []() { return NUM_SCALES_12EDO; },
-    []() { return NUM_SCALES_13EDO; },  []() { return NUM_SCALES_14EDO; },  []() { return NUM_SCALES_15EDO; },  []() { return NUM_SCALES_16EDO; },
-    []() { return NUM_SCALES_17EDO; },  []() { return NUM_SCALES_18EDO; },  []() { return NUM_SCALES_19EDO; },  []() { return NUM_SCALES_20EDO; },
-    []() { return NUM_SCALES_21EDO; },  []() { return NUM_SCALES_22EDO; },  []() { return NUM_SCALES_23EDO; },  []() { return NUM_SCALES_24EDO; },
-    []() { return NUM_SCALES_25EDO; },  []() { return NUM_SCALES_26EDO; },  []() { return NUM_SCALES_27EDO; },  []() { return NUM_SCALES_28EDO; },
-    []() { return NUM_SCALES_29EDO; },  []() { return NUM_SCALES_30EDO; },  []() { return NUM_SCALES_31EDO; },  []() { return NUM_SCALES_32EDO; },
-    []() { return NUM_SCALES_33EDO; },  []() { return NUM_SCALES_34EDO; },  []() { return NUM_SCALES_35EDO; },  []() { return NUM_SCALES_36EDO; },
-    []() { return NUM_SCALES_37EDO; },  []() { return NUM_SCALES_38EDO; },  []() { return NUM_SCALES_39EDO; },  []() { return NUM_SCALES_40EDO; },
-    []() { return NUM_SCALES_41EDO; },  []() { return NUM_SCALES_42EDO; },  []() { return NUM_SCALES_43EDO; },  []() { return NUM_SCALES_44EDO; },
-    []() { return NUM_SCALES_45EDO; },  []() { return NUM_SCALES_46EDO; },  []() { return NUM_SCALES_47EDO; },  []() { return NUM_SCALES_48EDO; },
-    []() { return NUM_SCALES_49EDO; },  []() { return NUM_SCALES_50EDO; },  []() { return NUM_SCALES_51EDO; },  []() { return NUM_SCALES_52EDO; },
-    []() { return NUM_SCALES_53EDO; },  []() { return NUM_SCALES_54EDO; },  []() { return NUM_SCALES_55EDO; },  []() { return NUM_SCALES_56EDO; },
-    []() { return NUM_SCALES_57EDO; },  []() { return NUM_SCALES_58EDO; },  []() { return NUM_SCALES_59EDO; },  []() { return NUM_SCALES_60EDO; },
-    []() { return NUM_SCALES_61EDO; },  []() { return NUM_SCALES_62EDO; },  []() { return NUM_SCALES_63EDO; },  []() { return NUM_SCALES_64EDO; },
-    []() { return NUM_SCALES_65EDO; },  []() { return NUM_SCALES_66EDO; },  []() { return NUM_SCALES_67EDO; },  []() { return NUM_SCALES_68EDO; },
-    []() { return NUM_SCALES_69EDO; },  []() { return NUM_SCALES_70EDO; },  []() { return NUM_SCALES_71EDO; },  []() { return NUM_SCALES_72EDO; },
-    []() { return NUM_SCALES_73EDO; },  []() { return NUM_SCALES_74EDO; },  []() { return NUM_SCALES_75EDO; },  []() { return NUM_SCALES_76EDO; },
-    []() { return NUM_SCALES_77EDO; },  []() { return NUM_SCALES_78EDO; },  []() { return NUM_SCALES_79EDO; },  []() { return NUM_SCALES_80EDO; },
-    []() { return NUM_SCALES_81EDO; },  []() { return NUM_SCALES_82EDO; },  []() { return NUM_SCALES_83EDO; },  []() { return NUM_SCALES_84EDO; },
-    []() { return NUM_SCALES_85EDO; },  []() { return NUM_SCALES_86EDO; },  []() { return NUM_SCALES_87EDO; },  []() { return NUM_SCALES_88EDO; },
-    []() { return NUM_SCALES_89EDO; },  []() { return NUM_SCALES_90EDO; },  []() { return NUM_SCALES_91EDO; },  []() { return NUM_SCALES_92EDO; },
-    []() { return NUM_SCALES_93EDO; },  []() { return NUM_SCALES_94EDO; },  []() { return NUM_SCALES_95EDO; },  []() { return NUM_SCALES_96EDO; },
-    []() { return NUM_SCALES_97EDO; },  []() { return NUM_SCALES_98EDO; },  []() { return NUM_SCALES_99EDO; },  []() { return NUM_SCALES_100EDO; },
-    []() { return NUM_SCALES_101EDO; }, []() { return NUM_SCALES_102EDO; }, []() { return NUM_SCALES_103EDO; }, []() { return NUM_SCALES_104EDO; },
-    []() { return NUM_SCALES_105EDO; }, []() { return NUM_SCALES_106EDO; }, []() { return NUM_SCALES_107EDO; }, []() { return NUM_SCALES_108EDO; },
-    []() { return NUM_SCALES_109EDO; }, []() { return NUM_SCALES_110EDO; }, []() { return NUM_SCALES_111EDO; }, []() { return NUM_SCALES_112EDO; },
-    []() { return NUM_SCALES_113EDO; }, []() { return NUM_SCALES_114EDO; }, []() { return NUM_SCALES_115EDO; }, []() { return NUM_SCALES_116EDO; },
-    []() { return NUM_SCALES_117EDO; }, []() { return NUM_SCALES_118EDO; }, []() { return NUM_SCALES_119EDO; }, []() { return NUM_SCALES_120EDO; }
-};
+// ─── Packed pool ─────────────────────────────────────────────────────────────
+
+template <class T, int N> static constexpr int countOf(const T (&)[N]) { return N; }
+
+struct SrcTable { const ScaleSrc* scales; int count; };
+// Index 0 = 1-EDO ... index 119 = 120-EDO
+static constexpr SrcTable SOURCES[MAX_SCALE_EDO] = {
+    {SCALES_1EDO, countOf(SCALES_1EDO)}, {SCALES_2EDO, countOf(SCALES_2EDO)}, {SCALES_3EDO, countOf(SCALES_3EDO)}, {SCALES_4EDO, countOf(SCALES_4EDO)},
+    {SCALES_5EDO, countOf(SCALES_5EDO)}, {SCALES_6EDO, countOf(SCALES_6EDO)}, {SCALES_7EDO, countOf(SCALES_7EDO)}, {SCALES_8EDO, countOf(SCALES_8EDO)},
+    {SCALES_9EDO, countOf(SCALES_9EDO)}, {SCALES_10EDO, countOf(SCALES_10EDO)}, {SCALES_11EDO, countOf(SCALES_11EDO)}, {SCALES_12EDO, countOf(SCALES_12EDO)},
+    {SCALES_13EDO, countOf(SCALES_13EDO)}, {SCALES_14EDO, countOf(SCALES_14EDO)}, {SCALES_15EDO, countOf(SCALES_15EDO)}, {SCALES_16EDO, countOf(SCALES_16EDO)},
+    {SCALES_17EDO, countOf(SCALES_17EDO)}, {SCALES_18EDO, countOf(SCALES_18EDO)}, {SCALES_19EDO, countOf(SCALES_19EDO)}, {SCALES_20EDO, countOf(SCALES_20EDO)},
+    {SCALES_21EDO, countOf(SCALES_21EDO)}, {SCALES_22EDO, countOf(SCALES_22EDO)}, {SCALES_23EDO, countOf(SCALES_23EDO)}, {SCALES_24EDO, countOf(SCALES_24EDO)},
+    {SCALES_25EDO, countOf(SCALES_25EDO)}, {SCALES_26EDO, countOf(SCALES_26EDO)}, {SCALES_27EDO, countOf(SCALES_27EDO)}, {SCALES_28EDO, countOf(SCALES_28EDO)},
+    {SCALES_29EDO, countOf(SCALES_29EDO)}, {SCALES_30EDO, countOf(SCALES_30EDO)}, {SCALES_31EDO, countOf(SCALES_31EDO)}, {SCALES_32EDO, countOf(SCALES_32EDO)},
+    {SCALES_33EDO, countOf(SCALES_33EDO)}, {SCALES_34EDO, countOf(SCALES_34EDO)}, {SCALES_35EDO, countOf(SCALES_35EDO)}, {SCALES_36EDO, countOf(SCALES_36EDO)},
+    {SCALES_37EDO, countOf(SCALES_37EDO)}, {SCALES_38EDO, countOf(SCALES_38EDO)}, {SCALES_39EDO, countOf(SCALES_39EDO)}, {SCALES_40EDO, countOf(SCALES_40EDO)},
+    {SCALES_41EDO, countOf(SCALES_41EDO)}, {SCALES_42EDO, countOf(SCALES_42EDO)}, {SCALES_43EDO, countOf(SCALES_43EDO)}, {SCALES_44EDO, countOf(SCALES_44EDO)},
+    {SCALES_45EDO, countOf(SCALES_45EDO)}, {SCALES_46EDO, countOf(SCALES_46EDO)}, {SCALES_47EDO, countOf(SCALES_47EDO)}, {SCALES_48EDO, countOf(SCALES_48EDO)},
+    {SCALES_49EDO, countOf(SCALES_49EDO)}, {SCALES_50EDO, countOf(SCALES_50EDO)}, {SCALES_51EDO, countOf(SCALES_51EDO)}, {SCALES_52EDO, countOf(SCALES_52EDO)},
+    {SCALES_53EDO, countOf(SCALES_53EDO)}, {SCALES_54EDO, countOf(SCALES_54EDO)}, {SCALES_55EDO, countOf(SCALES_55EDO)}, {SCALES_56EDO, countOf(SCALES_56EDO)},
+    {SCALES_57EDO, countOf(SCALES_57EDO)}, {SCALES_58EDO, countOf(SCALES_58EDO)}, {SCALES_59EDO, countOf(SCALES_59EDO)}, {SCALES_60EDO, countOf(SCALES_60EDO)},
+    {SCALES_61EDO, countOf(SCALES_61EDO)}, {SCALES_62EDO, countOf(SCALES_62EDO)}, {SCALES_63EDO, countOf(SCALES_63EDO)}, {SCALES_64EDO, countOf(SCALES_64EDO)},
+    {SCALES_65EDO, countOf(SCALES_65EDO)}, {SCALES_66EDO, countOf(SCALES_66EDO)}, {SCALES_67EDO, countOf(SCALES_67EDO)}, {SCALES_68EDO, countOf(SCALES_68EDO)},
+    {SCALES_69EDO, countOf(SCALES_69EDO)}, {SCALES_70EDO, countOf(SCALES_70EDO)}, {SCALES_71EDO, countOf(SCALES_71EDO)}, {SCALES_72EDO, countOf(SCALES_72EDO)},
+    {SCALES_73EDO, countOf(SCALES_73EDO)}, {SCALES_74EDO, countOf(SCALES_74EDO)}, {SCALES_75EDO, countOf(SCALES_75EDO)}, {SCALES_76EDO, countOf(SCALES_76EDO)},
+    {SCALES_77EDO, countOf(SCALES_77EDO)}, {SCALES_78EDO, countOf(SCALES_78EDO)}, {SCALES_79EDO, countOf(SCALES_79EDO)}, {SCALES_80EDO, countOf(SCALES_80EDO)},
+    {SCALES_81EDO, countOf(SCALES_81EDO)}, {SCALES_82EDO, countOf(SCALES_82EDO)}, {SCALES_83EDO, countOf(SCALES_83EDO)}, {SCALES_84EDO, countOf(SCALES_84EDO)},
+    {SCALES_85EDO, countOf(SCALES_85EDO)}, {SCALES_86EDO, countOf(SCALES_86EDO)}, {SCALES_87EDO, countOf(SCALES_87EDO)}, {SCALES_88EDO, countOf(SCALES_88EDO)},
+    {SCALES_89EDO, countOf(SCALES_89EDO)}, {SCALES_90EDO, countOf(SCALES_90EDO)}, {SCALES_91EDO, countOf(SCALES_91EDO)}, {SCALES_92EDO, countOf(SCALES_92EDO)},
+    {SCALES_93EDO, countOf(SCALES_93EDO)}, {SCALES_94EDO, countOf(SCALES_94EDO)}, {SCALES_95EDO, countOf(SCALES_95EDO)}, {SCALES_96EDO, countOf(SCALES_96EDO)},
+    {SCALES_97EDO, countOf(SCALES_97EDO)}, {SCALES_98EDO, countOf(SCALES_98EDO)}, {SCALES_99EDO, countOf(SCALES_99EDO)}, {SCALES_100EDO, countOf(SCALES_100EDO)},
+    {SCALES_101EDO, countOf(SCALES_101EDO)}, {SCALES_102EDO, countOf(SCALES_102EDO)}, {SCALES_103EDO, countOf(SCALES_103EDO)}, {SCALES_104EDO, countOf(SCALES_104EDO)},
+    {SCALES_105EDO, countOf(SCALES_105EDO)}, {SCALES_106EDO, countOf(SCALES_106EDO)}, {SCALES_107EDO, countOf(SCALES_107EDO)}, {SCALES_108EDO, countOf(SCALES_108EDO)},
+    {SCALES_109EDO, countOf(SCALES_109EDO)}, {SCALES_110EDO, countOf(SCALES_110EDO)}, {SCALES_111EDO, countOf(SCALES_111EDO)}, {SCALES_112EDO, countOf(SCALES_112EDO)},
+    {SCALES_113EDO, countOf(SCALES_113EDO)}, {SCALES_114EDO, countOf(SCALES_114EDO)}, {SCALES_115EDO, countOf(SCALES_115EDO)}, {SCALES_116EDO, countOf(SCALES_116EDO)},
+    {SCALES_117EDO, countOf(SCALES_117EDO)}, {SCALES_118EDO, countOf(SCALES_118EDO)}, {SCALES_119EDO, countOf(SCALES_119EDO)}, {SCALES_120EDO, countOf(SCALES_120EDO)}
+};
+
+static constexpr int wordsFor(int edo) { return (edo + 63) / 64; }
+
+static constexpr int totalScales() {
+    int n = 0;
+    for (const SrcTable& t : SOURCES) n += t.count;
+    return n;
+}
 
-int numScalesEDO(int edo) {
-    // Bounds check: EDO must be between 1 and 120
-    if (edo < 1 || edo > 120) {
-        return 1; // fallback to chromatic
+static constexpr int totalWords() {
+    int n = 0;
+    for (int e = 1; e <= MAX_SCALE_EDO; ++e) n += SOURCES[e - 1].count * wordsFor(e);
+    return n;
+}
+
+// Every source entry fits its EDO (no degree set past the octave).
+static constexpr bool sourcesFit() {
+    for (int e = 1; e <= MAX_SCALE_EDO; ++e)
+        for (int i = 0; i < SOURCES[e - 1].count; ++i)
+            for (int d = e; d < MAX_SCALE_EDO; ++d)
+                if (SOURCES[e - 1].scales[i].bits[d]) return false;
+    return true;
+}
+static_assert(sourcesFit(), "ScaleDefs: a mask has more degrees than its EDO");
+
+struct PoolEntry { const char* name; uint32_t offset; };   // offset in words into Pool::words
+
+struct Pool {
+    int first[MAX_SCALE_EDO + 1] = {};    // first[edo]: index of the EDO's scale 0 in entries
+    int count[MAX_SCALE_EDO + 1] = {};    // count[edo]: preset count (index 0 unused)
+    PoolEntry entries[totalScales()] = {};
+    uint64_t words[totalWords()] = {};
+};
+
+static constexpr Pool buildPool() {
+    Pool p{};
+    int idx = 0, off = 0;
+    for (int e = 1; e <= MAX_SCALE_EDO; ++e) {
+        const SrcTable& t = SOURCES[e - 1];
+        p.first[e] = idx;
+        p.count[e] = t.count;
+        for (int i = 0; i < t.count; ++i, ++idx) {
+            p.entries[idx].name = t.scales[i].name;
+            p.entries[idx].offset = (uint32_t)off;
+            for (int d = 0; d < e; ++d)
+                if (t.scales[i].bits[d]) p.words[off + (d >> 6)] |= uint64_t(1) << (d & 63);
+            off += wordsFor(e);
+        }
     }
-    
-    // Call the appropriate function (convert 1-based EDO to 0-based index)
-    return EDO_SCALE_COUNT_FUNCS[edo - 1]();
+    return p;
 }
 
-// Accessor functions EDO scales 1-120
-const Scale* scales1EDO() { return SCALES_1EDO; }
-const Scale* scales2EDO() { return SCALES_2EDO; }
-const Scale* scales3EDO() { return SCALES_3EDO; }
-const Scale* scales4EDO() { return SCALES_4EDO; }
-const Scale* scales5EDO() { return SCALES_5EDO; }
-const Scale* scales6EDO() { return SCALES_6EDO; }
-const Scale* scales7EDO() { return SCALES_7EDO; }
-const Scale* scales8EDO() { return SCALES_8EDO; }
-const Scale* scales9EDO() { return SCALES_9EDO; }
-const Scale* scales10EDO() { return SCALES_10EDO; }
-const Scale* scales11EDO() { return SCALES_11EDO; }
-const Scale* scales12EDO() { return SCALES_12EDO; }
-const Scale* scales13EDO() { return SCALES_13EDO; }
-const Scale* scales14EDO() { return SCALES_14EDO; }
-const Scale* scales15EDO() { return SCALES_15EDO; }
-const Scale* scales16EDO() { return SCALES_16EDO; }
-const Scale* scales17EDO() { return SCALES_17EDO; }
-const Scale* scales18EDO() { return SCALES_18EDO; }
-const Scale* scales19EDO() { return SCALES_19EDO; }
-const Scale* scales20EDO() { return SCALES_20EDO; }
-const Scale* scales21EDO() { return SCALES_21EDO; }
-const Scale* scales22EDO() { return SCALES_22EDO; }
-const Scale* scales23EDO() { return SCALES_23EDO; }
-const Scale* scales24EDO() { return SCALES_24EDO; }
-const Scale* scales25EDO() { return SCALES_25EDO; }
-const Scale* scales26EDO() { return SCALES_26EDO; }
-const Scale* scales27EDO() { return SCALES_27EDO; }
-const Scale* scales28EDO() { return SCALES_28EDO; }
-const Scale* scales29EDO() { return SCALES_29EDO; }
-const Scale* scales30EDO() { return SCALES_30EDO; }
-const Scale* scales31EDO() { return SCALES_31EDO; }
-const Scale* scales32EDO() { return SCALES_32EDO; }
-const Scale* scales33EDO() { return SCALES_33EDO; }
-const Scale* scales34EDO() { return SCALES_34EDO; }
-const Scale* scales35EDO() { return SCALES_35EDO; }
-const Scale* scales36EDO() { return SCALES_36EDO; }
-const Scale* scales37EDO() { return SCALES_37EDO; }
-const Scale* scales38EDO() { return SCALES_38EDO; }
-const Scale* scales39EDO() { return SCALES_39EDO; }
-const Scale* scales40EDO() { return SCALES_40EDO; }
-const Scale* scales41EDO() { return SCALES_41EDO; }
-const Scale* scales42EDO() { return SCALES_42EDO; }
-const Scale* scales43EDO() { return SCALES_43EDO; }
-const Scale* scales44EDO() { return SCALES_44EDO; }
-const Scale* scales45EDO() { return SCALES_45EDO; }
-const Scale* scales46EDO() { return SCALES_46EDO; }
-const Scale* scales47EDO() { return SCALES_47EDO; }
-const Scale* scales48EDO() { return SCALES_48EDO; }
-const Scale* scales49EDO() { return SCALES_49EDO; }
-const Scale* scales50EDO() { return SCALES_50EDO; }
-const Scale* scales51EDO() { return SCALES_51EDO; }
-const Scale* scales52EDO() { return SCALES_52EDO; }
-const Scale* scales53EDO() { return SCALES_53EDO; }
-const Scale* scales54EDO() { return SCALES_54EDO; }
-const Scale* scales55EDO() { return SCALES_55EDO; }
-const Scale* scales56EDO() { return SCALES_56EDO; }
-const Scale* scales57EDO() { return SCALES_57EDO; }
-const Scale* scales58EDO() { return SCALES_58EDO; }
-const Scale* scales59EDO() { return SCALES_59EDO; }
-const Scale* scales60EDO() { return SCALES_60EDO; }
-const Scale* scales61EDO() { return SCALES_61EDO; }
-const Scale* scales62EDO() { return SCALES_62EDO; }
-const Scale* scales63EDO() { return SCALES_63EDO; }
-const Scale* scales64EDO() { return SCALES_64EDO; }
-const Scale* scales65EDO() { return SCALES_65EDO; }
-const Scale* scales66EDO() { return SCALES_66EDO; }
-const Scale* scales67EDO() { return SCALES_67EDO; }
-const Scale* scales68EDO() { return SCALES_68EDO; }
-const Scale* scales69EDO() { return SCALES_69EDO; }
-const Scale* scales70EDO() { return SCALES_70EDO; }
-const Scale* scales71EDO() { return SCALES_71EDO; }
-const Scale* scales72EDO() { return SCALES_72EDO; }
-const Scale* scales73EDO() { return SCALES_73EDO; }
-const Scale* scales74EDO() { return SCALES_74EDO; }
-const Scale* scales75EDO() { return SCALES_75EDO; }
-const Scale* scales76EDO() { return SCALES_76EDO; }
-const Scale* scales77EDO() { return SCALES_77EDO; }
-const Scale* scales78EDO() { return SCALES_78EDO; }
-const Scale* scales79EDO() { return SCALES_79EDO; }
-const Scale* scales80EDO() { return SCALES_80EDO; }
-const Scale* scales81EDO() { return SCALES_81EDO; }
-const Scale* scales82EDO() { return SCALES_82EDO; }
-const Scale* scales83EDO() { return SCALES_83EDO; }
-const Scale* scales84EDO() { return SCALES_84EDO; }
-const Scale* scales85EDO() { return SCALES_85EDO; }
-const Scale* scales86EDO() { return SCALES_86EDO; }
-const Scale* scales87EDO() { return SCALES_87EDO; }
-const Scale* scales88EDO() { return SCALES_88EDO; }
-const Scale* scales89EDO() { return SCALES_89EDO; }
-const Scale* scales90EDO() { return SCALES_90EDO; }
-const Scale* scales91EDO() { return SCALES_91EDO; }
-const Scale* scales92EDO() { return SCALES_92EDO; }
-const Scale* scales93EDO() { return SCALES_93EDO; }
-const Scale* scales94EDO() { return SCALES_94EDO; }
-const Scale* scales95EDO() { return SCALES_95EDO; }
-const Scale* scales96EDO() { return SCALES_96EDO; }
-const Scale* scales97EDO() { return SCALES_97EDO; }
-const Scale* scales98EDO() { return SCALES_98EDO; }
-const Scale* scales99EDO() { return SCALES_99EDO; }
-const Scale* scales100EDO() { return SCALES_100EDO; }
-const Scale* scales101EDO() { return SCALES_101EDO; }
-const Scale* scales102EDO() { return SCALES_102EDO; }
-const Scale* scales103EDO() { return SCALES_103EDO; }
-const Scale* scales104EDO() { return SCALES_104EDO; }
-const Scale* scales105EDO() { return SCALES_105EDO; }
-const Scale* scales106EDO() { return SCALES_106EDO; }
-const Scale* scales107EDO() { return SCALES_107EDO; }
-const Scale* scales108EDO() { return SCALES_108EDO; }
-const Scale* scales109EDO() { return SCALES_109EDO; }
-const Scale* scales110EDO() { return SCALES_110EDO; }
-const Scale* scales111EDO() { return SCALES_111EDO; }
-const Scale* scales112EDO() { return SCALES_112EDO; }
-const Scale* scales113EDO() { return SCALES_113EDO; }
-const Scale* scales114EDO() { return SCALES_114EDO; }
-const Scale* scales115EDO() { return SCALES_115EDO; }
-const Scale* scales116EDO() { return SCALES_116EDO; }
-const Scale* scales117EDO() { return SCALES_117EDO; }
-const Scale* scales118EDO() { return SCALES_118EDO; }
-const Scale* scales119EDO() { return SCALES_119EDO; }
-const Scale* scales120EDO() { return SCALES_120EDO; }
-
-// Array of function pointers to get scale arrays for each EDO (index 0 = 1-EDO, index 119 = 120-EDO)
-static const Scale* (*const EDO_SCALE_ARRAY_FUNCS[120])() = {
-    []() { return scales1EDO(); },   []() { return scales2EDO(); },   []() { return scales3EDO(); },   []() { return scales4EDO(); },
-    []() { return scales5EDO(); },   []() { return scales6EDO(); },   []() { return scales7EDO(); },   []() { return scales8EDO(); },
-    []() { return scales9EDO(); },   []() { return scales10EDO(); },  []() { return scales11EDO(); },  []() { return scales12EDO(); },
-    []() { return scales13EDO(); },  []() { return scales14EDO(); },  []() { return scales15EDO(); },  []() { return scales16EDO(); },
-    []() { return scales17EDO(); },  []() { return scales18EDO(); },  []() { return scales19EDO(); },  []() { return scales20EDO(); },
-    []() { return scales21EDO(); },  []() { return scales22EDO(); },  []() { return scales23EDO(); },  []() { return scales24EDO(); },
-    []() { return scales25EDO(); },  []() { return scales26EDO(); },  []() { return scales27EDO(); },  []() { return scales28EDO(); },
-    []() { return scales29EDO(); },  []() { return scales30EDO(); },  []() { return scales31EDO(); },  []() { return scales32EDO(); },
-    []() { return scales33EDO(); },  []() { return scales34EDO(); },  []() { return scales35EDO(); },  []() { return scales36EDO(); },
-    []() { return scales37EDO(); },  []() { return scales38EDO(); },  []() { return scales39EDO(); },  []() { return scales40EDO(); },
-    []() { return scales41EDO(); },  []() { return scales42EDO(); },  []() { return scales43EDO(); },  []() { return scales44EDO(); },
-    []() { return scales45EDO(); },  []() { return scales46EDO(); },  []() { return scales47EDO(); },  []() { return scales48EDO(); },
-    []() { return scales49EDO(); },  []() { return scales50EDO(); },  []() { return scales51EDO(); },  []() { return scales52EDO(); },
-    []() { return scales53EDO(); },  []() { return scales54EDO(); },  []() { return scales55EDO(); },  []() { return scales56EDO(); },
-    []() { return scales57EDO(); },  []() { return scales58EDO(); },  []() { return scales59EDO(); },  []() { return scales60EDO(); },
-    []() { return scales61EDO(); },  []() { return scales62EDO(); },  []() { return scales63EDO(); },  []() { return scales64EDO(); },
-    []() { return scales65EDO(); },  []() { return scales66EDO(); },  []() { return scales67EDO(); },  []() { return scales68EDO(); },
-    []() { return scales69EDO(); },  []() { return scales70EDO(); },  []() { return scales71EDO(); },  []() { return scales72EDO(); },
-    []() { return scales73EDO(); },  []() { return scales74EDO(); },  []() { return scales75EDO(); },  []() { return scales76EDO(); },
-    []() { return scales77EDO(); },  []() { return scales78EDO(); },  []() { return scales79EDO(); },  []() { return scales80EDO(); },
-    []() { return scales81EDO(); },  []() { return scales82EDO(); },  []() { return scales83EDO(); },  []() { return scales84EDO(); },
-    []() { return scales85EDO(); },  []() { return scales86EDO(); },  []() { return scales87EDO(); },  []() { return scales88EDO(); },
-    []() { return scales89EDO(); },  []() { return scales90EDO(); },  []() { return scales91EDO(); },  []() { return scales92EDO(); },
-    []() { return scales93EDO(); },  []() { return scales94EDO(); },  []() { return scales95EDO(); },  []() { return scales96EDO(); },
-    []() { return scales97EDO(); },  []() { return scales98EDO(); },  []() { return scales99EDO(); },  []() { return scales100EDO(); },
-    []() { return scales101EDO(); }, []() { return scales102EDO(); }, []() { return scales103EDO(); }, []() { return scales104EDO(); },
-    []() { return scales105EDO(); }, []() { return scales106EDO(); }, []() { return scales107EDO(); }, []() { return scales108EDO(); },
-    []() { return scales109EDO(); }, []() { return scales110EDO(); }, []() { return scales111EDO(); }, []() { return scales112EDO(); },
-    []() { return scales113EDO(); }, []() { return scales114EDO(); }, []() { return scales115EDO(); }, []() { return scales116EDO(); },
-    []() { return scales117EDO(); }, []() { return scales118EDO(); }, []() { return scales119EDO(); }, []() { return scales120EDO(); }
-};
+static constexpr Pool kPool = buildPool();
+
+const int NUM_SCALES_1EDO = kPool.count[1];
+const int NUM_SCALES_2EDO = kPool.count[2];
+const int NUM_SCALES_3EDO = kPool.count[3];
+const int NUM_SCALES_4EDO = kPool.count[4];
+const int NUM_SCALES_5EDO = kPool.count[5];
+const int NUM_SCALES_6EDO = kPool.count[6];
+const int NUM_SCALES_7EDO = kPool.count[7];
+const int NUM_SCALES_8EDO = kPool.count[8];
+const int NUM_SCALES_9EDO = kPool.count[9];
+const int NUM_SCALES_10EDO = kPool.count[10];
+const int NUM_SCALES_11EDO = kPool.count[11];
+const int NUM_SCALES_12EDO = kPool.count[12];
+const int NUM_SCALES_13EDO = kPool.count[13];
+const int NUM_SCALES_14EDO = kPool.count[14];
+const int NUM_SCALES_15EDO = kPool.count[15];
+const int NUM_SCALES_16EDO = kPool.count[16];
+const int NUM_SCALES_17EDO = kPool.count[17];
+const int NUM_SCALES_18EDO = kPool.count[18];
+const int NUM_SCALES_19EDO = kPool.count[19];
+const int NUM_SCALES_20EDO = kPool.count[20];
+const int NUM_SCALES_21EDO = kPool.count[21];
+const int NUM_SCALES_22EDO = kPool.count[22];
+const int NUM_SCALES_23EDO = kPool.count[23];
+const int NUM_SCALES_24EDO = kPool.count[24];
+const int NUM_SCALES_25EDO = kPool.count[25];
+const int NUM_SCALES_26EDO = kPool.count[26];
+const int NUM_SCALES_27EDO = kPool.count[27];
+const int NUM_SCALES_28EDO = kPool.count[28];
+const int NUM_SCALES_29EDO = kPool.count[29];
+const int NUM_SCALES_30EDO = kPool.count[30];
+const int NUM_SCALES_31EDO = kPool.count[31];
+const int NUM_SCALES_32EDO = kPool.count[32];
+const int NUM_SCALES_33EDO = kPool.count[33];
+const int NUM_SCALES_34EDO = kPool.count[34];
+const int NUM_SCALES_35EDO = kPool.count[35];
+const int NUM_SCALES_36EDO = kPool.count[36];
+const int NUM_SCALES_37EDO = kPool.count[37];
+const int NUM_SCALES_38EDO = kPool.count[38];
+const int NUM_SCALES_39EDO = kPool.count[39];
+const int NUM_SCALES_40EDO = kPool.count[40];
+const int NUM_SCALES_41EDO = kPool.count[41];
+const int NUM_SCALES_42EDO = kPool.count[42];
+const int NUM_SCALES_43EDO = kPool.count[43];
+const int NUM_SCALES_44EDO = kPool.count[44];
+const int NUM_SCALES_45EDO = kPool.count[45];
+const int NUM_SCALES_46EDO = kPool.count[46];
+const int NUM_SCALES_47EDO = kPool.count[47];
+const int NUM_SCALES_48EDO = kPool.count[48];
+const int NUM_SCALES_49EDO = kPool.count[49];
+const int NUM_SCALES_50EDO = kPool.count[50];
+const int NUM_SCALES_51EDO = kPool.count[51];
+const int NUM_SCALES_52EDO = kPool.count[52];
+const int NUM_SCALES_53EDO = kPool.count[53];
+const int NUM_SCALES_54EDO = kPool.count[54];
+const int NUM_SCALES_55EDO = kPool.count[55];
+const int NUM_SCALES_56EDO = kPool.count[56];
+const int NUM_SCALES_57EDO = kPool.count[57];
+const int NUM_SCALES_58EDO = kPool.count[58];
+const int NUM_SCALES_59EDO = kPool.count[59];
+const int NUM_SCALES_60EDO = kPool.count[60];
+const int NUM_SCALES_61EDO = kPool.count[61];
+const int NUM_SCALES_62EDO = kPool.count[62];
+const int NUM_SCALES_63EDO = kPool.count[63];
+const int NUM_SCALES_64EDO = kPool.count[64];
+const int NUM_SCALES_65EDO = kPool.count[65];
+const int NUM_SCALES_66EDO = kPool.count[66];
+const int NUM_SCALES_67EDO = kPool.count[67];
+const int NUM_SCALES_68EDO = kPool.count[68];
+const int NUM_SCALES_69EDO = kPool.count[69];
+const int NUM_SCALES_70EDO = kPool.count[70];
+const int NUM_SCALES_71EDO = kPool.count[71];
+const int NUM_SCALES_72EDO = kPool.count[72];
+const int NUM_SCALES_73EDO = kPool.count[73];
+const int NUM_SCALES_74EDO = kPool.count[74];
+const int NUM_SCALES_75EDO = kPool.count[75];
+const int NUM_SCALES_76EDO = kPool.count[76];
+const int NUM_SCALES_77EDO = kPool.count[77];
+const int NUM_SCALES_78EDO = kPool.count[78];
+const int NUM_SCALES_79EDO = kPool.count[79];
+const int NUM_SCALES_80EDO = kPool.count[80];
+const int NUM_SCALES_81EDO = kPool.count[81];
+const int NUM_SCALES_82EDO = kPool.count[82];
+const int NUM_SCALES_83EDO = kPool.count[83];
+const int NUM_SCALES_84EDO = kPool.count[84];
+const int NUM_SCALES_85EDO = kPool.count[85];
+const int NUM_SCALES_86EDO = kPool.count[86];
+const int NUM_SCALES_87EDO = kPool.count[87];
+const int NUM_SCALES_88EDO = kPool.count[88];
+const int NUM_SCALES_89EDO = kPool.count[89];
+const int NUM_SCALES_90EDO = kPool.count[90];
+const int NUM_SCALES_91EDO = kPool.count[91];
+const int NUM_SCALES_92EDO = kPool.count[92];
+const int NUM_SCALES_93EDO = kPool.count[93];
+const int NUM_SCALES_94EDO = kPool.count[94];
+const int NUM_SCALES_95EDO = kPool.count[95];
+const int NUM_SCALES_96EDO = kPool.count[96];
+const int NUM_SCALES_97EDO = kPool.count[97];
+const int NUM_SCALES_98EDO = kPool.count[98];
+const int NUM_SCALES_99EDO = kPool.count[99];
+const int NUM_SCALES_100EDO = kPool.count[100];
+const int NUM_SCALES_101EDO = kPool.count[101];
+const int NUM_SCALES_102EDO = kPool.count[102];
+const int NUM_SCALES_103EDO = kPool.count[103];
+const int NUM_SCALES_104EDO = kPool.count[104];
+const int NUM_SCALES_105EDO = kPool.count[105];
+const int NUM_SCALES_106EDO = kPool.count[106];
+const int NUM_SCALES_107EDO = kPool.count[107];
+const int NUM_SCALES_108EDO = kPool.count[108];
+const int NUM_SCALES_109EDO = kPool.count[109];
+const int NUM_SCALES_110EDO = kPool.count[110];
+const int NUM_SCALES_111EDO = kPool.count[111];
+const int NUM_SCALES_112EDO = kPool.count[112];
+const int NUM_SCALES_113EDO = kPool.count[113];
+const int NUM_SCALES_114EDO = kPool.count[114];
+const int NUM_SCALES_115EDO = kPool.count[115];
+const int NUM_SCALES_116EDO = kPool.count[116];
+const int NUM_SCALES_117EDO = kPool.count[117];
+const int NUM_SCALES_118EDO = kPool.count[118];
+const int NUM_SCALES_119EDO = kPool.count[119];
+const int NUM_SCALES_120EDO = kPool.count[120];
+
+static int clampEdo(int edo) { return (edo < 1 || edo > MAX_SCALE_EDO) ? 12 : edo; }
+
+ScaleBits scaleBits(int edo, int index) {
+    edo = clampEdo(edo);
+    if (index < 0 || index >= kPool.count[edo]) index = 0;
+    const PoolEntry& pe = kPool.entries[kPool.first[edo] + index];
+    return ScaleBits{pe.name, edo, kPool.words + pe.offset};
+}
+
+// Helper function to get number of scales for EDO divisions
+int numScalesEDO(int edo) {
+    // Out-of-range EDOs fall back to 1 (chromatic)
+    if (edo < 1 || edo > MAX_SCALE_EDO) return 1;
+    return kPool.count[edo];
+}
 
 // Helper function to get EDO scales based on Number of EDO divisions
 const Scale* scalesEDO(int edo) {
-    // Bounds check: EDO must be between 1 and 120
-    if (edo < 1 || edo > 120) {
-        return scales12EDO(); // fallback to 12-EDO
-    }
-    
-    // Call the appropriate function (convert 1-based EDO to 0-based index)
-    return EDO_SCALE_ARRAY_FUNCS[edo - 1]();
+    edo = clampEdo(edo);                          // Out-of-range EDOs fall back to 12-EDO
+    static std::vector<Scale> built[MAX_SCALE_EDO];
+    static std::once_flag once[MAX_SCALE_EDO];
+    std::call_once(once[edo - 1], [edo] {         // Materialize this EDO once; pointers stay valid afterwards
+        std::vector<Scale>& v = built[edo - 1];
+        v.reserve(kPool.count[edo]);
+        for (int i = 0; i < kPool.count[edo]; ++i) {
+            ScaleBits sb = scaleBits(edo, i);
+            std::vector<uint8_t> mask(edo, 0);
+            for (int d = 0; d < edo; ++d) mask[d] = sb.test(d) ? 1 : 0;
+            v.emplace_back(sb.name, mask);
+        }
+    });
+    return built[edo - 1].data();
+}
+
+// ─── Detection index ─────────────────────────────────────────────────────────
+
+// Mask rotated so its first active degree is bit 0 (all-zero masks stay zero).
+struct CanonKey {
+    uint64_t w[2] = {0, 0};
+    bool operator==(const CanonKey& o) const { return w[0] == o.w[0] && w[1] == o.w[1]; }
+};
+static_assert(MAX_SCALE_EDO <= 128, "CanonKey holds at most 128 degrees");
+
+template <class BitFn> static CanonKey canonicalKey(int edo, BitFn bit) {
+    int root = 0;
+    while (root < edo && !bit(root)) ++root;
+    if (root == edo) root = 0;
+    CanonKey k;
+    for (int i = 0, d = root; i < edo; ++i, d = (d + 1 == edo) ? 0 : d + 1)
+        if (bit(d)) k.w[i >> 6] |= uint64_t(1) << (i & 63);
+    return k;
+}
+
+// Same FNV-1a scheme as PolyQuanta::hashMask(), folded over the key words.
+static uint64_t hashKey(const CanonKey& k, int edo) {
+    uint64_t h = 1469598103934665603ull;
+    auto fnv1a = [&h](uint64_t v) { h ^= v; h *= 1099511628211ull; };
+    fnv1a(k.w[0]);
+    fnv1a(k.w[1]);
+    fnv1a((uint64_t)edo);
+    return h;
+}
+
+struct DetectIndex {
+    std::vector<CanonKey> keys;    // Per preset, in table order
+    std::vector<int> slots;        // Open addressing (linear probe); -1 = empty
+    size_t slotMask = 0;
+};
+
+static const DetectIndex& detectIndex(int edo) {
+    static DetectIndex built[MAX_SCALE_EDO];
+    static std::once_flag once[MAX_SCALE_EDO];
+    std::call_once(once[edo - 1], [edo] {
+        DetectIndex& ix = built[edo - 1];
+        const int n = kPool.count[edo];
+        size_t cap = 4;
+        while (cap < (size_t)n * 2) cap <<= 1;       // Load factor <= 0.5
+        ix.slots.assign(cap, -1);
+        ix.slotMask = cap - 1;
+        ix.keys.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            ScaleBits sb = scaleBits(edo, i);
+            ix.keys.push_back(canonicalKey(edo, [&sb](int d) { return sb.test(d); }));
+            size_t s = hashKey(ix.keys[i], edo) & ix.slotMask;
+            while (ix.slots[s] >= 0 && !(ix.keys[ix.slots[s]] == ix.keys[i])) s = (s + 1) & ix.slotMask;
+            if (ix.slots[s] < 0) ix.slots[s] = i;      // Duplicates keep the lowest index (old scan order)
+        }
+    });
+    return built[edo - 1];
 }
 
+int findScaleIndex(const std::vector<uint8_t>& mask, int edo) {
+    if (edo < 1 || edo > MAX_SCALE_EDO || (int)mask.size() != edo) return -1;
+    const DetectIndex& ix = detectIndex(edo);
+    const CanonKey k = canonicalKey(edo, [&mask](int d) { return mask[d] != 0; });
+    for (size_t s = hashKey(k, edo) & ix.slotMask; ix.slots[s] >= 0; s = (s + 1) & ix.slotMask)
+        if (ix.keys[ix.slots[s]] == k) return ix.slots[s];
+    return -1;
+}
+
+// Accessor functions EDO scales 1-120
+const Scale* scales1EDO() { return scalesEDO(1); }
+const Scale* scales2EDO() { return scalesEDO(2); }
+const Scale* scales3EDO() { return scalesEDO(3); }
+const Scale* scales4EDO() { return scalesEDO(4); }
+const Scale* scales5EDO() { return scalesEDO(5); }
+const Scale* scales6EDO() { return scalesEDO(6); }
+const Scale* scales7EDO() { return scalesEDO(7); }
+const Scale* scales8EDO() { return scalesEDO(8); }
+const Scale* scales9EDO() { return scalesEDO(9); }
+const Scale* scales10EDO() { return scalesEDO(10); }
+const Scale* scales11EDO() { return scalesEDO(11); }
+const Scale* scales12EDO() { return scalesEDO(12); }
+const Scale* scales13EDO() { return scalesEDO(13); }
+const Scale* scales14EDO() { return scalesEDO(14); }
+const Scale* scales15EDO() { return scalesEDO(15); }
+const Scale* scales16EDO() { return scalesEDO(16); }
+const Scale* scales17EDO() { return scalesEDO(17); }
+const Scale* scales18EDO() { return scalesEDO(18); }
+const Scale* scales19EDO() { return scalesEDO(19); }
+const Scale* scales20EDO() { return scalesEDO(20); }
+const Scale* scales21EDO() { return scalesEDO(21); }
+const Scale* scales22EDO() { return scalesEDO(22); }
+const Scale* scales23EDO() { return scalesEDO(23); }
+const Scale* scales24EDO() { return scalesEDO(24); }
+const Scale* scales25EDO() { return scalesEDO(25); }
+const Scale* scales26EDO() { return scalesEDO(26); }
+const Scale* scales27EDO() { return scalesEDO(27); }
+const Scale* scales28EDO() { return scalesEDO(28); }
+const Scale* scales29EDO() { return scalesEDO(29); }
+const Scale* scales30EDO() { return scalesEDO(30); }
+const Scale* scales31EDO() { return scalesEDO(31); }
+const Scale* scales32EDO() { return scalesEDO(32); }
+const Scale* scales33EDO() { return scalesEDO(33); }
+const Scale* scales34EDO() { return scalesEDO(34); }
+const Scale* scales35EDO() { return scalesEDO(35); }
+const Scale* scales36EDO() { return scalesEDO(36); }
+const Scale* scales37EDO() { return scalesEDO(37); }
+const Scale* scales38EDO() { return scalesEDO(38); }
+const Scale* scales39EDO() { return scalesEDO(39); }
+const Scale* scales40EDO() { return scalesEDO(40); }
+const Scale* scales41EDO() { return scalesEDO(41); }
+const Scale* scales42EDO() { return scalesEDO(42); }
+const Scale* scales43EDO() { return scalesEDO(43); }
+const Scale* scales44EDO() { return scalesEDO(44); }
+const Scale* scales45EDO() { return scalesEDO(45); }
+const Scale* scales46EDO() { return scalesEDO(46); }
+const Scale* scales47EDO() { return scalesEDO(47); }
+const Scale* scales48EDO() { return scalesEDO(48); }
+const Scale* scales49EDO() { return scalesEDO(49); }
+const Scale* scales50EDO() { return scalesEDO(50); }
+const Scale* scales51EDO() { return scalesEDO(51); }
+const Scale* scales52EDO() { return scalesEDO(52); }
+const Scale* scales53EDO() { return scalesEDO(53); }
+const Scale* scales54EDO() { return scalesEDO(54); }
+const Scale* scales55EDO() { return scalesEDO(55); }
+const Scale* scales56EDO() { return scalesEDO(56); }
+const Scale* scales57EDO() { return scalesEDO(57); }
+const Scale* scales58EDO() { return scalesEDO(58); }
+const Scale* scales59EDO() { return scalesEDO(59); }
+const Scale* scales60EDO() { return scalesEDO(60); }
+const Scale* scales61EDO() { return scalesEDO(61); }
+const Scale* scales62EDO() { return scalesEDO(62); }
+const Scale* scales63EDO() { return scalesEDO(63); }
+const Scale* scales64EDO() { return scalesEDO(64); }
+const Scale* scales65EDO() { return scalesEDO(65); }
+const Scale* scales66EDO() { return scalesEDO(66); }
+const Scale* scales67EDO() { return scalesEDO(67); }
+const Scale* scales68EDO() { return scalesEDO(68); }
+const Scale* scales69EDO() { return scalesEDO(69); }
+const Scale* scales70EDO() { return scalesEDO(70); }
+const Scale* scales71EDO() { return scalesEDO(71); }
+const Scale* scales72EDO() { return scalesEDO(72); }
+const Scale* scales73EDO() { return scalesEDO(73); }
+const Scale* scales74EDO() { return scalesEDO(74); }
+const Scale* scales75EDO() { return scalesEDO(75); }
+const Scale* scales76EDO() { return scalesEDO(76); }
+const Scale* scales77EDO() { return scalesEDO(77); }
+const Scale* scales78EDO() { return scalesEDO(78); }
+const Scale* scales79EDO() { return scalesEDO(79); }
+const Scale* scales80EDO() { return scalesEDO(80); }
+const Scale* scales81EDO() { return scalesEDO(81); }
+const Scale* scales82EDO() { return scalesEDO(82); }
+const Scale* scales83EDO() { return scalesEDO(83); }
+const Scale* scales84EDO() { return scalesEDO(84); }
+const Scale* scales85EDO() { return scalesEDO(85); }
+const Scale* scales86EDO() { return scalesEDO(86); }
+const Scale* scales87EDO() { return scalesEDO(87); }
+const Scale* scales88EDO() { return scalesEDO(88); }
+const Scale* scales89EDO() { return scalesEDO(89); }
+const Scale* scales90EDO() { return scalesEDO(90); }
+const Scale* scales91EDO() { return scalesEDO(91); }
+const Scale* scales92EDO() { return scalesEDO(92); }
+const Scale* scales93EDO() { return scalesEDO(93); }
+const Scale* scales94EDO() { return scalesEDO(94); }
+const Scale* scales95EDO() { return scalesEDO(95); }
+const Scale* scales96EDO() { return scalesEDO(96); }
+const Scale* scales97EDO() { return scalesEDO(97); }
+const Scale* scales98EDO() { return scalesEDO(98); }
+const Scale* scales99EDO() { return scalesEDO(99); }
+const Scale* scales100EDO() { return scalesEDO(100); }
+const Scale* scales101EDO() { return scalesEDO(101); }
+const Scale* scales102EDO() { return scalesEDO(102); }
+const Scale* scales103EDO() { return scalesEDO(103); }
+const Scale* scales104EDO() { return scalesEDO(104); }
+const Scale* scales105EDO() { return scalesEDO(105); }
+const Scale* scales106EDO() { return scalesEDO(106); }
+const Scale* scales107EDO() { return scalesEDO(107); }
+const Scale* scales108EDO() { return scalesEDO(108); }
+const Scale* scales109EDO() { return scalesEDO(109); }
+const Scale* scales110EDO() { return scalesEDO(110); }
+const Scale* scales111EDO() { return scalesEDO(111); }
+const Scale* scales112EDO() { return scalesEDO(112); }
+const Scale* scales113EDO() { return scalesEDO(113); }
+const Scale* scales114EDO() { return scalesEDO(114); }
+const Scale* scales115EDO() { return scalesEDO(115); }
+const Scale* scales116EDO() { return scalesEDO(116); }
+const Scale* scales117EDO() { return scalesEDO(117); }
+const Scale* scales118EDO() { return scalesEDO(118); }
+const Scale* scales119EDO() { return scalesEDO(119); }
+const Scale* scales120EDO() { return scalesEDO(120); }
+
 }} // namespace hi::music
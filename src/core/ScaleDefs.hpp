@@ -6,6 +6,9 @@
  * ARRAY ORDER IS STABLE and MUST NOT CHANGE to preserve JSON/backwards compatibility 
  * (scaleIndex persisted values map directly to these indices). Any additions must 
  * append at the end only.
+ *
+ * Storage is a constexpr packed bit pool (see ScaleDefs.cpp); scaleBits() reads it
+ * directly, while scalesEDO() builds the Scale array for one EDO on first use.
  */
 namespace hi { namespace music {
 struct Scale { 
@@ -45,6 +48,16 @@ struct Scale {
     Scale(const char* n, const std::vector<uint8_t>& m) : name(n), mask(m) {}
 };
 
+static constexpr int MAX_SCALE_EDO = 120;
+
+// Allocation-free view of a built-in preset: words point into the constexpr pool.
+struct ScaleBits {
+    const char* name;
+    int edo;                 // Mask length in degrees
+    const uint64_t* words;   // (edo + 63) / 64 words, bit d = degree d
+    bool test(int d) const { return (words[d >> 6] >> (d & 63)) & 1u; }
+};
+
 
 
 // EDO-specific scales (1-120 in order)
@@ -291,7 +304,14 @@ const Scale* scales118EDO();
 const Scale* scales119EDO();
 const Scale* scales120EDO();
 
-// Helper function to get EDO scales based on Number of EDO divisions
+// Helper function to get EDO scales based on Number of EDO divisions.
+// Materializes that EDO's Scale array on first call (thread-safe); the pointer stays valid.
 const Scale* scalesEDO(int edo);
+// Packed preset without materializing; out-of-range edo/index fall back to 12-EDO / index 0.
+ScaleBits scaleBits(int edo, int index);
 int numScalesEDO(int edo);
+// Index of the first edo preset equal to mask once both are rotated to start on their first
+// active degree (scale::masksEqual semantics), or -1. O(1) via a per-EDO FNV-1a hash index
+// built on first use; no allocation per lookup.
+int findScaleIndex(const std::vector<uint8_t>& mask, int edo);
 }} // namespace hi::music
@@ -0,0 +1,126 @@
+#include "ScalePack.hpp"
+#include <cstring>
+#include <fstream>
+#include <map>
+/*
+ * ScalePack.cpp — .pqsp serialization, bounds validation and file loading.
+ * Structs are copied as host bytes; every platform Rack ships on is
+ * little-endian, which is the on-disk order.
+ */
+namespace hi { namespace music { namespace scalepack {
+namespace {
+inline uint32_t align8(size_t n) { return (uint32_t)((n + 7u) & ~(size_t)7u); }
+inline uint32_t wordsFor(int edo) { return (uint32_t)((edo + 63) / 64); }
+
+bool fail(std::string* err, const char* why) {
+    if (err) *err = why;
+    return false;
+}
+} // namespace
+
+bool write(const std::vector<Source>& sources, std::vector<uint8_t>& out, std::string* err) {
+    std::vector<Entry> entries;
+    std::vector<uint64_t> words;
+    std::string names;
+    std::map<std::string, uint32_t> nameAt;                 // Batch packs repeat names per EDO: store each once
+    entries.reserve(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const Source& s = sources[i];
+        const int edo = (int)s.mask.size();
+        if (edo < 1 || edo > MAX_SCALE_EDO) {
+            if (err) *err = "mask size out of range: " + s.name;
+            return false;
+        }
+        Entry e;
+        e.edo = (uint16_t)edo;
+        e.flags = 0;
+        std::map<std::string, uint32_t>::const_iterator it = nameAt.find(s.name);
+        if (it == nameAt.end()) {
+            it = nameAt.insert(std::make_pair(s.name, (uint32_t)names.size())).first;
+            names.append(s.name.c_str(), s.name.size() + 1);   // Keep the NUL
+        }
+        e.nameOffset = it->second;
+        e.wordOffset = (uint32_t)words.size();
+        e.reserved = 0;
+        words.resize(words.size() + wordsFor(edo), 0ull);
+        for (int d = 0; d < edo; ++d)
+            if (s.mask[(size_t)d]) words[e.wordOffset + (uint32_t)(d >> 6)] |= 1ull << (d & 63);
+        entries.push_back(e);
+    }
+    if (names.empty()) names.push_back('\0');              // Empty pack: still a terminated table
+
+    Header h;
+    h.magic = kMagic;
+    h.version = kVersion;
+    h.entrySize = (uint16_t)sizeof(Entry);
+    h.count = (uint32_t)entries.size();
+    h.wordCount = (uint32_t)words.size();
+    h.entriesOffset = align8(sizeof(Header));
+    h.wordsOffset = align8(h.entriesOffset + entries.size() * sizeof(Entry));
+    h.namesOffset = align8(h.wordsOffset + words.size() * sizeof(uint64_t));
+    h.namesSize = (uint32_t)names.size();
+
+    out.assign(align8(h.namesOffset + names.size()), 0);
+    std::memcpy(&out[0], &h, sizeof(Header));
+    if (!entries.empty()) std::memcpy(&out[h.entriesOffset], entries.data(), entries.size() * sizeof(Entry));
+    if (!words.empty()) std::memcpy(&out[h.wordsOffset], words.data(), words.size() * sizeof(uint64_t));
+    std::memcpy(&out[h.namesOffset], names.data(), names.size());
+    return true;
+}
+
+bool open(const void* data, size_t size, View& out, std::string* err) {
+    out = View();
+    if (!data || size < sizeof(Header)) return fail(err, "truncated header");
+    if (((uintptr_t)data & 7u) != 0) return fail(err, "buffer not 8-byte aligned");
+    const uint8_t* base = (const uint8_t*)data;
+    const Header* h = (const Header*)base;
+    if (h->magic != kMagic) return fail(err, "not a scale pack");
+    if (h->version != kVersion) return fail(err, "unsupported pack version");
+    if (h->entrySize != sizeof(Entry)) return fail(err, "unexpected entry size");
+
+    // Sections must be aligned, in range, and the name table NUL-terminated.
+    const uint64_t entriesEnd = (uint64_t)h->entriesOffset + (uint64_t)h->count * sizeof(Entry);
+    const uint64_t wordsEnd = (uint64_t)h->wordsOffset + (uint64_t)h->wordCount * sizeof(uint64_t);
+    const uint64_t namesEnd = (uint64_t)h->namesOffset + h->namesSize;
+    if ((h->entriesOffset | h->wordsOffset) & 7u) return fail(err, "misaligned section");
+    if (h->entriesOffset < sizeof(Header) || entriesEnd > size || wordsEnd > size || namesEnd > size)
+        return fail(err, "section out of range");
+    if (h->namesSize == 0 || base[h->namesOffset + h->namesSize - 1] != '\0')
+        return fail(err, "name table not terminated");
+
+    const Entry* entries = (const Entry*)(base + h->entriesOffset);
+    for (uint32_t i = 0; i < h->count; ++i) {
+        const Entry& e = entries[i];
+        if (e.edo < 1 || e.edo > MAX_SCALE_EDO) return fail(err, "entry EDO out of range");
+        if ((uint64_t)e.wordOffset + wordsFor(e.edo) > h->wordCount) return fail(err, "entry mask out of range");
+        if (e.nameOffset >= h->namesSize) return fail(err, "entry name out of range");
+    }
+
+    out.header = h;
+    out.entries = entries;
+    out.words = (const uint64_t*)(base + h->wordsOffset);
+    out.names = (const char*)(base + h->namesOffset);
+    return true;
+}
+
+bool load(const std::string& path, Pack& out, std::string* err) {
+    std::ifstream f(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!f) return fail(err, "cannot open file");
+    const std::streamoff size = f.tellg();
+    if (size <= 0) return fail(err, "empty file");
+    std::vector<uint64_t> storage(((size_t)size + 7u) / 8u, 0ull);
+    f.seekg(0);
+    if (!f.read((char*)storage.data(), size)) return fail(err, "read error");
+    View v;
+    if (!open(storage.data(), (size_t)size, v, err)) return false;
+    out.path = path;
+    out.storage.swap(storage);     // Swapping keeps the heap block, so v stays valid
+    out.view = v;
+    return true;
+}
+
+std::deque<Pack>& registry() {
+    static std::deque<Pack> packs;
+    return packs;
+}
+}}} // namespace hi::music::scalepack
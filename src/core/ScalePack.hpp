@@ -0,0 +1,89 @@
+#pragma once
+/*
+ * ScalePack.hpp — Versioned binary scale packs (.pqsp) written by
+ * helpers/scale_converter --pack and loaded by the plugin at startup.
+ *
+ * Layout (little-endian, every section 8-byte aligned):
+ *   Header | Entry[count] | uint64_t words[wordCount] | name table
+ * Each entry points at its (edo + 63) / 64 mask words (bit d = degree d, the
+ * same packing as ScaleBits) and at a NUL-terminated name. open() only checks
+ * bounds, so a loaded pack is used in place with no parsing or allocation per
+ * scale; the buffer can be a file read or a memory map.
+ *
+ * C++11 and Rack-free: the helper compiles this file alongside its own code.
+ */
+#include "ScaleDefs.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace hi { namespace music { namespace scalepack {
+static constexpr uint32_t kMagic   = 0x50535150u;   // "PQSP" as stored bytes
+static constexpr uint16_t kVersion = 1;
+
+struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entrySize;      // sizeof(Entry) at write time (lets a reader skip future fields)
+    uint32_t count;          // Number of entries
+    uint32_t wordCount;      // Size of the bit pool in uint64 words
+    uint32_t entriesOffset;  // Byte offsets from the start of the pack
+    uint32_t wordsOffset;
+    uint32_t namesOffset;
+    uint32_t namesSize;      // Bytes in the name table (last byte is NUL)
+};
+
+struct Entry {
+    uint16_t edo;            // Mask length in degrees (1..MAX_SCALE_EDO)
+    uint16_t flags;          // Reserved (0)
+    uint32_t nameOffset;     // Into the name table
+    uint32_t wordOffset;     // Into the bit pool, in words
+    uint32_t reserved;       // Keeps Entry a multiple of 8 bytes
+};
+
+// Writer input: a root-relative mask (size = EDO) and its display name.
+struct Source {
+    std::string name;
+    std::vector<uint8_t> mask;
+};
+
+// Serialize sources into out. False (out untouched) if a mask is empty or longer than
+// MAX_SCALE_EDO; err, when set, names the offending scale.
+bool write(const std::vector<Source>& sources, std::vector<uint8_t>& out, std::string* err = nullptr);
+
+// Read-only view over a validated pack. Pointers alias the caller's buffer.
+struct View {
+    const Header* header = nullptr;
+    const Entry* entries = nullptr;
+    const uint64_t* words = nullptr;
+    const char* names = nullptr;
+
+    uint32_t count() const { return header ? header->count : 0u; }
+    ScaleBits at(uint32_t i) const {
+        const Entry& e = entries[i];
+        ScaleBits b;
+        b.name = names + e.nameOffset;
+        b.edo = e.edo;
+        b.words = words + e.wordOffset;
+        return b;
+    }
+};
+
+// Validate data (8-byte aligned, size bytes) and point out at it. False on a bad magic,
+// an unknown version or any out-of-range offset; err, when set, gets a one-line reason.
+bool open(const void* data, size_t size, View& out, std::string* err = nullptr);
+
+// A pack file read into one word-aligned buffer.
+struct Pack {
+    std::string path;
+    std::vector<uint64_t> storage;
+    View view;
+};
+bool load(const std::string& path, Pack& out, std::string* err = nullptr);
+
+// Process-wide packs, filled once from plugin init() before any module exists and read-only
+// afterwards. A deque so adding a pack never moves the ones whose views are already handed out.
+std::deque<Pack>& registry();
+}}} // namespace hi::music::scalepack
@@ -1,13 +1,13 @@
 #define HI_STRUM_IMPL
 #include "Strum.hpp"
+#include <cmath>
 #ifndef UNIT_TESTS
 #include <rack.hpp> // Rack SDK (rack::random)
 using namespace rack;
 #endif
 /*
- * Strum.cpp — Definitions for relocated strum helpers.
- * Logic and math are copied verbatim from original PolyQuanta.cpp to maintain
- * identical runtime behavior. Comments augmented for clarity.
+ * Strum.cpp — Definitions for the strum helpers and the StartDelay Scheduler
+ * (see Strum.hpp for the timing model).
  */
 namespace hi { namespace dsp { namespace strum {
     void assign(float spreadMs, int N, Mode mode, float outDelaySec[16]) {
@@ -28,6 +28,14 @@ namespace hi { namespace dsp { namespace strum {
             outDelaySec[ch] = d;
         }
     }
+    void assign(float spreadMs, int N, Mode mode, float outDelaySec[16], hi::dsp::rng::Xoroshiro& rng) {
+        if (mode != Mode::Random) { assign(spreadMs, N, mode, outDelaySec); return; }
+        const int n = (N < 16) ? N : 16;
+        if (n <= 0) return;
+        float base = (spreadMs <= 0.f) ? 0.f : (spreadMs * 0.001f);
+        rng.fillUniform(outDelaySec, n);                        // One batch for every voice
+        for (int ch = 0; ch < n; ++ch) outDelaySec[ch] *= base;
+    }
     void tickStartDelays(float dt, int N, float delaysLeft[16]) {
         for (int ch = 0; ch < N && ch < 16; ++ch) {
             if (delaysLeft[ch] > 0.f) {
@@ -35,4 +43,66 @@ namespace hi { namespace dsp { namespace strum {
             }
         }
     }
+    uint32_t delaySamples(float delaySec, float dt) {
+        if (!(delaySec > 0.f) || !(dt > 0.f)) return 0;
+        return (uint32_t)std::ceil((double)delaySec / (double)dt - 1e-3);
+    }
+
+    // ─── Scheduler (binary min-heap over at most 16 channels) ───
+    void Scheduler::swapSlots(int i, int j) {
+        int8_t a = heap[i], b = heap[j];
+        heap[i] = b; heap[j] = a;
+        slot[b] = (int8_t)i; slot[a] = (int8_t)j;
+    }
+    void Scheduler::siftUp(int i) {
+        while (i > 0) {
+            int p = (i - 1) >> 1;
+            if (!less(i, p)) break;
+            swapSlots(i, p); i = p;
+        }
+    }
+    void Scheduler::siftDown(int i) {
+        for (;;) {
+            int l = 2 * i + 1, r = l + 1, m = i;
+            if (l < size && less(l, m)) m = l;
+            if (r < size && less(r, m)) m = r;
+            if (m == i) break;
+            swapSlots(i, m); i = m;
+        }
+    }
+    void Scheduler::removeAt(int i) {
+        int ch = heap[i];
+        --size;
+        if (i != size) {
+            swapSlots(i, size);
+            siftDown(i); siftUp(i);
+        }
+        slot[ch] = -1;
+    }
+    void Scheduler::schedule(int ch, uint32_t samples) {
+        if (ch < 0 || ch >= 16) return;
+        if (samples == 0) { cancel(ch); return; }
+        fireAt[ch] = now + samples;
+        if (slot[ch] < 0) {                                    // New entry at the bottom
+            heap[size] = (int8_t)ch; slot[ch] = (int8_t)size; ++size;
+        }
+        siftUp(slot[ch]); siftDown(slot[ch]);                  // Re-key in place (earlier or later)
+    }
+    void Scheduler::cancel(int ch) {
+        if (ch >= 0 && ch < 16 && slot[ch] >= 0) removeAt(slot[ch]);
+    }
+    void Scheduler::clear() {
+        for (int ch = 0; ch < 16; ++ch) slot[ch] = -1;
+        size = 0;
+    }
+    int Scheduler::advance(int8_t* woken) {
+        ++now;
+        int n = 0;
+        while (size > 0 && fireAt[heap[0]] <= now) {
+            if (woken) woken[n] = heap[0];
+            ++n;
+            removeAt(0);
+        }
+        return n;
+    }
 }}} // namespace hi::dsp::strum
@@ -1,29 +1,68 @@
 #pragma once
 /*
- * Strum.hpp — Relocated (verbatim) strum timing helpers from PolyQuanta.cpp.
- * Provides deterministic per-channel delay assignments used by PolyQuanta
- * for Up/Down/Random strum ordering and countdown tick logic.
+ * Strum.hpp — Strum timing helpers for PolyQuanta: per-channel delay
+ * assignment for Up/Down/Random ordering and the StartDelay hold scheduler.
  *
- * Functions are pure and have no side effects beyond writing to provided
- * arrays; behavior must remain bit‑for‑bit identical to the original.
+ * assign() is pure apart from writing the provided array (and drawing from
+ * the RNG for Random order). StartDelay holds run on Scheduler: a delay is
+ * converted once by delaySamples() to ceil(delay / dt) whole samples and the
+ * channel is released on that sample. This is an intended timing change from
+ * the old per-sample float countdown, whose accumulated rounding could add or
+ * drop a sample; the strum_seq replay golden was regenerated for it.
  * Arguments:
  *  spreadMs   : milliseconds between adjacent channels (0 => all zero)
  *  N          : number of active voices (<=16)
  *  mode       : ordering (Up, Down, Random)
  *  outDelaySec[16] : output array of per‑channel delays in SECONDS
- *  tickStartDelays(): decrements per-channel remaining delays in place.
+ *  tickStartDelays(): the old per-sample countdown, kept as a reference for tests.
+ *  Scheduler  : event-driven StartDelay holds (see below).
  */
 #include <cstddef>
+#include <cstdint>
+#include "Rng.hpp"
 #ifdef UNIT_TESTS
 #include <cstdlib>
 #endif
 namespace hi { namespace dsp { namespace strum {
-    enum class Mode { Up = 0, Down = 1, Random = 2 }; // (verbatim enum)
+    enum class Mode { Up = 0, Down = 1, Random = 2 };
     enum class Type { TimeStretch = 0, StartDelay = 1 }; // retained for context (not used here directly)
-    // Assign per-channel delays (seconds) given ms spread, voice count, and mode. (Relocated verbatim)
+    // Assign per-channel delays (seconds) given ms spread, voice count, and mode.
     void assign(float spreadMs, int N, Mode mode, float outDelaySec[16]);
-    // Tick countdown timers for StartDelay type (relocated verbatim)
+    // Same, with Random order drawn from a per-instance generator in one batch (reproducible
+    // from its seed/state; the overload above uses rack::random's global generator).
+    void assign(float spreadMs, int N, Mode mode, float outDelaySec[16], hi::dsp::rng::Xoroshiro& rng);
+    // Per-sample countdown of StartDelay timers; no longer used by the engine (reference for tests)
     void tickStartDelays(float dt, int N, float delaysLeft[16]);
+    // Whole samples a StartDelay voice is held for a delay in seconds: ceil(delay / dt), with
+    // exact multiples of dt not gaining a sample from rounding noise.
+    uint32_t delaySamples(float delaySec, float dt);
+
+    // Sample-accurate StartDelay scheduler: a fixed 16-slot min-heap of channels keyed by the
+    // sample index on which their delay expires. A queued channel is held; advance() moves
+    // time one sample and pops only the expired entries, so idle strums cost one increment
+    // and re-triggering a channel mid-strum re-keys its heap slot in O(log 16).
+    struct Scheduler {
+        uint64_t now = 0;                   // Samples advanced so far
+        uint64_t fireAt[16] = {0};          // Expiry sample per channel (valid while queued)
+        int8_t heap[16] = {0};              // Channels ordered by fireAt (min at [0])
+        int8_t slot[16] = {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}; // Heap index per channel, -1 = idle
+        int size = 0;                       // Queued channels
+        bool held(int ch) const { return slot[ch] >= 0; }
+        bool idle() const { return size == 0; }
+        // Hold ch for the next `samples` samples (counting the current one); 0 releases it.
+        void schedule(int ch, uint32_t samples);
+        void cancel(int ch);
+        void clear();
+        // End of sample: advance time and release expired channels (written to woken[] if
+        // given). Returns the number released.
+        int advance(int8_t* woken = nullptr);
+    private:
+        bool less(int i, int j) const { return fireAt[heap[i]] < fireAt[heap[j]]; }
+        void swapSlots(int i, int j);
+        void siftUp(int i);
+        void siftDown(int i);
+        void removeAt(int i);
+    };
 #if defined(UNIT_TESTS) && !defined(HI_STRUM_IMPL)
     // Fallback inline definitions for headless CI if Strum.cpp not linked.
     inline void assign(float spreadMs, int N, Mode mode, float outDelaySec[16]) {
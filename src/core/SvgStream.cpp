@@ -0,0 +1,69 @@
+#include "SvgStream.hpp"
+#include <fstream>
+#include <ostream>
+#include <vector>
+/*
+ * SvgStream.cpp — Outer <svg> strip, incremental and whole-file.
+ */
+namespace hi { namespace ui { namespace svg {
+namespace {
+const char kClose[] = "</svg";
+const size_t kCloseLen = sizeof(kClose) - 1;
+} // namespace
+
+void InnerStreamer::feed(const char* data, size_t n) {
+    const size_t old = pending.size();
+    pending.append(data, n);
+    if (!inBody) {
+        if (tagAt == std::string::npos) tagAt = pending.find("<svg", old >= 3 ? old - 3 : 0);
+        if (tagAt == std::string::npos) return;                     // Keep the prologue; finish() may emit it
+        const size_t gt = pending.find('>', tagAt);
+        if (gt == std::string::npos) return;                        // Tag continues in the next chunk
+        inBody = true;
+        std::string body = pending.substr(gt + 1);
+        pending.clear();
+        feed(body.data(), body.size());
+        return;
+    }
+    // Latest close tag in the new bytes (a match may straddle the previous chunk)
+    size_t last = std::string::npos;
+    for (size_t p = pending.find(kClose, old >= kCloseLen - 1 ? old - (kCloseLen - 1) : 0);
+         p != std::string::npos; p = pending.find(kClose, p + 1))
+        last = p;
+    if (last != std::string::npos) {
+        out.write(pending.data(), (std::streamsize)last);
+        pending.erase(0, last);
+        holding = true;
+    } else if (!holding && pending.size() >= kCloseLen) {
+        const size_t keep = kCloseLen - 1;                          // Could be the start of a close tag
+        out.write(pending.data(), (std::streamsize)(pending.size() - keep));
+        pending.erase(0, pending.size() - keep);
+    }
+}
+
+void InnerStreamer::finish() {
+    if (!holding) out.write(pending.data(), (std::streamsize)pending.size());   // Prologue-only or unclosed body
+    pending.clear();
+    holding = false;
+    inBody = false;
+    tagAt = std::string::npos;
+}
+
+std::string stripOuter(const std::string& src) {
+    size_t open = src.find("<svg"); if (open == std::string::npos) return src;
+    size_t gt = src.find('>', open); if (gt == std::string::npos) return src;
+    size_t close = src.rfind(kClose); if (close == std::string::npos || close <= gt) return src.substr(gt+1);
+    return src.substr(gt+1, close - (gt+1));
+}
+
+bool copyInner(const std::string& path, std::ostream& out) {
+    std::ifstream f(path.c_str(), std::ios::binary);
+    if (!f) return false;
+    std::vector<char> buf(kChunk);
+    InnerStreamer s(out);
+    while (f.read(buf.data(), (std::streamsize)buf.size()) || f.gcount() > 0)
+        s.feed(buf.data(), (size_t)f.gcount());
+    s.finish();
+    return true;
+}
+}}} // namespace hi::ui::svg
@@ -0,0 +1,42 @@
+#pragma once
+/*
+ * SvgStream.hpp — Streams the contents of an SVG document's outer <svg>
+ * element (everything between its opening tag and the last "</svg") without
+ * holding the file in memory; PanelExport embeds panel artwork this way.
+ *
+ * Output is identical to the whole-file strip the panel snapshot used before:
+ * no "<svg" or no '>' after it -> the whole input; no "</svg" after the tag
+ * -> everything after it. Only the prologue before the tag and the text after
+ * the most recent "</svg" are buffered (both tiny for a panel file).
+ *
+ * Rack-free so the core tests can compare it against the whole-file strip.
+ */
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace hi { namespace ui { namespace svg {
+// Read buffer used by copyInner (panel files are tens to hundreds of KiB).
+static constexpr size_t kChunk = 64 * 1024;
+
+class InnerStreamer {
+public:
+    explicit InnerStreamer(std::ostream& out) : out(out) {}
+    // Feed the next n bytes of the document.
+    void feed(const char* data, size_t n);
+    // End of input: flushes whatever the strip keeps (see above).
+    void finish();
+private:
+    std::ostream& out;
+    bool inBody = false;                     // Opening tag seen
+    size_t tagAt = std::string::npos;        // Offset of "<svg" in the prologue, once found
+    bool holding = false;                    // pending starts with the latest "</svg"
+    std::string pending;                     // Prologue (before the tag) or not-yet-emitted body tail
+};
+
+// Whole-file reference of the strip (the original in-memory implementation).
+std::string stripOuter(const std::string& src);
+// Stream the inner SVG of the file at path into out through a kChunk buffer.
+// False when the file cannot be opened (nothing is written then).
+bool copyInner(const std::string& path, std::ostream& out);
+}}} // namespace hi::ui::svg
@@ -0,0 +1,10 @@
+#include "Telemetry.hpp"
+/*
+ * Telemetry.cpp — The one Seqlock<Frame> instantiation every user of
+ * telemetry::Channel links against. Frame copies use memcpy between fences
+ * (the usual seqlock idiom); a torn copy is discarded by the sequence check
+ * before it is used.
+ */
+namespace hi { namespace dsp { namespace telemetry {
+template struct Seqlock<Frame>;
+}}} // namespace hi::dsp::telemetry
@@ -0,0 +1,64 @@
+#pragma once
+/*
+ * Telemetry.hpp — Lock-free audio → UI snapshot of PolyQuanta's per-voice
+ * state (output volts, latched quantizer step, LED brightness, active width).
+ *
+ * Double-buffered seqlock: the audio thread writes the buffer readers are not
+ * looking at, bumping `seq` to odd before and even after, then flips. A reader
+ * copies the buffer named by an even `seq` and accepts the copy unless the
+ * writer has since started on that same buffer (seq advanced by 3 or more).
+ * The writer never waits; readers retry only when lapped, which at a 60 Hz
+ * publish rate is practically never.
+ */
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace hi { namespace dsp { namespace telemetry {
+static constexpr float kPublishHz = 60.f;   // Audio-thread publish rate (UI frame rate)
+
+struct Frame {
+    float volts[16] = {0.f};                 // Output voltage per channel (lastOut)
+    int32_t step[16] = {0};                  // Latched quantizer step per channel
+    float led[32] = {0.f};                   // Channel LEDs: [2c] green (+V), [2c+1] red (−V)
+    int activeN = 0;                         // Processing width (channels >= activeN are idle)
+};
+
+// Single-writer seqlock over any trivially copyable T (also used for the analysis worker's
+// results, see hi::music::analysis).
+template <typename T>
+struct Seqlock {
+    // Writer thread only.
+    void publish(const T& f) {
+        const uint32_t s = seq.load(std::memory_order_relaxed);
+        T& dst = buf[((s >> 1) + 1) & 1];                           // The buffer readers are not on
+        seq.store(s + 1, std::memory_order_relaxed);                // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&dst, &f, sizeof(T));
+        seq.store(s + 2, std::memory_order_release);                // Even: dst is current
+    }
+    // Any thread: copy the latest complete frame; false only if no frame was published yet
+    // or the writer lapped the reader on every retry.
+    bool read(T& out) const {
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            uint32_t s1 = seq.load(std::memory_order_acquire);
+            if (s1 & 1) --s1;                                       // Writer busy on the other buffer: read current
+            if (s1 == 0) return false;                              // Nothing published yet
+            std::memcpy(&out, &buf[(s1 >> 1) & 1], sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint32_t s2 = seq.load(std::memory_order_relaxed);
+            if (s2 - s1 < 3) return true;                           // Writer never started on our buffer
+        }
+        return false;
+    }
+    // Changes whenever a new frame is published (cheap "anything new?" check for widgets).
+    uint32_t version() const { return seq.load(std::memory_order_acquire) >> 1; }
+private:
+    T buf[2];
+    std::atomic<uint32_t> seq{0};            // Even: buf[(seq >> 1) & 1] is current; odd: writing the other one
+};
+
+// Audio thread publishes, widgets read.
+using Channel = Seqlock<Frame>;
+extern template struct Seqlock<Frame>;
+}}} // namespace hi::dsp::telemetry
@@ -0,0 +1,123 @@
+#include "TuningSnapshot.hpp"
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+/*
+ * TuningSnapshot.cpp — Snapshot construction and the publish/reclaim side of
+ * hi::dsp::tuning::Exchange. The effective N/period fallbacks match
+ * PolyQuantaEngine::refreshQuantPlan().
+ */
+namespace hi { namespace dsp { namespace tuning {
+namespace pool {
+// Buckets by a hash of the build arguments; QuantPlan::matches() settles collisions.
+static std::mutex gMutex;
+static std::unordered_map<uint64_t, std::vector<std::weak_ptr<const QuantPlan>>> gPlans;
+
+static uint64_t keyOf(int N, float period, int root, const uint8_t* mask, int maskLen,
+                      const float* degrees, float tonic) {
+    uint64_t h = 1469598103934665603ull;                        // FNV-1a
+    auto mix = [&h](uint64_t v) { h ^= v; h *= 1099511628211ull; };
+    uint32_t pb; std::memcpy(&pb, &period, sizeof(pb));
+    mix((uint64_t)N); mix(pb); mix((uint64_t)(int64_t)root); mix((uint64_t)maskLen);
+    for (int i = 0; i < maskLen; ++i) mix(mask[i]);
+    if (degrees) {
+        uint32_t b; std::memcpy(&b, &tonic, sizeof(b)); mix(b);
+        for (int i = 0; i < N; ++i) { std::memcpy(&b, &degrees[i], sizeof(b)); mix(b); }
+    }
+    return h;
+}
+
+// Drop the slots of plans whose last holder is gone, and the buckets they leave empty, so a
+// tuning visited once does not keep its map entry and control block forever. gMutex held.
+static void sweepLocked() {
+    for (auto it = gPlans.begin(); it != gPlans.end();) {
+        auto& bucket = it->second;
+        size_t keep = 0;
+        for (auto& w : bucket) if (!w.expired()) bucket[keep++] = w;
+        bucket.resize(keep);
+        it = bucket.empty() ? gPlans.erase(it) : std::next(it);
+    }
+}
+
+std::shared_ptr<const QuantPlan> intern(int N, float period, int root, const uint8_t* mask, int maskLen,
+                                        const float* degrees, float tonic) {
+    const int len = (mask && maskLen == N) ? maskLen : 0;
+    const uint64_t key = keyOf(N, period, root, len ? mask : nullptr, len, degrees, tonic);
+    std::lock_guard<std::mutex> lock(gMutex);
+    sweepLocked();                                              // Bounded by the distinct tunings in use
+    std::vector<std::weak_ptr<const QuantPlan>>& bucket = gPlans[key];
+    for (auto& w : bucket) {
+        std::shared_ptr<const QuantPlan> p = w.lock();
+        if (p && p->matches(N, period, root, mask, maskLen, degrees, tonic)) return p;
+    }
+    auto built = std::make_shared<QuantPlan>();
+    built->build(N, period, root, mask, maskLen, degrees, tonic);
+    bucket.push_back(built);
+    return built;
+}
+
+size_t liveCount() {
+    std::lock_guard<std::mutex> lock(gMutex);
+    sweepLocked();
+    size_t n = 0;
+    for (auto& kv : gPlans) for (auto& w : kv.second) if (!w.expired()) ++n;
+    return n;
+}
+
+size_t slotCount() {
+    std::lock_guard<std::mutex> lock(gMutex);
+    size_t n = 0;
+    for (auto& kv : gPlans) n += kv.second.size();
+    return n;
+}
+} // namespace pool
+
+void Snapshot::build(int mode, int e, int tet, float tetPeriod, bool custom,
+                     const std::vector<uint8_t>& m, int root, int scale,
+                     const std::vector<float>& degrees, float tonic) {
+    tuningMode = mode; edo = e; tetSteps = tet; tetPeriodOct = tetPeriod;
+    useCustomScale = custom; mask = m; rootNote = root; scaleIndex = scale;
+    scalaDegrees = degrees; scalaTonic = tonic;
+    if (tuningMode == 0) {
+        N = (edo <= 0) ? 12 : edo;
+        period = 1.f;
+    } else {
+        N = tetSteps > 0 ? tetSteps : 9;
+        period = (tetPeriodOct > 0.f) ? tetPeriodOct : std::log2(3.f/2.f);
+    }
+    const bool maskOk = useCustomScale && (int)mask.size() == N;
+    const bool warped = tuningMode == 2 && (int)scalaDegrees.size() == N;   // Scala: TET fields carry N/period
+    plan = pool::intern(N, period, rootNote, maskOk ? mask.data() : nullptr, maskOk ? N : 0,
+                        warped ? scalaDegrees.data() : nullptr, scalaTonic);
+}
+
+bool Snapshot::sameSource(int mode, int e, int tet, float tetPeriod, bool custom,
+                          const std::vector<uint8_t>& m, int root, int scale,
+                          const std::vector<float>& degrees, float tonic) const {
+    return tuningMode == mode && edo == e && tetSteps == tet && tetPeriodOct == tetPeriod &&
+           useCustomScale == custom && rootNote == root && scaleIndex == scale && mask == m &&
+           scalaDegrees == degrees && scalaTonic == tonic;
+}
+
+Exchange::~Exchange() {
+    delete cur.load(std::memory_order_relaxed);
+    for (Snapshot* s : retired) delete s;
+}
+
+void Exchange::publish(Snapshot* s) {
+    if (!s) return;
+    s->version = nextVersion++;
+    Snapshot* old = cur.exchange(s, std::memory_order_acq_rel);
+    if (old) retired.push_back(old);
+    // Everything older than the acknowledged version is unreachable from the audio thread
+    const uint64_t seen = ack.load(std::memory_order_acquire);
+    size_t keep = 0;
+    for (Snapshot* r : retired) {
+        if (r->version < seen) delete r;
+        else retired[keep++] = r;
+    }
+    retired.resize(keep);
+}
+}}} // namespace hi::dsp::tuning
@@ -0,0 +1,86 @@
+#pragma once
+/*
+ * TuningSnapshot.hpp — RCU handoff of PolyQuanta's tuning state (EDO/TET,
+ * period, root, scale index, custom mask and the prebuilt QuantPlan) from the
+ * UI thread to the audio thread.
+ *
+ * The UI thread builds a complete, immutable Snapshot (allocating freely) and
+ * publishes it with one atomic pointer exchange. The audio thread picks up the
+ * newest pointer once per control block and acknowledges its version; it never
+ * allocates, locks or sees a half-edited mask. Replaced snapshots wait on the
+ * UI side until the acknowledged version has moved past them (deferred
+ * reclamation), then are freed by a later publish() or the destructor.
+ *
+ * The QuantPlan tables themselves are interned process-wide (pool::intern):
+ * every instance whose snapshot has the same N, period, root and mask holds a
+ * reference to one shared, immutable plan, so table memory and rebuilds scale
+ * with the number of distinct tunings, not with the number of modules.
+ */
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <vector>
+#include "PolyQuantaCore.hpp"
+
+namespace hi { namespace dsp { namespace tuning {
+namespace pool {
+// Shared plan for these build() arguments (mask used only when maskLen == N; degrees, when
+// set, are the N warped offsets of a Scala tuning), built on first request and kept while any
+// holder references it. Thread-safe; allocates (not for audio).
+std::shared_ptr<const QuantPlan> intern(int N, float period, int root, const uint8_t* mask, int maskLen,
+                                        const float* degrees = nullptr, float tonic = 0.f);
+size_t liveCount();                      // Distinct plans currently referenced
+size_t slotCount();                      // Pool entries held, including released plans not yet swept
+}
+
+struct Snapshot {
+    uint64_t version = 0;                // Set by Exchange::publish (1, 2, ...)
+    // UI-side source fields (as last edited)
+    int tuningMode = 0, edo = 12, tetSteps = 9;
+    float tetPeriodOct = 0.f;
+    bool useCustomScale = true;
+    int rootNote = 0, scaleIndex = 0;
+    std::vector<uint8_t> mask;           // Root-relative custom mask copy
+    std::vector<float> scalaDegrees;     // tuningMode 2: degree offsets (octaves) of the loaded Scala scale
+    float scalaTonic = 0.f;              // tuningMode 2: volts of degree 0
+    // Derived (refreshQuantPlan fallbacks applied)
+    int N = 12;                          // Effective division count
+    float period = 1.f;                  // Effective period (octaves)
+    std::shared_ptr<const QuantPlan> plan; // Interned tables for (N, period, rootNote, mask[, degrees])
+    // Fill every field except version; builds plan (allocates: UI thread only).
+    void build(int tuningMode, int edo, int tetSteps, float tetPeriodOct, bool useCustomScale,
+               const std::vector<uint8_t>& mask, int rootNote, int scaleIndex,
+               const std::vector<float>& scalaDegrees = {}, float scalaTonic = 0.f);
+    // True when build() with these arguments would produce this snapshot.
+    bool sameSource(int tuningMode, int edo, int tetSteps, float tetPeriodOct, bool useCustomScale,
+                    const std::vector<uint8_t>& mask, int rootNote, int scaleIndex,
+                    const std::vector<float>& scalaDegrees = {}, float scalaTonic = 0.f) const;
+};
+
+class Exchange {
+public:
+    Exchange() = default;
+    Exchange(const Exchange&) = delete;
+    Exchange& operator=(const Exchange&) = delete;
+    ~Exchange();
+    // UI thread: take ownership of s, make it current and free retired snapshots the audio
+    // thread has moved past.
+    void publish(Snapshot* s);
+    // UI thread: last published snapshot (nullptr before the first publish).
+    const Snapshot* latest() const { return cur.load(std::memory_order_relaxed); }
+    // Audio thread: newest snapshot (nullptr before the first publish). Wait-free; the returned
+    // pointer stays valid until the next acquire().
+    const Snapshot* acquire() {
+        const Snapshot* p = cur.load(std::memory_order_acquire);
+        if (p && p->version != held) { held = p->version; ack.store(held, std::memory_order_release); }
+        return p;
+    }
+    size_t retiredCount() const { return retired.size(); }
+private:
+    std::atomic<Snapshot*> cur{nullptr};
+    std::atomic<uint64_t> ack{0};        // Version the audio thread last switched to
+    uint64_t held = 0;                   // Audio thread: version of the snapshot in use
+    uint64_t nextVersion = 1;            // UI thread
+    std::vector<Snapshot*> retired;      // UI thread: replaced, possibly still in use
+};
+}}} // namespace hi::dsp::tuning
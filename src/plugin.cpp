@@ -17,10 +17,28 @@
  **/
 
 #include "plugin.hpp"
+#include "core/ScalePack.hpp"
 
 
 Plugin* pluginInstance;
 
+// Register every .pqsp in dir. A bad pack is logged and skipped; it never blocks startup.
+static void loadScalePacks(const std::string& dir) {
+	if (!system::isDirectory(dir)) return;
+	for (const std::string& path : system::getEntries(dir)) {
+		if (system::getExtension(path) != ".pqsp") continue;
+		auto& packs = hi::music::scalepack::registry();
+		packs.emplace_back();
+		std::string err;
+		if (hi::music::scalepack::load(path, packs.back(), &err))
+			INFO("Scale pack %s: %u scales", path.c_str(), packs.back().view.count());
+		else {
+			WARN("Scale pack %s skipped: %s", path.c_str(), err.c_str());
+			packs.pop_back();
+		}
+	}
+}
+
 
 void init(Plugin* p) {
 	pluginInstance = p;
@@ -29,6 +47,9 @@ void init(Plugin* p) {
 	// p->addModel(modelMyModule);
 	p->addModel(modelPolyQuanta);
 	//p->addModel(modelPolyQuantaXL); // future expansion
+	// Binary scale packs: bundled ones first, then the user's (Rack user folder/<slug>/scales).
+	loadScalePacks(asset::plugin(p, "res/scales"));
+	loadScalePacks(asset::user(p->slug + "/scales"));
 	// Any other plugin initialization may go here.
 	// As an alternative, consider lazy-loading assets and lookup tables when your module is created to reduce startup times of Rack.
 }
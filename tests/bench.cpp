@@ -0,0 +1,174 @@
+// tests/bench.cpp — Headless micro-benchmarks for the PolyQuanta core (quantizer,
+// glide shaping, soft clip, strum assignment and scheduling). Built like the core test runner
+// (-DUNIT_TESTS, no Rack SDK) via `make core_bench`.
+//
+// Reproducible by construction: inputs come from a fixed-seed LCG, every case
+// runs a fixed op count, and the reported figure is the median of kRepeats runs.
+// Output is one JSON document (stdout, or the file named by argv[1]):
+//   ns_per_op        median wall time per call
+//   samples_per_sec  1e9 / ns_per_op (calls per second on one core)
+//   voices_per_core  samples_per_sec / 48000 (voices one core sustains at 48 kHz
+//                    if this call ran once per voice per sample)
+#ifndef UNIT_TESTS
+#define UNIT_TESTS
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../src/core/PolyQuantaCore.hpp"
+#include "../src/core/Strum.hpp"
+
+namespace {
+constexpr int    kOps = 1 << 16;        // Calls per timed run
+constexpr int    kRepeats = 7;          // Timed runs per case (median reported)
+constexpr int    kInputs = 4096;        // Input ring (power of two)
+constexpr double kSampleRate = 48000.0;
+
+volatile float gSinkF = 0.f;            // Defeats dead-code elimination
+volatile int   gSinkI = 0;
+
+struct Lcg {
+    uint32_t s;
+    explicit Lcg(uint32_t seed) : s(seed) {}
+    float uniform(float lo, float hi) { s = s * 1664525u + 1013904223u; return lo + (hi - lo) * (float)(s >> 8) / 16777216.f; }
+};
+
+// Median ns per op of body(), which must perform kOps calls.
+template <class F> double medianNsPerOp(F&& body) {
+    body();                                                    // Warm caches and branch predictors
+    std::vector<double> t;
+    for (int r = 0; r < kRepeats; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        body();
+        auto t1 = std::chrono::steady_clock::now();
+        t.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / kOps);
+    }
+    std::sort(t.begin(), t.end());
+    return t[kRepeats / 2];
+}
+
+// Dense: ~80% of degrees (every 5th dropped). Sparse: ~5 degrees per period.
+std::vector<uint8_t> makeMask(int edo, bool dense) {
+    std::vector<uint8_t> m(edo, 0);
+    const int stride = std::max(1, edo / 5);
+    for (int d = 0; d < edo; ++d) m[d] = dense ? (d % 5 != 4) : (d % stride == 0);
+    m[0] = 1;
+    return m;
+}
+
+struct Result { std::string name; int edo; const char* mask; double ns; };
+
+void emitJson(FILE* f, const std::vector<Result>& rs) {
+    std::fprintf(f, "{\n  \"schema\": 1,\n");
+#ifdef __VERSION__
+    std::fprintf(f, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    std::fprintf(f, "  \"ops_per_run\": %d,\n  \"repeats\": %d,\n  \"sample_rate\": %.0f,\n  \"results\": [\n",
+                 kOps, kRepeats, kSampleRate);
+    for (size_t i = 0; i < rs.size(); ++i) {
+        const Result& r = rs[i];
+        const double sps = 1e9 / r.ns;
+        std::fprintf(f, "    {\"name\": \"%s\"", r.name.c_str());
+        if (r.edo > 0) std::fprintf(f, ", \"edo\": %d, \"mask\": \"%s\"", r.edo, r.mask);
+        std::fprintf(f, ", \"ns_per_op\": %.3f, \"samples_per_sec\": %.0f, \"voices_per_core\": %.1f}%s\n",
+                     r.ns, sps, sps / kSampleRate, i + 1 < rs.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<float> volts(kInputs);
+    Lcg rng(0x9E3779B9u);
+    for (float& v : volts) v = rng.uniform(-5.f, 5.f);
+
+    std::vector<Result> results;
+    const int edos[] = {12, 31, 53, 72, 120};
+    for (int edo : edos) {
+        for (int dense = 1; dense >= 0; --dense) {
+            const char* maskName = dense ? "dense" : "sparse";
+            const std::vector<uint8_t> mask = makeMask(edo, dense != 0);
+            hi::dsp::QuantConfig qc;
+            qc.edo = edo; qc.useCustom = true;
+            qc.customMaskGeneric = mask.data(); qc.customMaskLen = edo;
+            const float spv = (float)edo;
+
+            results.push_back({"snapEDO", edo, maskName, medianNsPerOp([&] {
+                float acc = 0.f;
+                for (int i = 0; i < kOps; ++i) acc += hi::dsp::snapEDO(volts[i & (kInputs - 1)], qc);
+                gSinkF = acc;
+            })});
+            const hi::dsp::QuantBound qb = hi::dsp::computeQuantBound(qc, 5.f);
+            qc.boundCache = &qb;
+            results.push_back({"snapEDO_bounded", edo, maskName, medianNsPerOp([&] {
+                float acc = 0.f;
+                for (int i = 0; i < kOps; ++i) acc += hi::dsp::snapEDO(volts[i & (kInputs - 1)] * 1.5f, qc, 5.f, true);
+                gSinkF = acc;
+            })});
+            qc.boundCache = nullptr;
+            results.push_back({"nearestAllowedStep", edo, maskName, medianNsPerOp([&] {
+                int acc = 0;
+                for (int i = 0; i < kOps; ++i) {
+                    const float fs = volts[i & (kInputs - 1)] * spv;
+                    acc += hi::dsp::nearestAllowedStep((int)std::round(fs), fs, qc);
+                }
+                gSinkI = acc;
+            })});
+            results.push_back({"nearestAllowedStepWithHistory", edo, maskName, medianNsPerOp([&] {
+                int prev = 0;
+                for (int i = 0; i < kOps; ++i) {
+                    const float fs = volts[i & (kInputs - 1)] * spv;
+                    prev = hi::dsp::nearestAllowedStepWithHistory((int)std::round(fs), fs, qc, prev);
+                }
+                gSinkI = prev;
+            })});
+            hi::dsp::QuantPlan plan;
+            plan.build(edo, 1.f, 0, mask.data(), edo);
+            results.push_back({"QuantPlan::snap", edo, maskName, medianNsPerOp([&] {
+                float acc = 0.f;
+                for (int i = 0; i < kOps; ++i) acc += plan.snap(volts[i & (kInputs - 1)]);
+                gSinkF = acc;
+            })});
+        }
+    }
+
+    const hi::dsp::glide::ShapeParams sp = hi::dsp::glide::makeShape(0.4f);
+    results.push_back({"shapeMul", 0, "", medianNsPerOp([&] {
+        float acc = 0.f;
+        for (int i = 0; i < kOps; ++i) acc += hi::dsp::glide::shapeMul(volts[i & (kInputs - 1)] * 0.1f + 0.5f, sp, hi::consts::EPS_ERR);
+        gSinkF = acc;
+    })});
+    results.push_back({"clip::soft", 0, "", medianNsPerOp([&] {
+        float acc = 0.f;
+        for (int i = 0; i < kOps; ++i) acc += hi::dsp::clip::soft(volts[i & (kInputs - 1)] * 2.2f, 10.f);
+        gSinkF = acc;
+    })});
+    results.push_back({"strum::assign", 0, "", medianNsPerOp([&] {
+        float d[16];
+        float acc = 0.f;
+        for (int i = 0; i < kOps; ++i) {
+            hi::dsp::strum::assign(5.f + (float)(i & 7), 16, (hi::dsp::strum::Mode)(i % 3), d);
+            acc += d[i & 15];
+        }
+        gSinkF = acc;
+    })});
+    results.push_back({"strum::Scheduler", 0, "", medianNsPerOp([&] {
+        hi::dsp::strum::Scheduler sched;                       // One advance() per sample, 16-voice roll every 64
+        int acc = 0;
+        for (int i = 0; i < kOps; ++i) {
+            if ((i & 63) == 0) for (int c = 0; c < 16; ++c) sched.schedule(c, (uint32_t)(c * 3 + 1));
+            acc += sched.advance();
+        }
+        gSinkI = acc;
+    })});
+
+    FILE* out = stdout;
+    if (argc > 1 && !(out = std::fopen(argv[1], "w"))) { std::perror(argv[1]); return 1; }
+    emitJson(out, results);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,295 @@
+// tests/replay.cpp — Offline replay of the PolyQuanta signal chain (hi::dsp::PolyQuantaEngine)
+// over recorded-style 16-channel CV streams. Built like the core test runner
+// (-DUNIT_TESTS, no Rack SDK) via `make core_replay`.
+//
+// Each scenario drives the engine exactly like PolyQuanta::process(): width update,
+// block-rate control evaluation (a ControlSnapshot standing in for evalControls()),
+// then render() per sample. Reported per scenario:
+//   p50/p99/max ns   per-sample render() cost (steady_clock around each call)
+//   golden           decimated outputs vs tests/golden/<scenario>.txt (|Δ| <= kGoldenTol V)
+//
+// Usage: core_replay [--update] [--golden DIR] [--csv FILE]
+//   --update   rewrite the golden files instead of comparing
+//   --csv      also replay FILE (one row per sample, one column per input channel,
+//              '#' comments) through the Post/12-EDO setup; timing only, no golden
+#ifndef UNIT_TESTS
+#define UNIT_TESTS
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../src/core/PolyQuantaEngine.hpp"
+
+namespace {
+using hi::dsp::ControlSnapshot;
+
+constexpr double kSampleRate = 48000.0;
+constexpr int    kSamples = 12000;          // 250 ms per scenario
+constexpr int    kDecimate = 120;           // Golden rows every 2.5 ms
+constexpr float  kGoldenTol = 1e-4f;        // Volts
+
+struct Lcg {
+    uint32_t s;
+    explicit Lcg(uint32_t seed) : s(seed) {}
+    float uniform(float lo, float hi) { s = s * 1664525u + 1013904223u; return lo + (hi - lo) * (float)(s >> 8) / 16777216.f; }
+};
+
+// Per-sample hook: fills inputs, may edit knobs/settings (picked up at the next control
+// block, as with Rack params); returns the input channel count.
+struct Scenario {
+    const char* name;
+    void (*setup)(hi::dsp::PolyQuantaEngine&, ControlSnapshot&);
+    int (*step)(int n, hi::dsp::PolyQuantaEngine&, ControlSnapshot&, float* in);
+};
+
+void major12(hi::dsp::PolyQuantaEngine& e) {
+    static const uint8_t kMajor[12] = {1,0,1,0,1,1,0,1,0,1,0,1};
+    e.tuningMode = 0; e.edo = 12; e.rootNote = 0;
+    e.customMaskGeneric.assign(kMajor, kMajor + 12);
+    for (int c = 0; c < 16; ++c) e.qzEnabled[c] = true;
+}
+
+// Slow ramps spread across voices (pitch-safe glide, Post quantizer).
+void setupPostRamp(hi::dsp::PolyQuantaEngine& e, ControlSnapshot& k) {
+    major12(e);
+    e.quantizerPos = hi::dsp::PolyQuantaEngine::Post; e.pitchSafeGlide = true;
+    for (int c = 0; c < 16; ++c) k.slSec[c] = 0.002f * (float)(c % 4);
+}
+int stepRamp(int n, hi::dsp::PolyQuantaEngine&, ControlSnapshot&, float* in) {
+    const float t = (float)n / (float)kSamples;
+    for (int c = 0; c < 16; ++c) in[c] = -2.f + 4.f * t + 0.05f * (float)c;
+    return 16;
+}
+
+// LFO sweep through a Pre quantizer with Directional Snap and stickiness.
+void setupPreLfo(hi::dsp::PolyQuantaEngine& e, ControlSnapshot& k) {
+    major12(e);
+    e.quantizerPos = hi::dsp::PolyQuantaEngine::Pre; e.quantRoundMode = 0; e.stickinessCents = 10.f;
+    for (int c = 0; c < 16; ++c) k.slSec[c] = 0.001f;
+    k.riseShape = 0.5f; k.fallShape = -0.5f;
+}
+int stepLfo(int n, hi::dsp::PolyQuantaEngine&, ControlSnapshot&, float* in) {
+    const double t = (double)n / kSampleRate;
+    for (int c = 0; c < 16; ++c) in[c] = (float)(1.5 * std::sin(2.0 * M_PI * (4.0 + 0.25 * c) * t));
+    return 16;
+}
+
+// Sequencer steps every 25 ms with an Up strum (start-delay).
+void setupStrum(hi::dsp::PolyQuantaEngine& e, ControlSnapshot& k) {
+    major12(e);
+    e.strumEnabled = true; e.strumMode = 0; e.strumType = 1; e.strumMs = 1.f;
+    for (int c = 0; c < 16; ++c) k.slSec[c] = 0.003f;
+}
+int stepSeq(int n, hi::dsp::PolyQuantaEngine&, ControlSnapshot&, float* in) {
+    static const float kSeq[8] = {0.f, 0.25f, 0.583f, -0.417f, 1.f, 0.333f, -1.f, 0.166f};
+    const int s = (n / 1200) & 7;
+    for (int c = 0; c < 16; ++c) in[c] = kSeq[(s + c) & 7] + (float)(c / 4) * 0.5f;
+    return 16;
+}
+
+// Input width 4 → 16 → 8 with a 10 ms poly fade.
+void setupFade(hi::dsp::PolyQuantaEngine& e, ControlSnapshot& k) {
+    major12(e);
+    e.polyFadeSec = 0.01f;
+    for (int c = 0; c < 16; ++c) { k.off[c] = 0.1f * (float)c; k.slSec[c] = 0.001f; }
+}
+int stepFade(int n, hi::dsp::PolyQuantaEngine&, ControlSnapshot&, float* in) {
+    for (int c = 0; c < 16; ++c) in[c] = 0.5f + 0.01f * (float)c;
+    return n < 3000 ? 4 : (n < 7000 ? 16 : 8);
+}
+
+// Randomizer emulation: offsets/slews jump (bounded, seeded) every 2400 samples; control-rate 16.
+void setupRandom(hi::dsp::PolyQuantaEngine& e, ControlSnapshot& k) {
+    major12(e);
+    e.controlRateDiv = 16; e.controlRateSmooth = true;
+    for (int c = 0; c < 16; ++c) k.slSec[c] = 0.002f;
+}
+int stepRandom(int n, hi::dsp::PolyQuantaEngine&, ControlSnapshot& k, float* in) {
+    static Lcg rng(0x5EEDu);
+    if (n == 0) rng = Lcg(0x5EEDu);
+    if (n % 2400 == 0) {
+        for (int c = 0; c < 16; ++c) { k.off[c] = rng.uniform(-1.f, 1.f); k.slSec[c] = rng.uniform(0.f, 0.01f); }
+    }
+    for (int c = 0; c < 16; ++c) in[c] = 0.2f * (float)(c & 3);
+    return 16;
+}
+
+// Relatch storm: root moves every 480 samples while voices hold still (settle fast path wakes).
+void setupRelatch(hi::dsp::PolyQuantaEngine& e, ControlSnapshot&) { major12(e); }
+int stepRelatch(int n, hi::dsp::PolyQuantaEngine& e, ControlSnapshot&, float* in) {
+    e.rootNote = (n / 480) % 12;
+    for (int c = 0; c < 16; ++c) in[c] = 0.0833f * (float)c;
+    return 16;
+}
+
+const Scenario kScenarios[] = {
+    {"post_ramp",     setupPostRamp, stepRamp},
+    {"pre_lfo",       setupPreLfo,   stepLfo},
+    {"strum_seq",     setupStrum,    stepSeq},
+    {"poly_fade",     setupFade,     stepFade},
+    {"randomize",     setupRandom,   stepRandom},
+    {"relatch_storm", setupRelatch,  stepRelatch},
+};
+
+struct Run {
+    std::vector<double> ns;                    // Per-sample render() cost
+    std::vector<std::vector<float>> rows;      // Decimated outputs (16 columns, unused = 0)
+};
+
+// One sample of PolyQuanta::process() minus Rack I/O and the randomizer scheduler.
+int tick(hi::dsp::PolyQuantaEngine& e, const ControlSnapshot& k, const float* in, int inCh, float* out, double& ns) {
+    e.updateWidth(true, inCh);
+    if (e.controlDue()) e.applyControls(k);
+    const float w = e.advanceControl();
+    auto t0 = std::chrono::steady_clock::now();
+    const int n = e.render(in, inCh, true, w, (float)(1.0 / kSampleRate), out);
+    auto t1 = std::chrono::steady_clock::now();
+    ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    return n;
+}
+
+Run runScenario(const Scenario& s) {
+    hi::dsp::PolyQuantaEngine e;
+    ControlSnapshot k;
+    s.setup(e, k);
+    Run r;
+    r.ns.reserve(kSamples);
+    for (int n = 0; n < kSamples; ++n) {
+        float in[16] = {0.f}, out[16] = {0.f};
+        const int inCh = s.step(n, e, k, in);
+        double ns = 0.0;
+        const int outN = tick(e, k, in, inCh, out, ns);
+        r.ns.push_back(ns);
+        if (n % kDecimate == 0) {
+            std::fill(out + outN, out + 16, 0.f);         // Only the written outputs are meaningful
+            r.rows.emplace_back(out, out + 16);
+        }
+    }
+    return r;
+}
+
+double pct(std::vector<double> v, double p) {
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, (size_t)(p * (double)(v.size() - 1) + 0.5))];
+}
+
+bool writeGolden(const std::string& path, const Run& r) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) { std::perror(path.c_str()); return false; }
+    std::fprintf(f, "# PolyQuanta replay golden: %d samples @ %.0f Hz, every %d samples, 16 outputs (V)\n",
+                 kSamples, kSampleRate, kDecimate);
+    for (const auto& row : r.rows) {
+        for (int c = 0; c < 16; ++c) std::fprintf(f, c ? " %.6f" : "%.6f", row[c]);
+        std::fprintf(f, "\n");
+    }
+    std::fclose(f);
+    return true;
+}
+
+// Returns the worst |Δ| against the golden (or -1 when missing/malformed).
+double compareGolden(const std::string& path, const Run& r, int& badRow) {
+    FILE* f = std::fopen(path.c_str(), "r");
+    if (!f) return -1.0;
+    char line[1024];
+    size_t row = 0;
+    double worst = 0.0;
+    badRow = -1;
+    while (std::fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+        if (row >= r.rows.size()) { std::fclose(f); return -1.0; }
+        char* p = line;
+        for (int c = 0; c < 16; ++c) {
+            const double g = std::strtod(p, &p);
+            const double d = std::fabs(g - (double)r.rows[row][c]);
+            if (d > worst) { worst = d; if (d > kGoldenTol) badRow = (int)row; }
+        }
+        ++row;
+    }
+    std::fclose(f);
+    return row == r.rows.size() ? worst : -1.0;
+}
+
+bool readCsv(const char* path, std::vector<std::vector<float>>& frames) {
+    FILE* f = std::fopen(path, "r");
+    if (!f) { std::perror(path); return false; }
+    char line[2048];
+    while (std::fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        std::vector<float> fr;
+        for (char* p = line; *p && fr.size() < 16;) {
+            char* end;
+            const float v = std::strtof(p, &end);
+            if (end == p) break;
+            fr.push_back(v);
+            p = end;
+            while (*p == ',' || *p == ' ' || *p == '\t') ++p;
+        }
+        if (!fr.empty()) frames.push_back(fr);
+    }
+    std::fclose(f);
+    return true;
+}
+
+void report(const char* name, const std::vector<double>& ns, const char* golden) {
+    std::printf("%-14s p50 %8.1f ns  p99 %8.1f ns  max %9.1f ns  %s\n",
+                name, pct(ns, 0.5), pct(ns, 0.99), pct(ns, 1.0), golden);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    bool update = false;
+    std::string goldenDir = "golden";
+    const char* csv = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--update")) update = true;
+        else if (!std::strcmp(argv[i], "--golden") && i + 1 < argc) goldenDir = argv[++i];
+        else if (!std::strcmp(argv[i], "--csv") && i + 1 < argc) csv = argv[++i];
+        else { std::fprintf(stderr, "usage: %s [--update] [--golden DIR] [--csv FILE]\n", argv[0]); return 2; }
+    }
+
+    int failures = 0;
+    for (const Scenario& s : kScenarios) {
+        const Run r = runScenario(s);
+        const std::string path = goldenDir + "/" + s.name + ".txt";
+        char status[96];
+        if (update) {
+            if (!writeGolden(path, r)) return 1;
+            std::snprintf(status, sizeof(status), "golden updated");
+        } else {
+            int badRow = -1;
+            const double worst = compareGolden(path, r, badRow);
+            if (worst < 0.0) { std::snprintf(status, sizeof(status), "FAIL (golden missing or wrong length)"); ++failures; }
+            else if (badRow >= 0) { std::snprintf(status, sizeof(status), "FAIL (max |d| %.2e V, row %d)", worst, badRow); ++failures; }
+            else std::snprintf(status, sizeof(status), "ok (max |d| %.1e V)", worst);
+        }
+        report(s.name, r.ns, status);
+    }
+
+    if (csv) {
+        std::vector<std::vector<float>> frames;
+        if (!readCsv(csv, frames)) return 1;
+        hi::dsp::PolyQuantaEngine e;
+        ControlSnapshot k;
+        setupPostRamp(e, k);
+            std::vector<double> ns;
+        ns.reserve(frames.size());
+        for (const auto& fr : frames) {
+            float in[16] = {0.f}, out[16];
+            std::copy(fr.begin(), fr.end(), in);
+            double t = 0.0;
+            tick(e, k, in, (int)fr.size(), out, t);
+            ns.push_back(t);
+        }
+        if (!ns.empty()) report("csv", ns, csv);
+    }
+
+    if (failures) { std::printf("%d replay scenario(s) differ from golden.\n", failures); return 1; }
+    std::printf(update ? "Golden files updated.\n" : "All replay scenarios match.\n");
+    return 0;
+}